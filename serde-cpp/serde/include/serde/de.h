@@ -4,4 +4,4 @@
 #include "de/deserialize.h"
 #include "de/deserializer.h"
 #include "de/builtin.h"
-
+#include "de/static_deserializer.h"
@@ -2,14 +2,15 @@
 
 #include <cstdint>
 #include <stdexcept>
+#include <type_traits>
 #include "deserialize.h"
 #include "deserializer.h"
 
 namespace serde {
 
 namespace detail {
-template<typename T>
-inline void deserialize_signed_integer(Deserializer& de, T& val) {
+template<typename D, typename T>
+inline void deserialize_signed_integer(D& de, T& val) {
   if constexpr (sizeof(std::decay_t<T>) == 1) {
     de.deserialize_i8(val);
   }
@@ -28,8 +29,8 @@ inline void deserialize_signed_integer(Deserializer& de, T& val) {
   }
 }
 
-template<typename T>
-inline void deserialize_unsigned_integer(Deserializer& de, T& val) {
+template<typename D, typename T>
+inline void deserialize_unsigned_integer(D& de, T& val) {
   if constexpr (sizeof(std::decay_t<T>) == 1) {
     de.deserialize_u8(val);
   }
@@ -47,92 +48,165 @@ inline void deserialize_unsigned_integer(Deserializer& de, T& val) {
     static_assert(sizeof(std::decay_t<T>) <= 8, "unsupported unsigned integer size");
   }
 }
+
+// Deserialize builtin scalars straight through the deserializer methods,
+// D may be serde::Deserializer or a concrete deserializer type (static dispatch).
+template<typename D, typename T>
+inline void deserialize_builtin(D& de, T& val) {
+  if constexpr (std::is_same_v<T, bool>) {
+    de.deserialize_bool(val);
+  }
+  else if constexpr (std::is_same_v<T, char>) {
+    de.deserialize_char(val);
+  }
+  else if constexpr (std::is_same_v<T, signed char>) {
+    char c;
+    de.deserialize_char(c);
+    val = c;
+  }
+  else if constexpr (std::is_same_v<T, unsigned char>) {
+    de.deserialize_uchar(val);
+  }
+  else if constexpr (std::is_same_v<T, float>) {
+    de.deserialize_float(val);
+  }
+  else if constexpr (std::is_same_v<T, double>) {
+    de.deserialize_double(val);
+  }
+  else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+    deserialize_signed_integer(de, val);
+  }
+  else if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T>) {
+    deserialize_unsigned_integer(de, val);
+  } else {
+    static_assert(sizeof(T) == 0, "unsupported builtin type");
+  }
+}
+
+// Deserialize a sequence into a contiguous block of builtin scalars with a single deserializer call,
+// D may be serde::Deserializer or a concrete deserializer type (static dispatch).
+template<typename D, typename T>
+inline void deserialize_seq_builtin(D& de, T* vals, size_t len) {
+  if constexpr (std::is_same_v<T, bool>) {
+    de.deserialize_seq_bool(vals, len);
+  }
+  else if constexpr (std::is_same_v<T, char> || std::is_same_v<T, signed char>) {
+    de.deserialize_seq_char(reinterpret_cast<char*>(vals), len);
+  }
+  else if constexpr (std::is_same_v<T, unsigned char>) {
+    de.deserialize_seq_uchar(vals, len);
+  }
+  else if constexpr (std::is_same_v<T, int16_t>) {
+    de.deserialize_seq_i16(vals, len);
+  }
+  else if constexpr (std::is_same_v<T, uint16_t>) {
+    de.deserialize_seq_u16(vals, len);
+  }
+  else if constexpr (std::is_same_v<T, int32_t>) {
+    de.deserialize_seq_i32(vals, len);
+  }
+  else if constexpr (std::is_same_v<T, uint32_t>) {
+    de.deserialize_seq_u32(vals, len);
+  }
+  else if constexpr (std::is_same_v<T, int64_t>) {
+    de.deserialize_seq_i64(vals, len);
+  }
+  else if constexpr (std::is_same_v<T, uint64_t>) {
+    de.deserialize_seq_u64(vals, len);
+  }
+  else if constexpr (std::is_same_v<T, float>) {
+    de.deserialize_seq_float(vals, len);
+  }
+  else if constexpr (std::is_same_v<T, double>) {
+    de.deserialize_seq_double(vals, len);
+  } else {
+    static_assert(sizeof(T) == 0, "unsupported builtin sequence type");
+  }
+}
 } // namespace detail
 
 template<>
 inline void deserialize(Deserializer& de, bool& v)
 {
-  de.deserialize_bool(v);
+  detail::deserialize_builtin(de, v);
 }
 
 template<>
 inline void deserialize(Deserializer& de, int& v)
 {
-  detail::deserialize_signed_integer(de, v);
+  detail::deserialize_builtin(de, v);
 }
 
 template<>
 inline void deserialize(Deserializer& de, short int& v)
 {
-  detail::deserialize_signed_integer(de, v);
+  detail::deserialize_builtin(de, v);
 }
 
 template<>
 inline void deserialize(Deserializer& de, long int& v)
 {
-  detail::deserialize_signed_integer(de, v);
+  detail::deserialize_builtin(de, v);
 }
 
 template<>
 inline void deserialize(Deserializer& de, long long int& v)
 {
-  detail::deserialize_signed_integer(de, v);
+  detail::deserialize_builtin(de, v);
 }
 
 template<>
 inline void deserialize(Deserializer& de, unsigned int& v)
 {
-  detail::deserialize_unsigned_integer(de, v);
+  detail::deserialize_builtin(de, v);
 }
 
 template<>
 inline void deserialize(Deserializer& de, short unsigned int& v)
 {
-  detail::deserialize_unsigned_integer(de, v);
+  detail::deserialize_builtin(de, v);
 }
 
 template<>
 inline void deserialize(Deserializer& de, long unsigned int& v)
 {
-  detail::deserialize_unsigned_integer(de, v);
+  detail::deserialize_builtin(de, v);
 }
 
 template<>
 inline void deserialize(Deserializer& de, long long unsigned int& v)
 {
-  detail::deserialize_unsigned_integer(de, v);
+  detail::deserialize_builtin(de, v);
 }
 
 template<>
 inline void deserialize(Deserializer& de, float& v)
 {
-  de.deserialize_float(v);
+  detail::deserialize_builtin(de, v);
 }
 
 template<>
 inline void deserialize(Deserializer& de, double& v)
 {
-  de.deserialize_double(v);
+  detail::deserialize_builtin(de, v);
 }
 
 template<>
 inline void deserialize(Deserializer& de, char& v)
 {
-  de.deserialize_char(v);
+  detail::deserialize_builtin(de, v);
 }
 
 template<>
 inline void deserialize(Deserializer& de, signed char& v)
 {
-  char c;
-  de.deserialize_char(c);
-  v = c;
+  detail::deserialize_builtin(de, v);
 }
 
 template<>
 inline void deserialize(Deserializer& de, unsigned char& v)
 {
-  de.deserialize_uchar(v);
+  detail::deserialize_builtin(de, v);
 }
 
 template<>
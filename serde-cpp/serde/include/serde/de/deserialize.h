@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstddef>
+#include <type_traits>
+#include "traits.h"
 
 namespace serde {
 
@@ -36,6 +38,14 @@ inline void deserialize(Deserializer& de, T<U...>& val) {
   DeserializeT<T>::template deserialize<U...>(de, val);
 }
 
+// Deserialization for template types through a concrete deserializer (static dispatch).
+// Specializations of DeserializeT templated on the deserializer type get the concrete type D,
+// otherwise D converts to Deserializer& and the virtual path is taken.
+template<typename D, template<typename...> typename T, typename... U>
+inline auto deserialize(D& de, T<U...>& val) -> std::enable_if_t<traits::IsConcreteDeserializer<D>::value> {
+  DeserializeT<T>::template deserialize<U...>(de, val);
+}
+
 
 // Deserialization for template types with only integral parameter, e.g. std::bitset.
 template<template<auto...> typename T>
@@ -51,6 +61,12 @@ inline void deserialize(Deserializer& de, T<N...>& val) {
   DeserializeN<T>::template deserialize<N...>(de, val);
 }
 
+// Deserialization for template types with only integral parameter through a concrete deserializer.
+template<typename D, template<auto...> typename T, auto... N>
+inline auto deserialize(D& de, T<N...>& val) -> std::enable_if_t<traits::IsConcreteDeserializer<D>::value> {
+  DeserializeN<T>::template deserialize<N...>(de, val);
+}
+
 
 // Deserialization for template types with typename and integral parameter, e.g. std::array.
 template<template<typename, auto, auto...> typename T>
@@ -66,6 +82,12 @@ inline void deserialize(Deserializer& de, T<U, N, M...>& val) {
   DeserializeTN<T>::template deserialize<U, N, M...>(de, val);
 }
 
+// Deserialization for template types with typename and integral parameter through a concrete deserializer.
+template<typename D, template<typename, auto, auto...> typename T, typename U, auto N, auto... M>
+inline auto deserialize(D& de, T<U, N, M...>& val) -> std::enable_if_t<traits::IsConcreteDeserializer<D>::value> {
+  DeserializeTN<T>::template deserialize<U, N, M...>(de, val);
+}
+
 
 // Deserialization for string literals, builtin implementation!
 template<size_t N>
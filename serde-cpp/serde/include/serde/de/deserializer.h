@@ -1,6 +1,10 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <optional>
+#include <utility>
+#include "../error.h"
 #include "deserialize.h"
 #include "traits.h"
 
@@ -10,6 +14,7 @@ class Deserializer {
 public:
   template<typename T>
   inline void deserialize(T& v) {
+    if (has_error()) return;
     if constexpr (traits::HasMemberDeserialize<T>::value) v.deserialize(*this);
     else if constexpr (traits::HasDeserialize<T>::value) Deserialize<T>::deserialize(*this, v);
     else serde::deserialize(*this, v);
@@ -31,6 +36,11 @@ public:
   virtual void deserialize_uchar(unsigned char&) = 0;
   virtual void deserialize_cstr(char*, size_t len) = 0; /* null-terminated */
   virtual void deserialize_bytes(void* val, size_t len) = 0;
+  // Borrowed string, val points into the input owned by the deserializer (not null-terminated)
+  // and stays valid as long as the deserializer. Dataformats which cannot lend their input don't override it.
+  virtual void deserialize_str(const char*& val, size_t& len) { set_error({Error::Kind::Invalid, 0, 0, "borrowed strings not supported"}); }
+  // Borrowed bytes, the same as deserialize_str() for binary values
+  virtual void deserialize_bytes_borrowed(const void*& val, size_t& len) { set_error({Error::Kind::Invalid, 0, 0, "borrowed bytes not supported"}); }
   virtual void deserialize_length(size_t& len) = 0;
   void deserialize_length_cstr(size_t& len) { deserialize_length(len); len+=1; /* null-terminated */ }
 
@@ -43,6 +53,26 @@ public:
   virtual void deserialize_seq_size(size_t&) = 0;
   virtual void deserialize_seq_end() = 0;
 
+  // Sequence of scalars ///////////////////////////////////////////////////////
+  // Deserialize a whole sequence of len scalars into a contiguous block in one call.
+  // std containers with builtin elements (vector, array, ...) use these after
+  // sizing the block with deserialize_seq_size().
+  // The default implementation deserializes element by element, dataformats
+  // should override them for parsing the whole block in a tight loop.
+  virtual void deserialize_seq_bool(bool* vals, size_t len) { deserialize_seq_each(vals, len, &Deserializer::deserialize_bool); }
+  virtual void deserialize_seq_i8(int8_t* vals, size_t len) { deserialize_seq_each(vals, len, &Deserializer::deserialize_i8); }
+  virtual void deserialize_seq_u8(uint8_t* vals, size_t len) { deserialize_seq_each(vals, len, &Deserializer::deserialize_u8); }
+  virtual void deserialize_seq_i16(int16_t* vals, size_t len) { deserialize_seq_each(vals, len, &Deserializer::deserialize_i16); }
+  virtual void deserialize_seq_u16(uint16_t* vals, size_t len) { deserialize_seq_each(vals, len, &Deserializer::deserialize_u16); }
+  virtual void deserialize_seq_i32(int32_t* vals, size_t len) { deserialize_seq_each(vals, len, &Deserializer::deserialize_i32); }
+  virtual void deserialize_seq_u32(uint32_t* vals, size_t len) { deserialize_seq_each(vals, len, &Deserializer::deserialize_u32); }
+  virtual void deserialize_seq_i64(int64_t* vals, size_t len) { deserialize_seq_each(vals, len, &Deserializer::deserialize_i64); }
+  virtual void deserialize_seq_u64(uint64_t* vals, size_t len) { deserialize_seq_each(vals, len, &Deserializer::deserialize_u64); }
+  virtual void deserialize_seq_float(float* vals, size_t len) { deserialize_seq_each(vals, len, &Deserializer::deserialize_float); }
+  virtual void deserialize_seq_double(double* vals, size_t len) { deserialize_seq_each(vals, len, &Deserializer::deserialize_double); }
+  virtual void deserialize_seq_char(char* vals, size_t len) { deserialize_seq_each(vals, len, &Deserializer::deserialize_char); }
+  virtual void deserialize_seq_uchar(unsigned char* vals, size_t len) { deserialize_seq_each(vals, len, &Deserializer::deserialize_uchar); }
+
   // Map ///////////////////////////////////////////////////////////////////////
   virtual void deserialize_map_begin() = 0;
   virtual void deserialize_map_size(size_t&) = 0;
@@ -92,8 +122,31 @@ public:
     deserialize_struct_field_end();
   }
 
+  // Error /////////////////////////////////////////////////////////////////////
+  // Dataformats (and datatypes) set an error when the input can't be deserialized.
+  // Only the first error is kept, once set deserialize() returns early for the remaining values.
+  void set_error(Error e) { if (!err) err = std::move(e); }
+  bool has_error() const { return err.has_value(); }
+  const Error& error() const { return *err; }
+
+protected:
+  // For dataformats being reset to deserialize again
+  void clear_error() { err.reset(); }
+
+public:
   // Destructor
   virtual ~Deserializer() = default;
+
+private:
+  std::optional<Error> err;
+
+  template<typename T>
+  inline void deserialize_seq_each(T* vals, size_t len, void (Deserializer::*deserialize_one)(T&)) {
+    deserialize_seq_begin();
+    for (size_t i = 0; i < len; i++)
+      (this->*deserialize_one)(vals[i]);
+    deserialize_seq_end();
+  }
 };
 
 } // namespace serde
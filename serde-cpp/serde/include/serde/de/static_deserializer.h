@@ -0,0 +1,79 @@
+#pragma once
+
+#include <type_traits>
+#include "deserialize.h"
+#include "deserializer.h"
+#include "builtin.h"
+#include "traits.h"
+
+namespace serde {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Statically dispatched Deserializer
+///
+/// Dataformats may derive from StaticDeserializer<Impl> (CRTP) instead of
+/// Deserializer directly, where Impl is the `final` dataformat class.
+/// Deserializing through an Impl& instantiates the type walk (builtin scalars,
+/// std types and serde_gen generated code) with the concrete Impl type,
+/// so the dataformat scalar and cursor logic is inlined into the per-type
+/// loops instead of going through the Deserializer vtable.
+///
+/// Impl is still a Deserializer, so types implemented only for Deserializer&
+/// keep working and are deserialized through the virtual interface.
+template<typename Impl>
+class StaticDeserializer : public Deserializer {
+public:
+  template<typename T>
+  inline void deserialize(T& v) {
+    if (has_error()) return;
+    Impl& self = static_cast<Impl&>(*this);
+    if constexpr (traits::HasMemberDeserialize<T, Impl>::value) v.deserialize(self);
+    else if constexpr (traits::HasDeserialize<T, Impl>::value) Deserialize<T>::deserialize(self, v);
+    else if constexpr (traits::IsBuiltinDeserialize<T>::value) detail::deserialize_builtin(self, v);
+    else if constexpr (std::is_same_v<std::remove_extent_t<T>, char>) self.deserialize_cstr(v, std::extent_v<T>);
+    else serde::deserialize(self, v);
+  }
+
+  // Map ///////////////////////////////////////////////////////////////////////
+  template<typename K>
+  inline void deserialize_map_key(K& key) {
+    Impl& self = static_cast<Impl&>(*this);
+    self.deserialize_map_key_begin();
+    self.deserialize(key);
+    self.deserialize_map_key_end();
+  }
+
+  template<typename V>
+  inline void deserialize_map_value(V& value) {
+    Impl& self = static_cast<Impl&>(*this);
+    self.deserialize_map_value_begin();
+    self.deserialize(value);
+    self.deserialize_map_value_end();
+  }
+
+  template<typename K, typename V>
+  inline void deserialize_map_entry(K& key, V& value) {
+    deserialize_map_key(key);
+    deserialize_map_value(value);
+  }
+
+  template<typename V>
+  inline void deserialize_map_entry_find(const char* key, V& value) {
+    static_cast<Impl&>(*this).deserialize_map_key_find(key);
+    deserialize_map_value(value);
+  }
+
+  // Struct ////////////////////////////////////////////////////////////////////
+  template<typename V>
+  inline void deserialize_struct_field(const char* name, V& value) {
+    Impl& self = static_cast<Impl&>(*this);
+    self.deserialize_struct_field_begin(name);
+    self.deserialize(value);
+    self.deserialize_struct_field_end();
+  }
+
+protected:
+  StaticDeserializer() = default;
+};
+
+} // namespace serde
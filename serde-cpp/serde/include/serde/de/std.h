@@ -1,6 +1,7 @@
 #include "std/array.h"
 #include "std/vector.h"
 #include "std/string.h"
+#include "std/string_view.h"
 #include "std/memory.h"
 #include "std/optional.h"
 #include "std/map.h"
@@ -3,17 +3,23 @@
 #include <array>
 #include "../deserialize.h"
 #include "../deserializer.h"
+#include "../builtin.h"
+#include "../traits.h"
 
 namespace serde {
 
 template<>
 struct DeserializeTN<std::array> {
-  template<typename T, auto N>
-  static void deserialize(Deserializer& de, std::array<T, N>& arr) {
-    de.deserialize_seq_begin();
-    for (auto& e : arr)
-      de.deserialize(e);
-    de.deserialize_seq_end();
+  template<typename T, auto N, typename D>
+  static void deserialize(D& de, std::array<T, N>& arr) {
+    if constexpr (traits::IsSeqBuiltinDeserialize<T>::value) {
+      detail::deserialize_seq_builtin(de, arr.data(), arr.size());
+    } else {
+      de.deserialize_seq_begin();
+      for (auto& e : arr)
+        de.deserialize(e);
+      de.deserialize_seq_end();
+    }
   }
 };
 
@@ -8,8 +8,8 @@ namespace serde {
 
 template<>
 struct DeserializeT<std::deque> {
-  template<typename T, typename Alloc>
-  static void deserialize(Deserializer& de, std::deque<T, Alloc>& deque) {
+  template<typename T, typename Alloc, typename D>
+  static void deserialize(D& de, std::deque<T, Alloc>& deque) {
     size_t size = 0;
     de.deserialize_seq_size(size);
     de.deserialize_seq_begin();
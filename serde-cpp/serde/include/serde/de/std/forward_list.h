@@ -8,8 +8,8 @@ namespace serde {
 
 template<>
 struct DeserializeT<std::forward_list> {
-  template<typename T, typename Alloc>
-  static void deserialize(Deserializer& de, std::forward_list<T, Alloc>& list) {
+  template<typename T, typename Alloc, typename D>
+  static void deserialize(D& de, std::forward_list<T, Alloc>& list) {
     size_t size = 0;
     de.deserialize_seq_size(size);
     de.deserialize_seq_begin();
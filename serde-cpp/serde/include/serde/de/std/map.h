@@ -8,8 +8,8 @@ namespace serde {
 
 template<>
 struct DeserializeT<std::map> {
-  template<typename Key, typename Value, typename Cmp, typename Alloc>
-  static void deserialize(Deserializer& de, std::map<Key, Value, Cmp, Alloc>& map) {
+  template<typename Key, typename Value, typename Cmp, typename Alloc, typename D>
+  static void deserialize(D& de, std::map<Key, Value, Cmp, Alloc>& map) {
     size_t size = 0;
     map.clear();
     de.deserialize_map_size(size);
@@ -25,8 +25,8 @@ struct DeserializeT<std::map> {
 
 template<>
 struct DeserializeT<std::multimap> {
-  template<typename Key, typename Value, typename Cmp, typename Alloc>
-  static void deserialize(Deserializer& de, std::multimap<Key, Value, Cmp, Alloc>& multimap) {
+  template<typename Key, typename Value, typename Cmp, typename Alloc, typename D>
+  static void deserialize(D& de, std::multimap<Key, Value, Cmp, Alloc>& multimap) {
     size_t size = 0;
     multimap.clear();
     de.deserialize_map_size(size);
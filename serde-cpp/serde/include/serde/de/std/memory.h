@@ -8,8 +8,8 @@ namespace serde {
 
 template<>
 struct DeserializeT<std::unique_ptr> {
-  template<typename T, typename Deleter>
-  static void deserialize(Deserializer& de, std::unique_ptr<T, Deleter>& val) {
+  template<typename T, typename Deleter, typename D>
+  static void deserialize(D& de, std::unique_ptr<T, Deleter>& val) {
     bool is_some = false;
     de.deserialize_is_some(is_some);
     if (is_some) {
@@ -25,8 +25,8 @@ struct DeserializeT<std::unique_ptr> {
 
 template<>
 struct DeserializeT<std::shared_ptr> {
-  template<typename T>
-  static void deserialize(Deserializer& de, std::shared_ptr<T>& val) {
+  template<typename T, typename D>
+  static void deserialize(D& de, std::shared_ptr<T>& val) {
     bool is_some = false;
     de.deserialize_is_some(is_some);
     if (is_some) {
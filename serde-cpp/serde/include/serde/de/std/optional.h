@@ -8,8 +8,8 @@ namespace serde {
 
 template<>
 struct DeserializeT<std::optional> {
-  template<typename T>
-  static void deserialize(Deserializer& de, std::optional<T>& val) {
+  template<typename T, typename D>
+  static void deserialize(D& de, std::optional<T>& val) {
     bool some = false;
     de.deserialize_is_some(some);
     if (some) {
@@ -8,8 +8,8 @@ namespace serde {
 
 template<>
 struct DeserializeT<std::queue> {
-  template<typename T, typename Seq>
-  static void deserialize(Deserializer& de, std::queue<T, Seq>& queue) {
+  template<typename T, typename Seq, typename D>
+  static void deserialize(D& de, std::queue<T, Seq>& queue) {
     while (!queue.empty()) queue.pop(); // clear queue
     size_t size = 0;
     de.deserialize_seq_size(size);
@@ -25,8 +25,8 @@ struct DeserializeT<std::queue> {
 
 template<>
 struct DeserializeT<std::priority_queue> {
-  template<typename T, typename Seq, typename Cmp>
-  static void deserialize(Deserializer& de, std::priority_queue<T, Seq, Cmp>& queue) {
+  template<typename T, typename Seq, typename Cmp, typename D>
+  static void deserialize(D& de, std::priority_queue<T, Seq, Cmp>& queue) {
     while (!queue.empty()) queue.pop(); // clear queue
     size_t size = 0;
     de.deserialize_seq_size(size);
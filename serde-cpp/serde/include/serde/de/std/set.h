@@ -8,8 +8,8 @@ namespace serde {
 
 template<>
 struct DeserializeT<std::set> {
-  template<typename Key, typename Cmp, typename Alloc>
-  static void deserialize(Deserializer& de, std::set<Key, Cmp, Alloc>& set) {
+  template<typename Key, typename Cmp, typename Alloc, typename D>
+  static void deserialize(D& de, std::set<Key, Cmp, Alloc>& set) {
     size_t size = 0;
     set.clear();
     de.deserialize_seq_size(size);
@@ -25,8 +25,8 @@ struct DeserializeT<std::set> {
 
 template<>
 struct DeserializeT<std::multiset> {
-  template<typename Key, typename Cmp, typename Alloc>
-  static void deserialize(Deserializer& de, std::multiset<Key, Cmp, Alloc>& multiset) {
+  template<typename Key, typename Cmp, typename Alloc, typename D>
+  static void deserialize(D& de, std::multiset<Key, Cmp, Alloc>& multiset) {
     size_t size = 0;
     multiset.clear();
     de.deserialize_seq_size(size);
@@ -9,8 +9,8 @@ namespace serde {
 
 template<>
 struct DeserializeT<std::stack> {
-  template<typename T, typename Seq>
-  static void deserialize(Deserializer& de, std::stack<T, Seq>& stack) {
+  template<typename T, typename Seq, typename D>
+  static void deserialize(D& de, std::stack<T, Seq>& stack) {
     while (!stack.empty()) stack.pop(); // clear stack
     size_t size = 0;
     de.deserialize_seq_size(size);
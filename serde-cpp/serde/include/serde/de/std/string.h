@@ -8,8 +8,8 @@ namespace serde {
 
 template<>
 struct DeserializeT<std::basic_string> {
-  template<typename CharT, typename Traits, typename Alloc>
-  static void deserialize(Deserializer& de, std::basic_string<CharT, Traits, Alloc>& str) {
+  template<typename CharT, typename Traits, typename Alloc, typename D>
+  static void deserialize(D& de, std::basic_string<CharT, Traits, Alloc>& str) {
     static_assert(std::is_same_v<CharT, char>, "deserialize only supports char-based std::string");
     size_t len = 0;
     de.deserialize_length(len);
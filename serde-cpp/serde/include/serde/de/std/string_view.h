@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string_view>
+#include "../deserialize.h"
+#include "../deserializer.h"
+
+namespace serde {
+
+// string_view borrows the string from the deserializer input,
+// it is only valid as long as the deserializer (and its input) is alive.
+template<>
+struct DeserializeT<std::basic_string_view> {
+  template<typename CharT, typename Traits, typename D>
+  static void deserialize(D& de, std::basic_string_view<CharT, Traits>& str) {
+    static_assert(std::is_same_v<CharT, char>, "deserialize only supports char-based std::string_view");
+    const char* data = nullptr;
+    size_t len = 0;
+    de.deserialize_str(data, len);
+    str = std::basic_string_view<CharT, Traits>(data, len);
+  }
+};
+
+} // namespace serde
+
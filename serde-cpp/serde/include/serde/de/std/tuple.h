@@ -8,8 +8,8 @@ namespace serde {
 
 template<>
 struct DeserializeT<std::tuple> {
-  template<typename... Ts>
-  static void deserialize(Deserializer& de, std::tuple<Ts...>& tuple) {
+  template<typename... Ts, typename D>
+  static void deserialize(D& de, std::tuple<Ts...>& tuple) {
     de.deserialize_seq_begin();
     std::apply([&de] (auto&... args) {
       (de.deserialize(args), ...);
@@ -8,8 +8,8 @@ namespace serde {
 
 template<>
 struct DeserializeT<std::unordered_map> {
-  template<typename Key, typename Value, typename... U>
-  static void deserialize(Deserializer& de, std::unordered_map<Key, Value, U...>& map) {
+  template<typename Key, typename Value, typename... U, typename D>
+  static void deserialize(D& de, std::unordered_map<Key, Value, U...>& map) {
     size_t size = 0;
     map.clear();
     de.deserialize_map_size(size);
@@ -25,8 +25,8 @@ struct DeserializeT<std::unordered_map> {
 
 template<>
 struct DeserializeT<std::unordered_multimap> {
-  template<typename Key, typename Value, typename... U>
-  static void deserialize(Deserializer& de, std::unordered_multimap<Key, Value, U...>& multimap) {
+  template<typename Key, typename Value, typename... U, typename D>
+  static void deserialize(D& de, std::unordered_multimap<Key, Value, U...>& multimap) {
     size_t size = 0;
     multimap.clear();
     de.deserialize_map_size(size);
@@ -8,8 +8,8 @@ namespace serde {
 
 template<>
 struct DeserializeT<std::unordered_set> {
-  template<typename Key, typename... U>
-  static void deserialize(Deserializer& de, std::unordered_set<Key, U...>& set) {
+  template<typename Key, typename... U, typename D>
+  static void deserialize(D& de, std::unordered_set<Key, U...>& set) {
     size_t size = 0;
     set.clear();
     de.deserialize_seq_size(size);
@@ -25,8 +25,8 @@ struct DeserializeT<std::unordered_set> {
 
 template<>
 struct DeserializeT<std::unordered_multiset> {
-  template<typename Key, typename... U>
-  static void deserialize(Deserializer& de, std::unordered_multiset<Key, U...>& multiset) {
+  template<typename Key, typename... U, typename D>
+  static void deserialize(D& de, std::unordered_multiset<Key, U...>& multiset) {
     size_t size = 0;
     multiset.clear();
     de.deserialize_seq_size(size);
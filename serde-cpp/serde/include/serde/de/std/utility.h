@@ -8,8 +8,8 @@ namespace serde {
 
 template<>
 struct DeserializeT<std::pair> {
-  template<typename T1, typename T2>
-  static void deserialize(Deserializer& de, std::pair<T1, T2>& pair) {
+  template<typename T1, typename T2, typename D>
+  static void deserialize(D& de, std::pair<T1, T2>& pair) {
     de.deserialize_struct_begin();
     de.deserialize_struct_field("first", pair.first);
     de.deserialize_struct_field("second", pair.second);
@@ -10,8 +10,8 @@ namespace serde {
 
 template<>
 struct DeserializeT<std::variant> {
-  template<typename... Ts>
-  static void deserialize(Deserializer& de, std::variant<Ts...>& variant) {
+  template<typename... Ts, typename D>
+  static void deserialize(D& de, std::variant<Ts...>& variant) {
     de.deserialize_map_begin();
     size_t index = 0;
     de.deserialize_map_key(index);
@@ -21,20 +21,20 @@ struct DeserializeT<std::variant> {
 
 private:
 
-  template<typename Variant, size_t... Is>
-  static void deserialize_expand(Deserializer& de, Variant& variant, size_t index, std::integer_sequence<size_t, Is...>) {
+  template<typename D, typename Variant, size_t... Is>
+  static void deserialize_expand(D& de, Variant& variant, size_t index, std::integer_sequence<size_t, Is...>) {
     (deserialize_index<Is>(de, variant, index), ...);
   }
 
-  template<size_t I, typename Variant>
-  static void deserialize_index(Deserializer& de, Variant& variant, size_t index) {
+  template<size_t I, typename D, typename Variant>
+  static void deserialize_index(D& de, Variant& variant, size_t index) {
     if (index == I) {
       deserialize_variant<I>(de, variant);
     }
   }
 
-  template<size_t I, typename... Ts>
-  static void deserialize_variant(Deserializer& de, std::variant<Ts...>& variant) {
+  template<size_t I, typename D, typename... Ts>
+  static void deserialize_variant(D& de, std::variant<Ts...>& variant) {
     using Type = std::remove_reference_t<decltype(std::get<I>(variant))>;
     Type value;
     de.deserialize_map_value(value);
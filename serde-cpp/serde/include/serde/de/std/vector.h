@@ -4,20 +4,26 @@
 
 #include "../deserialize.h"
 #include "../deserializer.h"
+#include "../builtin.h"
+#include "../traits.h"
 
 namespace serde {
 
 template<>
 struct DeserializeT<std::vector> {
-  template<typename T, typename Alloc>
-  static void deserialize(Deserializer& de, std::vector<T, Alloc>& vec) {
+  template<typename T, typename Alloc, typename D>
+  static void deserialize(D& de, std::vector<T, Alloc>& vec) {
     size_t size = 0;
     de.deserialize_seq_size(size);
-    de.deserialize_seq_begin();
     vec.resize(size);
-    for (auto& e : vec)
-      de.deserialize(e);
-    de.deserialize_seq_end();
+    if constexpr (traits::IsSeqBuiltinDeserialize<T>::value && !std::is_same_v<T, bool>) {
+      detail::deserialize_seq_builtin(de, vec.data(), vec.size());
+    } else {
+      de.deserialize_seq_begin();
+      for (auto& e : vec)
+        de.deserialize(e);
+      de.deserialize_seq_end();
+    }
   }
 };
 
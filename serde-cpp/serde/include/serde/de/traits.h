@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <type_traits>
+#include <utility>
 
 ////////////////////////////////////////////////////////////////////////////////
 // Foward-declarations
@@ -18,22 +20,41 @@ struct Deserialize;
 // Type Traits
 namespace serde::traits {
 
-// Trait for detecting whether T has deserialize(Deserializer&) member function
-template<typename T, typename = void>
+// Trait for detecting whether T has deserialize(D&) member function,
+// where D is serde::Deserializer or a concrete deserializer type
+template<typename T, typename D = Deserializer, typename = void>
 struct HasMemberDeserialize : public std::false_type {};
 
-template<typename T>
-struct HasMemberDeserialize<T, std::enable_if_t<std::is_invocable_r_v<void, decltype(&T::deserialize), T&, Deserializer&>>>
+template<typename T, typename D>
+struct HasMemberDeserialize<T, D, std::void_t<decltype(std::declval<T&>().deserialize(std::declval<D&>()))>>
 : public std::true_type {};
 
 
-// Trait for detecting whether T has Deserialize<T, void>::deserialize static function
-template<typename T, typename = void>
+// Trait for detecting whether T has Deserialize<T, void>::deserialize(D&, T&) static function,
+// where D is serde::Deserializer or a concrete deserializer type
+template<typename T, typename D = Deserializer, typename = void>
 struct HasDeserialize : public std::false_type {};
 
-template<typename T>
-struct HasDeserialize<T, std::enable_if_t<std::is_invocable_r_v<void, decltype(&Deserialize<T, void>::deserialize), Deserializer&, T&>>>
+template<typename T, typename D>
+struct HasDeserialize<T, D, std::void_t<decltype(Deserialize<T, void>::deserialize(std::declval<D&>(), std::declval<T&>()))>>
 : public std::true_type {};
 
-} // namespace serde::traits
 
+// Trait for detecting whether D is a concrete deserializer type and not the serde::Deserializer interface
+template<typename D>
+struct IsConcreteDeserializer : public std::bool_constant<!std::is_same_v<std::remove_cv_t<D>, Deserializer>> {};
+
+
+// Trait for detecting builtin scalar types which are deserialized straight through Deserializer methods
+template<typename T>
+struct IsBuiltinDeserialize : public std::bool_constant<std::is_arithmetic_v<T>> {};
+
+
+// Trait for detecting builtin scalar types which are deserialized in bulk through Deserializer::deserialize_seq_* methods
+template<typename T>
+struct IsSeqBuiltinDeserialize : public std::bool_constant<
+  std::is_same_v<T, bool> || std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char> ||
+  std::is_same_v<T, int16_t> || std::is_same_v<T, uint16_t> || std::is_same_v<T, int32_t> || std::is_same_v<T, uint32_t> ||
+  std::is_same_v<T, int64_t> || std::is_same_v<T, uint64_t> || std::is_same_v<T, float> || std::is_same_v<T, double>> {};
+
+} // namespace serde::traits
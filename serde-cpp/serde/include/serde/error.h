@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 
 namespace serde {
@@ -10,8 +11,8 @@ struct Error final {
   };
 
   Kind kind;
-  size_t line = 0;
-  size_t column = 0;
+  size_t line = 0; // 1-based, 0 if unknown
+  size_t column = 0; // 1-based, 0 if unknown
   std::string text = "";
 };
 
@@ -0,0 +1,348 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SERDE_BASE64_X86 1
+#include <immintrin.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+// Base64 for text backends
+///////////////////////////////////////////////////////////////////////////////
+namespace serde::fmt {
+
+/// Number of chars of the base64 encoding of len bytes, with padding
+constexpr size_t base64_encoded_size(size_t len) {
+  return (len + 2) / 3 * 4;
+}
+
+/// Number of bytes encoded by the base64 text [first, last), from its length and padding only.
+/// The text isn't validated, see base64_decode.
+inline size_t base64_decoded_size(const char* first, const char* last) {
+  size_t n = static_cast<size_t>(last - first);
+  if (n % 4 == 0 && n >= 4)
+    n -= (last[-1] == '=') + (last[-1] == '=' && last[-2] == '=');
+  return n / 4 * 3 + (n % 4 ? n % 4 - 1 : 0);
+}
+
+namespace detail {
+
+inline constexpr char base64_chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+struct Base64DecodeTable {
+  uint8_t values[256]; // 6-bit value of each char, 0xFF if not a base64 char
+};
+
+constexpr Base64DecodeTable make_base64_decode_table() {
+  Base64DecodeTable table{};
+  for (auto& v : table.values)
+    v = 0xFF;
+  for (uint8_t i = 0; i < 64; i++)
+    table.values[static_cast<uint8_t>(base64_chars[i])] = i;
+  return table;
+}
+
+inline constexpr Base64DecodeTable base64_decode_table = make_base64_decode_table();
+
+/// Instruction sets of the base64 block loops, chosen at runtime
+enum class Base64Isa { Scalar, SSSE3, AVX2 };
+
+inline Base64Isa base64_detect_isa() {
+#if defined(SERDE_BASE64_X86)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    return Base64Isa::AVX2;
+  if (__builtin_cpu_supports("ssse3"))
+    return Base64Isa::SSSE3;
+#endif
+  return Base64Isa::Scalar;
+}
+
+inline Base64Isa base64_isa() {
+  static const Base64Isa isa = base64_detect_isa();
+  return isa;
+}
+
+#if defined(SERDE_BASE64_X86)
+// The SIMD block loops below follow Wojciech Muła and Daniel Lemire,
+// "Faster Base64 Encoding and Decoding using AVX2 Instructions" (2018).
+// Each returns the number of input bytes/chars it consumed, the rest is left to the scalar loop.
+
+// 16 6-bit values, one per byte, to their base64 chars
+__attribute__((target("ssse3")))
+inline __m128i base64_lookup_ssse3(__m128i indices) {
+  // reduce the values to the range they belong to: 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, '+' -> 11, '/' -> 12
+  __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+  const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+  range = _mm_or_si128(range, _mm_and_si128(less, _mm_set1_epi8(13)));
+  const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                        '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+  return _mm_add_epi8(_mm_shuffle_epi8(offsets, range), indices);
+}
+
+// Bytes 0..11 of in (as 3-byte groups) to 16 6-bit values, one per byte
+__attribute__((target("ssse3")))
+inline __m128i base64_unpack_ssse3(__m128i in) {
+  in = _mm_shuffle_epi8(in, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+  const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+  const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+  const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+  const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+  return _mm_or_si128(t1, t3);
+}
+
+__attribute__((target("ssse3")))
+inline size_t base64_encode_ssse3(const uint8_t* src, size_t len, char* dst) {
+  size_t i = 0;
+  for (; i + 16 <= len; i += 12, dst += 16) {
+    const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), base64_lookup_ssse3(base64_unpack_ssse3(in)));
+  }
+  return i;
+}
+
+// Mask of the chars of in within [lo, hi]
+__attribute__((target("ssse3")))
+inline __m128i base64_in_range_ssse3(__m128i in, char lo, char hi) {
+  return _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8(static_cast<char>(lo - 1))),
+                       _mm_cmplt_epi8(in, _mm_set1_epi8(static_cast<char>(hi + 1))));
+}
+
+// 16 base64 chars to their 6-bit values, or false if any isn't a base64 char
+__attribute__((target("ssse3")))
+inline bool base64_translate_ssse3(__m128i in, __m128i& values) {
+  const __m128i upper = base64_in_range_ssse3(in, 'A', 'Z');
+  const __m128i lower = base64_in_range_ssse3(in, 'a', 'z');
+  const __m128i digit = base64_in_range_ssse3(in, '0', '9');
+  const __m128i plus = _mm_cmpeq_epi8(in, _mm_set1_epi8('+'));
+  const __m128i slash = _mm_cmpeq_epi8(in, _mm_set1_epi8('/'));
+  const __m128i valid = _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, _mm_or_si128(plus, slash)));
+  if (_mm_movemask_epi8(valid) != 0xFFFF)
+    return false;
+  __m128i shift = _mm_and_si128(upper, _mm_set1_epi8(-'A'));
+  shift = _mm_or_si128(shift, _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+  shift = _mm_or_si128(shift, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+  shift = _mm_or_si128(shift, _mm_and_si128(plus, _mm_set1_epi8(62 - '+')));
+  shift = _mm_or_si128(shift, _mm_and_si128(slash, _mm_set1_epi8(63 - '/')));
+  values = _mm_add_epi8(in, shift);
+  return true;
+}
+
+// 16 6-bit values to 12 bytes, in bytes 0..11
+__attribute__((target("ssse3")))
+inline __m128i base64_pack_ssse3(__m128i values) {
+  const __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+  const __m128i quads = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+  return _mm_shuffle_epi8(quads, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+// Stores 16 bytes for each 12 decoded, so it stops with less than 16 bytes of room left
+__attribute__((target("ssse3")))
+inline size_t base64_decode_ssse3(const char* src, size_t len, uint8_t* dst, size_t room) {
+  size_t i = 0;
+  for (; i + 16 <= len && room >= 16; i += 16, dst += 12, room -= 12) {
+    __m128i values;
+    if (!base64_translate_ssse3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), values))
+      break;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), base64_pack_ssse3(values));
+  }
+  return i;
+}
+
+__attribute__((target("avx2")))
+inline size_t base64_encode_avx2(const uint8_t* src, size_t len, char* dst) {
+  const __m256i shuffle = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                           1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+  const __m256i offsets = _mm256_setr_epi8(
+    'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+    '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+    'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+    '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+  size_t i = 0;
+  // each 128-bit lane takes 12 bytes, the loads read 4 bytes past them
+  for (; i + 28 <= len; i += 24, dst += 32) {
+    const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 12));
+    __m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+    in = _mm256_shuffle_epi8(in, shuffle);
+    const __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+    const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+    const __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+    const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+    const __m256i indices = _mm256_or_si256(t1, t3);
+    __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+    range = _mm256_or_si256(range, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+    const __m256i chars = _mm256_add_epi8(_mm256_shuffle_epi8(offsets, range), indices);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), chars);
+  }
+  return i + base64_encode_ssse3(src + i, len - i, dst);
+}
+
+__attribute__((target("avx2")))
+inline __m256i base64_in_range_avx2(__m256i in, char lo, char hi) {
+  return _mm256_and_si256(_mm256_cmpgt_epi8(in, _mm256_set1_epi8(static_cast<char>(lo - 1))),
+                          _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(hi + 1)), in));
+}
+
+// Stores 32 bytes for each 24 decoded, so it stops with less than 32 bytes of room left
+__attribute__((target("avx2")))
+inline size_t base64_decode_avx2(const char* src, size_t len, uint8_t* dst, size_t room) {
+  size_t i = 0;
+  for (; i + 32 <= len && room >= 32; i += 32, dst += 24, room -= 24) {
+    const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    const __m256i upper = base64_in_range_avx2(in, 'A', 'Z');
+    const __m256i lower = base64_in_range_avx2(in, 'a', 'z');
+    const __m256i digit = base64_in_range_avx2(in, '0', '9');
+    const __m256i plus = _mm256_cmpeq_epi8(in, _mm256_set1_epi8('+'));
+    const __m256i slash = _mm256_cmpeq_epi8(in, _mm256_set1_epi8('/'));
+    const __m256i valid = _mm256_or_si256(_mm256_or_si256(upper, lower), _mm256_or_si256(digit, _mm256_or_si256(plus, slash)));
+    if (_mm256_movemask_epi8(valid) != -1)
+      break;
+    __m256i shift = _mm256_and_si256(upper, _mm256_set1_epi8(-'A'));
+    shift = _mm256_or_si256(shift, _mm256_and_si256(lower, _mm256_set1_epi8(26 - 'a')));
+    shift = _mm256_or_si256(shift, _mm256_and_si256(digit, _mm256_set1_epi8(52 - '0')));
+    shift = _mm256_or_si256(shift, _mm256_and_si256(plus, _mm256_set1_epi8(62 - '+')));
+    shift = _mm256_or_si256(shift, _mm256_and_si256(slash, _mm256_set1_epi8(63 - '/')));
+    const __m256i values = _mm256_add_epi8(in, shift);
+    const __m256i pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+    __m256i bytes = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+    bytes = _mm256_shuffle_epi8(bytes, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                                        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    // 12 bytes at the start of each lane, made contiguous
+    bytes = _mm256_permutevar8x32_epi32(bytes, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), bytes);
+  }
+  return i + base64_decode_ssse3(src + i, len - i, dst, room);
+}
+#endif // SERDE_BASE64_X86
+
+inline char* base64_encode(Base64Isa isa, const uint8_t* src, size_t len, char* dst) {
+  size_t i = 0;
+#if defined(SERDE_BASE64_X86)
+  if (isa == Base64Isa::AVX2)
+    i = base64_encode_avx2(src, len, dst);
+  else if (isa == Base64Isa::SSSE3)
+    i = base64_encode_ssse3(src, len, dst);
+  dst += i / 3 * 4;
+#else
+  (void)isa;
+#endif
+  for (; i + 3 <= len; i += 3, dst += 4) {
+    const uint32_t v = uint32_t(src[i]) << 16 | uint32_t(src[i + 1]) << 8 | src[i + 2];
+    dst[0] = base64_chars[v >> 18];
+    dst[1] = base64_chars[(v >> 12) & 0x3F];
+    dst[2] = base64_chars[(v >> 6) & 0x3F];
+    dst[3] = base64_chars[v & 0x3F];
+  }
+  if (len - i == 1) {
+    dst[0] = base64_chars[src[i] >> 2];
+    dst[1] = base64_chars[(src[i] & 0x03) << 4];
+    dst[2] = '=';
+    dst[3] = '=';
+    dst += 4;
+  }
+  else if (len - i == 2) {
+    dst[0] = base64_chars[src[i] >> 2];
+    dst[1] = base64_chars[(src[i] & 0x03) << 4 | src[i + 1] >> 4];
+    dst[2] = base64_chars[(src[i + 1] & 0x0F) << 2];
+    dst[3] = '=';
+    dst += 4;
+  }
+  return dst;
+}
+
+inline uint8_t* base64_decode(Base64Isa isa, const char* first, const char* last, uint8_t* out, uint8_t* out_last) {
+  size_t n = static_cast<size_t>(last - first);
+  if (n % 4 == 0 && n >= 4)
+    n -= (last[-1] == '=') + (last[-1] == '=' && last[-2] == '=');
+  const size_t tail = n % 4;
+  if (tail == 1)
+    return nullptr;
+  const size_t size = n / 4 * 3 + (tail ? tail - 1 : 0);
+  if (static_cast<size_t>(out_last - out) < size)
+    return nullptr;
+  const size_t full = n - tail;
+  size_t i = 0;
+#if defined(SERDE_BASE64_X86)
+  // the block loops store past the bytes they decode, give them only the decoded size
+  // so the bytes of [out, out_last) after it are left untouched
+  if (isa == Base64Isa::AVX2)
+    i = base64_decode_avx2(first, full, out, size);
+  else if (isa == Base64Isa::SSSE3)
+    i = base64_decode_ssse3(first, full, out, size);
+  out += i / 4 * 3;
+#else
+  (void)isa;
+#endif
+  const auto& table = base64_decode_table.values;
+  for (; i < full; i += 4, out += 3) {
+    const uint8_t a = table[static_cast<uint8_t>(first[i])], b = table[static_cast<uint8_t>(first[i + 1])];
+    const uint8_t c = table[static_cast<uint8_t>(first[i + 2])], d = table[static_cast<uint8_t>(first[i + 3])];
+    if ((a | b | c | d) & 0x80)
+      return nullptr;
+    const uint32_t v = uint32_t(a) << 18 | uint32_t(b) << 12 | uint32_t(c) << 6 | d;
+    out[0] = static_cast<uint8_t>(v >> 16);
+    out[1] = static_cast<uint8_t>(v >> 8);
+    out[2] = static_cast<uint8_t>(v);
+  }
+  if (tail) {
+    const uint8_t a = table[static_cast<uint8_t>(first[i])], b = table[static_cast<uint8_t>(first[i + 1])];
+    const uint8_t c = tail == 3 ? table[static_cast<uint8_t>(first[i + 2])] : 0;
+    if ((a | b | c) & 0x80)
+      return nullptr;
+    *out++ = static_cast<uint8_t>(a << 2 | b >> 4);
+    if (tail == 3)
+      *out++ = static_cast<uint8_t>(b << 4 | c >> 2);
+  }
+  return out;
+}
+
+} // namespace detail
+
+/// Write the base64 encoding of [data, data + len) into out, with padding.
+/// out must have room for base64_encoded_size(len) chars. Returns the end of the written text.
+///
+/// Blocks of input are encoded with AVX2 or SSSE3 when the CPU supports them (checked once at runtime).
+inline char* base64_encode(const void* data, size_t len, char* out) {
+  return detail::base64_encode(detail::base64_isa(), static_cast<const uint8_t*>(data), len, out);
+}
+
+/// Append the base64 encoding of [data, data + len) to out
+inline void base64_encode(const void* data, size_t len, std::string& out) {
+  const size_t pos = out.size();
+  out.resize(pos + base64_encoded_size(len));
+  base64_encode(data, len, &out[pos]);
+}
+
+/// Decode the base64 text [first, last), padded or not, into [out, out_last).
+/// Returns the end of the written bytes, or nullptr if the text isn't base64 or the bytes don't fit,
+/// in which case the contents of [out, out_last) are unspecified. The bytes after the decoded ones
+/// are never written.
+///
+/// The decoded size is known from the text length, so the bytes are decoded in a single pass,
+/// blocks of text with AVX2 or SSSE3 when the CPU supports them (checked once at runtime).
+inline uint8_t* base64_decode(const char* first, const char* last, uint8_t* out, uint8_t* out_last) {
+  return detail::base64_decode(detail::base64_isa(), first, last, out, out_last);
+}
+
+/// Decode the base64 text [first, last), padded or not, appending the bytes to out.
+/// Returns false if the text isn't base64, leaving out as it was.
+inline bool base64_decode(const char* first, const char* last, std::vector<uint8_t>& out) {
+  const size_t size = base64_decoded_size(first, last);
+  if (size == 0) // empty text, or invalid (a single char), out.data() may be null
+    return first == last;
+  const size_t pos = out.size();
+  out.resize(pos + size);
+  if (!base64_decode(first, last, out.data() + pos, out.data() + out.size())) {
+    out.resize(pos);
+    return false;
+  }
+  return true;
+}
+
+} // namespace serde::fmt
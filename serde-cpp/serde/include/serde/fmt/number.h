@@ -0,0 +1,111 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+///////////////////////////////////////////////////////////////////////////////
+// Number formatting for text backends
+///////////////////////////////////////////////////////////////////////////////
+namespace serde::fmt {
+
+/// Buffer size enough for any integer and for any shortest round-trip float
+inline constexpr size_t number_max_chars = 32;
+
+namespace detail {
+inline constexpr char digit_pairs[] =
+  "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+  "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+  "8081828384858687888990919293949596979899";
+
+// Digits of v written backwards, ending at end, two at a time from the digit pairs table
+template<typename U>
+inline char* write_uint_backwards(char* end, U v) {
+  while (v >= 100) {
+    const size_t pair = static_cast<size_t>(v % 100) * 2;
+    v /= 100;
+    end -= 2;
+    std::memcpy(end, digit_pairs + pair, 2);
+  }
+  if (v >= 10) {
+    end -= 2;
+    std::memcpy(end, digit_pairs + static_cast<size_t>(v) * 2, 2);
+  }
+  else {
+    *--end = static_cast<char>('0' + v);
+  }
+  return end;
+}
+
+#if !defined(__cpp_lib_to_chars)
+// printf based fallback for standard libraries without floating point std::to_chars,
+// with the locale's decimal separator (if any) replaced by '.'
+inline char* format_printf(char* first, char* last, const char* format, int precision, double v) {
+  char tmp[400];
+  const int len = std::snprintf(tmp, sizeof(tmp), format, precision, v);
+  if (len < 0 || size_t(len) >= sizeof(tmp) || len > last - first)
+    return nullptr;
+  for (int i = 0; i < len; i++)
+    first[i] = tmp[i] == ',' ? '.' : tmp[i];
+  return first + len;
+}
+#endif
+} // namespace detail
+
+/// Write the integer v in decimal into [first, last).
+/// Returns the end of the written text, or nullptr if it doesn't fit.
+template<typename T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>, int> = 0>
+inline char* format_int(char* first, char* last, T v) {
+  using U = std::make_unsigned_t<T>;
+  char tmp[number_max_chars];
+  char* const end = tmp + sizeof(tmp);
+  char* begin;
+  if constexpr (std::is_signed_v<T>) {
+    // negate in unsigned, so the minimum value doesn't overflow
+    const U abs = v < 0 ? static_cast<U>(U(0) - static_cast<U>(v)) : static_cast<U>(v);
+    begin = detail::write_uint_backwards(end, abs);
+    if (v < 0)
+      *--begin = '-';
+  }
+  else {
+    begin = detail::write_uint_backwards(end, static_cast<U>(v));
+  }
+  const size_t len = static_cast<size_t>(end - begin);
+  if (static_cast<size_t>(last - first) < len)
+    return nullptr;
+  std::memcpy(first, begin, len);
+  return first + len;
+}
+
+/// Write v into [first, last) with the fewest digits that parse back to exactly v,
+/// independently of the locale: "0.1", "3.14159", "1e+100". Non finite values as "inf", "-inf", "nan".
+/// Returns the end of the written text, or nullptr if it doesn't fit.
+template<typename T, std::enable_if_t<std::is_floating_point_v<T>, int> = 0>
+inline char* format_float(char* first, char* last, T v) {
+#if defined(__cpp_lib_to_chars)
+  auto res = std::to_chars(first, last, v);
+  return res.ec == std::errc() ? res.ptr : nullptr;
+#else
+  // round-trips, but isn't always the shortest
+  return detail::format_printf(first, last, "%.*g", std::numeric_limits<T>::max_digits10, double(v));
+#endif
+}
+
+/// Write v into [first, last) in fixed notation with precision digits after the decimal point,
+/// independently of the locale: "3.14", "100.00".
+/// Returns the end of the written text, or nullptr if it doesn't fit.
+template<typename T, std::enable_if_t<std::is_floating_point_v<T>, int> = 0>
+inline char* format_float_fixed(char* first, char* last, T v, int precision) {
+#if defined(__cpp_lib_to_chars)
+  auto res = std::to_chars(first, last, v, std::chars_format::fixed, precision);
+  return res.ec == std::errc() ? res.ptr : nullptr;
+#else
+  return detail::format_printf(first, last, "%.*f", precision, double(v));
+#endif
+}
+
+} // namespace serde::fmt
@@ -0,0 +1,406 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+#include "detail/power_of_five.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// Number parsing for text backends
+///////////////////////////////////////////////////////////////////////////////
+namespace serde::fmt {
+
+/// Result of parse_int/parse_float
+enum class ParseStatus {
+  Ok,
+  Invalid,    // not a number of the expected kind, val is left untouched
+  OutOfRange, // a number, but it doesn't fit in the type, val is left untouched
+};
+
+namespace detail {
+
+struct uint128 {
+  uint64_t high;
+  uint64_t low;
+};
+
+inline uint128 full_multiplication(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+  const unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+  return {static_cast<uint64_t>(r >> 64), static_cast<uint64_t>(r)};
+#else
+  const uint64_t a_lo = a & 0xFFFFFFFF, a_hi = a >> 32;
+  const uint64_t b_lo = b & 0xFFFFFFFF, b_hi = b >> 32;
+  const uint64_t lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo, lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+  const uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+  return {(hi_lo >> 32) + (cross >> 32) + hi_hi, (cross << 32) | (lo_lo & 0xFFFFFFFF)};
+#endif
+}
+
+// v must not be zero
+inline int leading_zeroes(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_clzll(v);
+#else
+  int n = 0;
+  while (!(v & (uint64_t(1) << 63))) {
+    v <<= 1;
+    n++;
+  }
+  return n;
+#endif
+}
+
+template<typename T>
+struct FloatFormat;
+
+template<>
+struct FloatFormat<double> {
+  using Bits = uint64_t;
+  static constexpr int mantissa_bits = 52;
+  static constexpr int minimum_exponent = -1023;
+  static constexpr int infinite_power = 0x7FF;
+  static constexpr int min_exponent_round_to_even = -4;
+  static constexpr int max_exponent_round_to_even = 23;
+  static constexpr int smallest_power_of_ten = -342;
+  static constexpr int largest_power_of_ten = 308;
+  static constexpr int max_exponent_fast_path = 22;
+  static constexpr uint64_t max_mantissa_fast_path = uint64_t(1) << 53;
+  static constexpr double exact_powers_of_ten[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+};
+
+template<>
+struct FloatFormat<float> {
+  using Bits = uint32_t;
+  static constexpr int mantissa_bits = 23;
+  static constexpr int minimum_exponent = -127;
+  static constexpr int infinite_power = 0xFF;
+  static constexpr int min_exponent_round_to_even = -17;
+  static constexpr int max_exponent_round_to_even = 10;
+  static constexpr int smallest_power_of_ten = -65;
+  static constexpr int largest_power_of_ten = 38;
+  static constexpr int max_exponent_fast_path = 10;
+  static constexpr uint64_t max_mantissa_fast_path = uint64_t(1) << 24;
+  static constexpr float exact_powers_of_ten[] = {
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+};
+
+// Binary mantissa and biased exponent of a float
+struct AdjustedMantissa {
+  uint64_t mantissa = 0;
+  int power2 = 0;
+  bool operator==(const AdjustedMantissa& o) const { return mantissa == o.mantissa && power2 == o.power2; }
+  bool operator!=(const AdjustedMantissa& o) const { return !(*this == o); }
+};
+
+// w * 5^q, truncated to the bits needed for the mantissa plus the rounding bits
+template<int bit_precision>
+inline uint128 product_approximation(int64_t q, uint64_t w) {
+  const size_t index = 2 * static_cast<size_t>(q - smallest_power_of_five);
+  uint128 first = full_multiplication(w, power_of_five_128[index]);
+  constexpr uint64_t precision_mask = uint64_t(0xFFFFFFFFFFFFFFFF) >> bit_precision;
+  if ((first.high & precision_mask) == precision_mask) {
+    // the lower bits may carry into the kept ones, refine with the next 64 bits of 5^q
+    const uint128 second = full_multiplication(w, power_of_five_128[index + 1]);
+    first.low += second.high;
+    if (second.high > first.low)
+      first.high++;
+  }
+  return first;
+}
+
+// Eisel-Lemire: the float closest to w * 10^q, rounding ties to even.
+// Exact for any 64-bit w (Mushtak & Lemire, "Fast number parsing without fallback", 2023).
+template<typename T>
+inline AdjustedMantissa compute_float(int64_t q, uint64_t w) {
+  using F = FloatFormat<T>;
+  AdjustedMantissa answer;
+  if (w == 0 || q < F::smallest_power_of_ten)
+    return answer; // zero
+  if (q > F::largest_power_of_ten) {
+    answer.power2 = F::infinite_power;
+    return answer;
+  }
+  const int lz = leading_zeroes(w);
+  w <<= lz;
+  const uint128 product = product_approximation<F::mantissa_bits + 3>(q, w);
+  const int upperbit = static_cast<int>(product.high >> 63);
+  const int shift = upperbit + 64 - F::mantissa_bits - 3;
+  answer.mantissa = product.high >> shift;
+  // floor(log2(10^q)) = floor(q * log2(10)) = ((217706 * q) >> 16) in the exponent range
+  const int power = static_cast<int>(((152170 + 65536) * q) >> 16) + 63;
+  answer.power2 = power + upperbit - lz - F::minimum_exponent;
+  if (answer.power2 <= 0) {
+    // subnormal
+    if (-answer.power2 + 1 >= 64) {
+      answer.mantissa = 0;
+      answer.power2 = 0;
+      return answer;
+    }
+    answer.mantissa >>= -answer.power2 + 1;
+    answer.mantissa += (answer.mantissa & 1);
+    answer.mantissa >>= 1;
+    // rounding up may have made it the smallest normal
+    answer.power2 = answer.mantissa < (uint64_t(1) << F::mantissa_bits) ? 0 : 1;
+    return answer;
+  }
+  // exactly between two floats, only possible when 5^q fits in 64 bits: round to even
+  if (product.low <= 1 && q >= F::min_exponent_round_to_even && q <= F::max_exponent_round_to_even &&
+      (answer.mantissa & 3) == 1) {
+    if ((answer.mantissa << shift) == product.high)
+      answer.mantissa &= ~uint64_t(1);
+  }
+  answer.mantissa += (answer.mantissa & 1);
+  answer.mantissa >>= 1;
+  if (answer.mantissa >= (uint64_t(2) << F::mantissa_bits)) {
+    answer.mantissa = uint64_t(1) << F::mantissa_bits;
+    answer.power2++;
+  }
+  answer.mantissa &= ~(uint64_t(1) << F::mantissa_bits);
+  if (answer.power2 >= F::infinite_power) {
+    answer.power2 = F::infinite_power;
+    answer.mantissa = 0;
+  }
+  return answer;
+}
+
+template<typename T>
+inline T to_float(bool negative, const AdjustedMantissa& am) {
+  using F = FloatFormat<T>;
+  auto bits = static_cast<typename F::Bits>(am.mantissa | (uint64_t(am.power2) << F::mantissa_bits));
+  if (negative)
+    bits |= typename F::Bits(1) << (sizeof(bits) * 8 - 1);
+  T val;
+  std::memcpy(&val, &bits, sizeof(val));
+  return val;
+}
+
+inline bool equals_nocase(const char* first, const char* last, const char* word) {
+  for (; first != last; ++first, ++word) {
+    if (*word == '\0' || (*first | 0x20) != *word)
+      return false;
+  }
+  return *word == '\0';
+}
+
+// Exact conversion by the standard library, for more than 19 significant digits
+template<typename T>
+inline ParseStatus parse_float_fallback(const char* first, const char* last, T& val) {
+#if defined(__cpp_lib_to_chars)
+  T res;
+  auto [ptr, ec] = std::from_chars(first, last, res);
+  if (ec == std::errc::result_out_of_range)
+    return ParseStatus::OutOfRange;
+  if (ec != std::errc() || ptr != last)
+    return ParseStatus::Invalid;
+  val = res;
+  return ParseStatus::Ok;
+#else
+  const std::string str(first, last);
+  char* end = nullptr;
+  const T res = std::is_same_v<T, float> ? std::strtof(str.c_str(), &end) : std::strtod(str.c_str(), &end);
+  if (end != str.c_str() + str.size())
+    return ParseStatus::Invalid;
+  if (res == std::numeric_limits<T>::infinity() || res == -std::numeric_limits<T>::infinity())
+    return ParseStatus::OutOfRange;
+  val = res;
+  return ParseStatus::Ok;
+#endif
+}
+
+} // namespace detail
+
+/// Parse the whole of [first, last) as an integer: optional sign, then decimal digits,
+/// or hexadecimal, octal or binary digits after a 0x, 0o or 0b prefix.
+/// Values that don't fit in T, including negative values for unsigned T, are OutOfRange.
+template<typename T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>, int> = 0>
+inline ParseStatus parse_int(const char* first, const char* last, T& val) {
+  const char* p = first;
+  bool negative = false;
+  if (p != last && (*p == '+' || *p == '-')) {
+    negative = *p == '-';
+    ++p;
+  }
+  unsigned base = 10;
+  if (last - p > 2 && p[0] == '0') {
+    switch (p[1]) {
+      case 'x': case 'X': base = 16; break;
+      case 'o': case 'O': base = 8; break;
+      case 'b': case 'B': base = 2; break;
+      default: break;
+    }
+    if (base != 10)
+      p += 2;
+  }
+  if (p == last)
+    return ParseStatus::Invalid;
+
+  uint64_t acc = 0;
+  bool overflow = false;
+  if (base == 10) {
+    // up to 19 digits always fit in 64 bits, only check the digits after those
+    const char* unchecked_end = last - p > 19 ? p + 19 : last;
+    for (; p != unchecked_end; ++p) {
+      const unsigned d = static_cast<unsigned char>(*p) - unsigned('0');
+      if (d > 9)
+        return ParseStatus::Invalid;
+      acc = acc * 10 + d;
+    }
+    for (; p != last; ++p) {
+      const unsigned d = static_cast<unsigned char>(*p) - unsigned('0');
+      if (d > 9)
+        return ParseStatus::Invalid;
+      overflow = overflow || acc > (UINT64_MAX - d) / 10;
+      acc = acc * 10 + d;
+    }
+  }
+  else {
+    for (; p != last; ++p) {
+      const unsigned char c = static_cast<unsigned char>(*p);
+      unsigned d;
+      if (c >= '0' && c <= '9')
+        d = c - '0';
+      else if ((c | 0x20) >= 'a' && (c | 0x20) <= 'f')
+        d = (c | 0x20) - 'a' + 10;
+      else
+        return ParseStatus::Invalid;
+      if (d >= base)
+        return ParseStatus::Invalid;
+      overflow = overflow || acc > (UINT64_MAX - d) / base;
+      acc = acc * base + d;
+    }
+  }
+  if (overflow)
+    return ParseStatus::OutOfRange;
+
+  using U = std::make_unsigned_t<T>;
+  if constexpr (std::is_signed_v<T>) {
+    const uint64_t limit = negative ? uint64_t(std::numeric_limits<T>::max()) + 1 : uint64_t(std::numeric_limits<T>::max());
+    if (acc > limit)
+      return ParseStatus::OutOfRange;
+    // negate in unsigned, so the minimum value doesn't overflow
+    val = static_cast<T>(negative ? static_cast<U>(U(0) - static_cast<U>(acc)) : static_cast<U>(acc));
+  }
+  else {
+    if ((negative && acc != 0) || acc > uint64_t(std::numeric_limits<T>::max()))
+      return ParseStatus::OutOfRange;
+    val = static_cast<T>(acc);
+  }
+  return ParseStatus::Ok;
+}
+
+/// Parse the whole of [first, last) as a float: optional sign, decimal digits with an optional
+/// fraction and exponent ("1", "-0.5", "1.5e-7"), or "inf", "infinity", "nan" in any case.
+/// Converts to the closest float, ties to even. Values too large for T are OutOfRange.
+///
+/// Up to 19 significant digits, the value is computed exactly from the digits, either with
+/// a single float multiplication (Clinger's fast path) or with the Eisel-Lemire algorithm.
+/// Longer inputs, rarely ambiguous after truncation to 19 digits, fall back to the standard library.
+template<typename T, std::enable_if_t<std::is_floating_point_v<T>, int> = 0>
+inline ParseStatus parse_float(const char* first, const char* last, T& val) {
+  using F = detail::FloatFormat<T>;
+  const char* p = first;
+  bool negative = false;
+  if (p != last && (*p == '+' || *p == '-')) {
+    negative = *p == '-';
+    ++p;
+  }
+  if (p != last && (*p | 0x20) >= 'a' && (*p | 0x20) <= 'z') {
+    if (detail::equals_nocase(p, last, "inf") || detail::equals_nocase(p, last, "infinity")) {
+      val = negative ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+      return ParseStatus::Ok;
+    }
+    if (detail::equals_nocase(p, last, "nan")) {
+      val = negative ? -std::numeric_limits<T>::quiet_NaN() : std::numeric_limits<T>::quiet_NaN();
+      return ParseStatus::Ok;
+    }
+    return ParseStatus::Invalid;
+  }
+
+  // significant digits in w, up to 19, the value being w * 10^exponent
+  uint64_t w = 0;
+  int64_t exponent = 0;
+  int num_digits = 0;
+  bool any_digit = false;
+  bool truncated = false;
+  for (; p != last && unsigned(*p - '0') <= 9; ++p) {
+    any_digit = true;
+    const unsigned d = unsigned(*p - '0');
+    if (num_digits < 19) {
+      w = w * 10 + d;
+      num_digits += (w != 0);
+    }
+    else {
+      exponent++;
+      truncated = truncated || d != 0;
+    }
+  }
+  if (p != last && *p == '.') {
+    ++p;
+    for (; p != last && unsigned(*p - '0') <= 9; ++p) {
+      any_digit = true;
+      const unsigned d = unsigned(*p - '0');
+      if (num_digits < 19) {
+        w = w * 10 + d;
+        num_digits += (w != 0);
+        exponent--;
+      }
+      else {
+        truncated = truncated || d != 0;
+      }
+    }
+  }
+  if (!any_digit)
+    return ParseStatus::Invalid;
+  if (p != last && (*p == 'e' || *p == 'E')) {
+    ++p;
+    bool exp_negative = false;
+    if (p != last && (*p == '+' || *p == '-')) {
+      exp_negative = *p == '-';
+      ++p;
+    }
+    if (p == last)
+      return ParseStatus::Invalid;
+    int64_t exp = 0;
+    for (; p != last; ++p) {
+      const unsigned d = unsigned(*p - '0');
+      if (d > 9)
+        return ParseStatus::Invalid;
+      if (exp < 100000) // saturate, way beyond the range of any float
+        exp = exp * 10 + d;
+    }
+    exponent += exp_negative ? -exp : exp;
+  }
+  if (p != last)
+    return ParseStatus::Invalid;
+
+  if (!truncated && exponent >= -F::max_exponent_fast_path && exponent <= F::max_exponent_fast_path &&
+      w <= F::max_mantissa_fast_path) {
+    // both w and the power of ten are exact floats, a single rounding gives the closest float
+    T res = static_cast<T>(w);
+    if (exponent < 0)
+      res = res / F::exact_powers_of_ten[-exponent];
+    else
+      res = res * F::exact_powers_of_ten[exponent];
+    val = negative ? -res : res;
+    return ParseStatus::Ok;
+  }
+
+  detail::AdjustedMantissa am = detail::compute_float<T>(exponent, w);
+  if (truncated && am != detail::compute_float<T>(exponent, w + 1))
+    return detail::parse_float_fallback(first, last, val);
+  if (am.power2 == F::infinite_power)
+    return ParseStatus::OutOfRange;
+  val = detail::to_float<T>(negative, am);
+  return ParseStatus::Ok;
+}
+
+} // namespace serde::fmt
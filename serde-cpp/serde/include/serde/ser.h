@@ -4,4 +4,4 @@
 #include "ser/serialize.h"
 #include "ser/serializer.h"
 #include "ser/builtin.h"
-
+#include "ser/static_serializer.h"
@@ -1,14 +1,22 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
+#include <type_traits>
 #include "serialize.h"
 #include "serializer.h"
 
 namespace serde {
 
 namespace detail {
-template<typename T>
-inline void serialize_signed_integer(Serializer& ser, const T& val) {
+// Length of the null-terminated string in a char buffer of size N, N if there is no null
+inline size_t cstr_length(const char* val, size_t N) {
+  const void* end = std::memchr(val, '\0', N);
+  return end ? static_cast<const char*>(end) - val : N;
+}
+
+template<typename S, typename T>
+inline void serialize_signed_integer(S& ser, const T& val) {
   if constexpr (sizeof(std::decay_t<T>) == 1) {
     ser.serialize_i8(val);
   }
@@ -25,8 +33,8 @@ inline void serialize_signed_integer(Serializer& ser, const T& val) {
   }
 }
 
-template<typename T>
-inline void serialize_unsigned_integer(Serializer& ser, const T& val) {
+template<typename S, typename T>
+inline void serialize_unsigned_integer(S& ser, const T& val) {
   if constexpr (sizeof(std::decay_t<T>) == 1) {
     ser.serialize_u8(val);
   }
@@ -42,109 +50,181 @@ inline void serialize_unsigned_integer(Serializer& ser, const T& val) {
     static_assert(sizeof(std::decay_t<T>) <= 8, "unsupported unsigned integer size");
   }
 }
+
+// Serialize builtin scalars straight through the serializer methods,
+// S may be serde::Serializer or a concrete serializer type (static dispatch).
+template<typename S, typename T>
+inline void serialize_builtin(S& ser, const T& val) {
+  if constexpr (std::is_same_v<T, bool>) {
+    ser.serialize_bool(val);
+  }
+  else if constexpr (std::is_same_v<T, char> || std::is_same_v<T, signed char>) {
+    ser.serialize_char(val);
+  }
+  else if constexpr (std::is_same_v<T, unsigned char>) {
+    ser.serialize_uchar(val);
+  }
+  else if constexpr (std::is_same_v<T, float>) {
+    ser.serialize_float(val);
+  }
+  else if constexpr (std::is_same_v<T, double>) {
+    ser.serialize_double(val);
+  }
+  else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+    serialize_signed_integer(ser, val);
+  }
+  else if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T>) {
+    serialize_unsigned_integer(ser, val);
+  }
+  else if constexpr (std::is_same_v<T, char*> || std::is_same_v<T, const char*>) {
+    ser.serialize_cstr(val);
+  } else {
+    static_assert(sizeof(T) == 0, "unsupported builtin type");
+  }
+}
+
+// Serialize a contiguous block of builtin scalars as a sequence with a single serializer call,
+// S may be serde::Serializer or a concrete serializer type (static dispatch).
+template<typename S, typename T>
+inline void serialize_seq_builtin(S& ser, const T* vals, size_t len) {
+  if constexpr (std::is_same_v<T, bool>) {
+    ser.serialize_seq_bool(vals, len);
+  }
+  else if constexpr (std::is_same_v<T, char> || std::is_same_v<T, signed char>) {
+    ser.serialize_seq_char(reinterpret_cast<const char*>(vals), len);
+  }
+  else if constexpr (std::is_same_v<T, unsigned char>) {
+    ser.serialize_seq_uchar(vals, len);
+  }
+  else if constexpr (std::is_same_v<T, int16_t>) {
+    ser.serialize_seq_i16(vals, len);
+  }
+  else if constexpr (std::is_same_v<T, uint16_t>) {
+    ser.serialize_seq_u16(vals, len);
+  }
+  else if constexpr (std::is_same_v<T, int32_t>) {
+    ser.serialize_seq_i32(vals, len);
+  }
+  else if constexpr (std::is_same_v<T, uint32_t>) {
+    ser.serialize_seq_u32(vals, len);
+  }
+  else if constexpr (std::is_same_v<T, int64_t>) {
+    ser.serialize_seq_i64(vals, len);
+  }
+  else if constexpr (std::is_same_v<T, uint64_t>) {
+    ser.serialize_seq_u64(vals, len);
+  }
+  else if constexpr (std::is_same_v<T, float>) {
+    ser.serialize_seq_float(vals, len);
+  }
+  else if constexpr (std::is_same_v<T, double>) {
+    ser.serialize_seq_double(vals, len);
+  } else {
+    static_assert(sizeof(T) == 0, "unsupported builtin sequence type");
+  }
+}
 } // namespace detail
 
 template<>
 inline void serialize(Serializer& ser, const bool& v)
 {
-  ser.serialize_bool(v);
+  detail::serialize_builtin(ser, v);
 }
 
 template<>
 inline void serialize(Serializer& ser, const int& v)
 {
-  detail::serialize_signed_integer(ser, v);
+  detail::serialize_builtin(ser, v);
 }
 
 template<>
 inline void serialize(Serializer& ser, const short int& v)
 {
-  detail::serialize_signed_integer(ser, v);
+  detail::serialize_builtin(ser, v);
 }
 
 template<>
 inline void serialize(Serializer& ser, const long int& v)
 {
-  detail::serialize_signed_integer(ser, v);
+  detail::serialize_builtin(ser, v);
 }
 
 template<>
 inline void serialize(Serializer& ser, const long long int& v)
 {
-  detail::serialize_signed_integer(ser, v);
+  detail::serialize_builtin(ser, v);
 }
 
 template<>
 inline void serialize(Serializer& ser, const unsigned int& v)
 {
-  detail::serialize_unsigned_integer(ser, v);
+  detail::serialize_builtin(ser, v);
 }
 
 template<>
 inline void serialize(Serializer& ser, const short unsigned int& v)
 {
-  detail::serialize_unsigned_integer(ser, v);
+  detail::serialize_builtin(ser, v);
 }
 
 template<>
 inline void serialize(Serializer& ser, const long unsigned int& v)
 {
-  detail::serialize_unsigned_integer(ser, v);
+  detail::serialize_builtin(ser, v);
 }
 
 template<>
 inline void serialize(Serializer& ser, const long long unsigned int& v)
 {
-  detail::serialize_unsigned_integer(ser, v);
+  detail::serialize_builtin(ser, v);
 }
 
 template<>
 inline void serialize(Serializer& ser, const float& v)
 {
-  ser.serialize_float(v);
+  detail::serialize_builtin(ser, v);
 }
 
 template<>
 inline void serialize(Serializer& ser, const double& v)
 {
-  ser.serialize_double(v);
+  detail::serialize_builtin(ser, v);
 }
 
 template<>
 inline void serialize(Serializer& ser, const char& v)
 {
-  ser.serialize_char(v);
+  detail::serialize_builtin(ser, v);
 }
 
 template<>
 inline void serialize(Serializer& ser, const signed char& v)
 {
-  ser.serialize_char(v);
+  detail::serialize_builtin(ser, v);
 }
 
 template<>
 inline void serialize(Serializer& ser, const unsigned char& v)
 {
-  ser.serialize_uchar(v);
+  detail::serialize_builtin(ser, v);
 }
 
 template<>
 inline void serialize(Serializer& ser, char* const& val)
 {
-  ser.serialize_cstr(val);
+  detail::serialize_builtin(ser, val);
 }
 
 template<>
 inline void serialize(Serializer& ser, const char* const& val)
 {
-  ser.serialize_cstr(val);
+  detail::serialize_builtin(ser, val);
 }
 
 template<size_t N>
 inline void serialize(Serializer& ser, const char (&val)[N])
 {
-  ser.serialize_cstr(val);
+  ser.serialize_str(val, detail::cstr_length(val, N));
 }
 
 } // namespace serde
-
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstddef>
+#include <type_traits>
+#include "traits.h"
 
 namespace serde {
 
@@ -37,6 +39,14 @@ inline void serialize(Serializer& ser, const T<U...>& val) {
   SerializeT<T>::template serialize<U...>(ser, val);
 }
 
+// Serialization for template types through a concrete serializer (static dispatch).
+// Specializations of SerializeT templated on the serializer type get the concrete type S,
+// otherwise S converts to Serializer& and the virtual path is taken.
+template<typename S, template<typename...> typename T, typename... U>
+inline auto serialize(S& ser, const T<U...>& val) -> std::enable_if_t<traits::IsConcreteSerializer<S>::value> {
+  SerializeT<T>::template serialize<U...>(ser, val);
+}
+
 
 // Serialization for template types with only integral parameter, e.g. std::bitset.
 template<template<auto...> typename T>
@@ -52,6 +62,12 @@ inline void serialize(Serializer& ser, const T<N...>& val) {
   SerializeN<T>::template serialize<N...>(ser, val);
 }
 
+// Serialization for template types with only integral parameter through a concrete serializer.
+template<typename S, template<auto...> typename T, auto... N>
+inline auto serialize(S& ser, const T<N...>& val) -> std::enable_if_t<traits::IsConcreteSerializer<S>::value> {
+  SerializeN<T>::template serialize<N...>(ser, val);
+}
+
 
 // Serialization for template types with typename and integral parameter, e.g. std::array.
 template<template<typename, auto, auto...> typename T>
@@ -67,6 +83,12 @@ inline void serialize(Serializer& ser, const T<U, N, M...>& val) {
   SerializeTN<T>::template serialize<U, N, M...>(ser, val);
 }
 
+// Serialization for template types with typename and integral parameter through a concrete serializer.
+template<typename S, template<typename, auto, auto...> typename T, typename U, auto N, auto... M>
+inline auto serialize(S& ser, const T<U, N, M...>& val) -> std::enable_if_t<traits::IsConcreteSerializer<S>::value> {
+  SerializeTN<T>::template serialize<U, N, M...>(ser, val);
+}
+
 
 // Serialization for string literals, builtin implementation!
 template<size_t N>
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include "serialize.h"
 #include "traits.h"
 
@@ -46,19 +48,56 @@ public:
   virtual void serialize_double(double) = 0;
   virtual void serialize_char(char) = 0;
   virtual void serialize_uchar(unsigned char) = 0;
-  virtual void serialize_cstr(const char*) = 0;
+  virtual void serialize_str(const char* val, size_t len) = 0; /* not null-terminated, may contain nulls */
+  virtual void serialize_cstr(const char* val) { serialize_str(val, val ? std::strlen(val) : 0); } /* null-terminated */
   virtual void serialize_bytes(const void* val, size_t len) = 0;
 
   // Optional //////////////////////////////////////////////////////////////////
   virtual void serialize_none() = 0;
+  // Announce that the next value is the content of a present optional (std::optional, smart pointers).
+  // Self-describing dataformats tell a value from none by the value itself and don't need it,
+  // the default implementation does nothing.
+  virtual void serialize_some() {}
 
   // Sequence //////////////////////////////////////////////////////////////////
   virtual void serialize_seq_begin() = 0;
   virtual void serialize_seq_end() = 0;
+  // Begin a sequence announcing its number of elements up front.
+  // std containers which know their size call this instead of serialize_seq_begin(),
+  // the default implementation drops the size and calls serialize_seq_begin().
+  virtual void serialize_seq_begin_sized(size_t len) { serialize_seq_begin(); }
+  // Begin a sized sequence whose element order is arbitrary (std::unordered_set and friends).
+  // Dataformats with a canonical form may reorder its elements,
+  // the default implementation calls serialize_seq_begin_sized().
+  virtual void serialize_seq_begin_unordered(size_t len) { serialize_seq_begin_sized(len); }
+
+  // Sequence of scalars ///////////////////////////////////////////////////////
+  // Serialize a whole contiguous block of scalars as a sequence in one call.
+  // std containers with contiguous builtin elements (vector, array, ...) use these.
+  // The default implementation serializes element by element, dataformats
+  // should override them for bulk copying/formatting of the whole block.
+  virtual void serialize_seq_bool(const bool* vals, size_t len) { serialize_seq_each(vals, len, &Serializer::serialize_bool); }
+  virtual void serialize_seq_i8(const int8_t* vals, size_t len) { serialize_seq_each(vals, len, &Serializer::serialize_i8); }
+  virtual void serialize_seq_u8(const uint8_t* vals, size_t len) { serialize_seq_each(vals, len, &Serializer::serialize_u8); }
+  virtual void serialize_seq_i16(const int16_t* vals, size_t len) { serialize_seq_each(vals, len, &Serializer::serialize_i16); }
+  virtual void serialize_seq_u16(const uint16_t* vals, size_t len) { serialize_seq_each(vals, len, &Serializer::serialize_u16); }
+  virtual void serialize_seq_i32(const int32_t* vals, size_t len) { serialize_seq_each(vals, len, &Serializer::serialize_i32); }
+  virtual void serialize_seq_u32(const uint32_t* vals, size_t len) { serialize_seq_each(vals, len, &Serializer::serialize_u32); }
+  virtual void serialize_seq_i64(const int64_t* vals, size_t len) { serialize_seq_each(vals, len, &Serializer::serialize_i64); }
+  virtual void serialize_seq_u64(const uint64_t* vals, size_t len) { serialize_seq_each(vals, len, &Serializer::serialize_u64); }
+  virtual void serialize_seq_float(const float* vals, size_t len) { serialize_seq_each(vals, len, &Serializer::serialize_float); }
+  virtual void serialize_seq_double(const double* vals, size_t len) { serialize_seq_each(vals, len, &Serializer::serialize_double); }
+  virtual void serialize_seq_char(const char* vals, size_t len) { serialize_seq_each(vals, len, &Serializer::serialize_char); }
+  virtual void serialize_seq_uchar(const unsigned char* vals, size_t len) { serialize_seq_each(vals, len, &Serializer::serialize_uchar); }
 
   // Map ///////////////////////////////////////////////////////////////////////
   virtual void serialize_map_begin() = 0;
   virtual void serialize_map_end() = 0;
+  // Begin a map announcing its number of entries up front, see serialize_seq_begin_sized()
+  virtual void serialize_map_begin_sized(size_t len) { serialize_map_begin(); }
+  // Begin a sized map whose entry order is arbitrary (std::unordered_map and friends),
+  // see serialize_seq_begin_unordered()
+  virtual void serialize_map_begin_unordered(size_t len) { serialize_map_begin_sized(len); }
   virtual void serialize_map_key_begin() = 0;
   virtual void serialize_map_key_end() = 0;
   virtual void serialize_map_value_begin() = 0;
@@ -104,6 +143,15 @@ public:
 
   // Destructor
   virtual ~Serializer() = default;
+
+private:
+  template<typename T>
+  inline void serialize_seq_each(const T* vals, size_t len, void (Serializer::*serialize_one)(T)) {
+    serialize_seq_begin_sized(len);
+    for (size_t i = 0; i < len; i++)
+      (this->*serialize_one)(vals[i]);
+    serialize_seq_end();
+  }
 };
 
 } // namespace serde
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <type_traits>
+#include "serialize.h"
+#include "serializer.h"
+#include "builtin.h"
+#include "traits.h"
+
+namespace serde {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Statically dispatched Serializer
+///
+/// Dataformats may derive from StaticSerializer<Impl> (CRTP) instead of
+/// Serializer directly, where Impl is the `final` dataformat class.
+/// Serializing through an Impl& instantiates the type walk (builtin scalars,
+/// std types and serde_gen generated code) with the concrete Impl type,
+/// so every serializer method call is resolved at compile time and can be
+/// inlined into the walk instead of going through the Serializer vtable.
+///
+/// Impl is still a Serializer, so types implemented only for Serializer&
+/// keep working and are serialized through the virtual interface.
+template<typename Impl>
+class StaticSerializer : public Serializer {
+public:
+  template<typename T>
+  inline void serialize(const T& v) {
+    Impl& self = static_cast<Impl&>(*this);
+    if constexpr (traits::HasMemberSerialize<T, Impl>::value) v.serialize(self);
+    else if constexpr (traits::HasSerialize<T, Impl>::value) Serialize<T>::serialize(self, v);
+    else if constexpr (traits::IsBuiltinSerialize<T>::value) detail::serialize_builtin(self, v);
+    else if constexpr (std::is_same_v<std::remove_extent_t<T>, char>) self.serialize_str(v, detail::cstr_length(v, std::extent_v<T>));
+    else serde::serialize(self, v);
+  }
+
+  // Map ///////////////////////////////////////////////////////////////////////
+  template<typename K>
+  inline void serialize_map_key(const K& key) {
+    Impl& self = static_cast<Impl&>(*this);
+    self.serialize_map_key_begin();
+    self.serialize(key);
+    self.serialize_map_key_end();
+  }
+
+  template<typename V>
+  inline void serialize_map_value(const V& value) {
+    Impl& self = static_cast<Impl&>(*this);
+    self.serialize_map_value_begin();
+    self.serialize(value);
+    self.serialize_map_value_end();
+  }
+
+  template<typename K, typename V>
+  inline void serialize_map_entry(const K& key, const V& value) {
+    serialize_map_key(key);
+    serialize_map_value(value);
+  }
+
+  // Struct ////////////////////////////////////////////////////////////////////
+  template<typename V>
+  inline void serialize_struct_field(const char* name, const V& value) {
+    Impl& self = static_cast<Impl&>(*this);
+    self.serialize_struct_field_begin(name);
+    self.serialize(value);
+    self.serialize_struct_field_end();
+  }
+
+protected:
+  StaticSerializer() = default;
+};
+
+} // namespace serde
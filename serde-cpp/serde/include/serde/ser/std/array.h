@@ -3,17 +3,24 @@
 #include <array>
 #include "../serialize.h"
 #include "../serializer.h"
+#include "../builtin.h"
+#include "../traits.h"
 
 namespace serde {
 
 template<>
 struct SerializeTN<std::array> {
-  template<typename T, auto N>
-  static void serialize(Serializer& ser, const std::array<T, N>& arr) {
-    ser.serialize_seq_begin();
-    for (auto& e : arr)
-      ser.serialize(e);
-    ser.serialize_seq_end();
+  template<typename T, auto N, typename S>
+  static void serialize(S& ser, const std::array<T, N>& arr) {
+    if constexpr (traits::IsSeqBuiltinSerialize<T>::value) {
+      detail::serialize_seq_builtin(ser, arr.data(), arr.size());
+    }
+    else {
+      ser.serialize_seq_begin_sized(arr.size());
+      for (auto& e : arr)
+        ser.serialize(e);
+      ser.serialize_seq_end();
+    }
   }
 };
 
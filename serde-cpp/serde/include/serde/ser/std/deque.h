@@ -8,9 +8,9 @@ namespace serde {
 
 template<>
 struct SerializeT<std::deque> {
-  template<typename T, typename Alloc>
-  static void serialize(Serializer& ser, const std::deque<T, Alloc>& deque) {
-    ser.serialize_seq_begin();
+  template<typename T, typename Alloc, typename S>
+  static void serialize(S& ser, const std::deque<T, Alloc>& deque) {
+    ser.serialize_seq_begin_sized(deque.size());
     for (auto& e : deque)
       ser.serialize(e);
     ser.serialize_seq_end();
@@ -8,8 +8,8 @@ namespace serde {
 
 template<>
 struct SerializeT<std::forward_list> {
-  template<typename T, typename Alloc>
-  static void serialize(Serializer& ser, const std::forward_list<T, Alloc>& list) {
+  template<typename T, typename Alloc, typename S>
+  static void serialize(S& ser, const std::forward_list<T, Alloc>& list) {
     ser.serialize_seq_begin();
     for (auto& e : list)
       ser.serialize(e);
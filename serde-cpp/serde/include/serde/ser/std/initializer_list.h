@@ -3,17 +3,24 @@
 #include <initializer_list>
 #include "../serialize.h"
 #include "../serializer.h"
+#include "../builtin.h"
+#include "../traits.h"
 
 namespace serde {
 
 template<>
 struct SerializeT<std::initializer_list> {
-  template<typename T>
-  static void serialize(Serializer& ser, const std::initializer_list<T>& list) {
-    ser.serialize_seq_begin();
-    for (auto& e : list)
-      ser.serialize(e);
-    ser.serialize_seq_end();
+  template<typename T, typename S>
+  static void serialize(S& ser, const std::initializer_list<T>& list) {
+    if constexpr (traits::IsSeqBuiltinSerialize<T>::value) {
+      detail::serialize_seq_builtin(ser, list.begin(), list.size());
+    }
+    else {
+      ser.serialize_seq_begin_sized(list.size());
+      for (auto& e : list)
+        ser.serialize(e);
+      ser.serialize_seq_end();
+    }
   }
 };
 
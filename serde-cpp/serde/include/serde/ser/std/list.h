@@ -8,9 +8,9 @@ namespace serde {
 
 template<>
 struct SerializeT<std::list> {
-  template<typename T, typename Alloc>
-  static void serialize(Serializer& ser, const std::list<T, Alloc>& list) {
-    ser.serialize_seq_begin();
+  template<typename T, typename Alloc, typename S>
+  static void serialize(S& ser, const std::list<T, Alloc>& list) {
+    ser.serialize_seq_begin_sized(list.size());
     for (auto& e : list)
       ser.serialize(e);
     ser.serialize_seq_end();
@@ -8,9 +8,9 @@ namespace serde {
 
 template<>
 struct SerializeT<std::map> {
-  template<typename Key, typename Value, typename Cmp, typename Alloc>
-  static void serialize(Serializer& ser, const std::map<Key, Value, Cmp, Alloc>& map) {
-    ser.serialize_map_begin();
+  template<typename Key, typename Value, typename Cmp, typename Alloc, typename S>
+  static void serialize(S& ser, const std::map<Key, Value, Cmp, Alloc>& map) {
+    ser.serialize_map_begin_sized(map.size());
     for (auto& it : map)
       ser.serialize_map_entry(it.first, it.second);
     ser.serialize_map_end();
@@ -19,9 +19,9 @@ struct SerializeT<std::map> {
 
 template<>
 struct SerializeT<std::multimap> {
-  template<typename Key, typename Value, typename Cmp, typename Alloc>
-  static void serialize(Serializer& ser, const std::multimap<Key, Value, Cmp, Alloc>& multimap) {
-    ser.serialize_map_begin();
+  template<typename Key, typename Value, typename Cmp, typename Alloc, typename S>
+  static void serialize(S& ser, const std::multimap<Key, Value, Cmp, Alloc>& multimap) {
+    ser.serialize_map_begin_sized(multimap.size());
     for (auto& it : multimap)
       ser.serialize_map_entry(it.first, it.second);
     ser.serialize_map_end();
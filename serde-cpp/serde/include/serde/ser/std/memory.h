@@ -8,23 +8,29 @@ namespace serde {
 
 template<>
 struct SerializeT<std::unique_ptr> {
-  template<typename T, typename Deleter>
-  static void serialize(Serializer& ser, const std::unique_ptr<T, Deleter>& val) {
-    if (val)
+  template<typename T, typename Deleter, typename S>
+  static void serialize(S& ser, const std::unique_ptr<T, Deleter>& val) {
+    if (val) {
+      ser.serialize_some();
       ser.serialize(*val);
-    else
+    }
+    else {
       ser.serialize_none();
+    }
   }
 };
 
 template<>
 struct SerializeT<std::shared_ptr> {
-  template<typename T>
-  static void serialize(Serializer& ser, const std::shared_ptr<T>& val) {
-    if (val)
+  template<typename T, typename S>
+  static void serialize(S& ser, const std::shared_ptr<T>& val) {
+    if (val) {
+      ser.serialize_some();
       ser.serialize(*val);
-    else
+    }
+    else {
       ser.serialize_none();
+    }
   }
 };
 
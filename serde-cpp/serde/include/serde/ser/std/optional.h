@@ -8,12 +8,15 @@ namespace serde {
 
 template<>
 struct SerializeT<std::optional> {
-  template<typename T>
-  static void serialize(Serializer& ser, const std::optional<T>& opt) {
-    if (opt)
+  template<typename T, typename S>
+  static void serialize(S& ser, const std::optional<T>& opt) {
+    if (opt) {
+      ser.serialize_some();
       ser.serialize(*opt);
-    else
+    }
+    else {
       ser.serialize_none();
+    }
   }
 };
 
@@ -8,9 +8,9 @@ namespace serde {
 
 template<>
 struct SerializeT<std::set> {
-  template<typename Key, typename Cmp, typename Alloc>
-  static void serialize(Serializer& ser, const std::set<Key, Cmp, Alloc>& set) {
-    ser.serialize_seq_begin();
+  template<typename Key, typename Cmp, typename Alloc, typename S>
+  static void serialize(S& ser, const std::set<Key, Cmp, Alloc>& set) {
+    ser.serialize_seq_begin_sized(set.size());
     for (auto& e : set)
       ser.serialize(e);
     ser.serialize_seq_end();
@@ -19,9 +19,9 @@ struct SerializeT<std::set> {
 
 template<>
 struct SerializeT<std::multiset> {
-  template<typename Key, typename Cmp, typename Alloc>
-  static void serialize(Serializer& ser, const std::multiset<Key, Cmp, Alloc>& multiset) {
-    ser.serialize_seq_begin();
+  template<typename Key, typename Cmp, typename Alloc, typename S>
+  static void serialize(S& ser, const std::multiset<Key, Cmp, Alloc>& multiset) {
+    ser.serialize_seq_begin_sized(multiset.size());
     for (auto& e : multiset)
       ser.serialize(e);
     ser.serialize_seq_end();
@@ -8,10 +8,10 @@ namespace serde {
 
 template<>
 struct SerializeT<std::basic_string_view> {
-  template<typename CharT, typename Traits>
-  static void serialize(Serializer& ser, const std::basic_string_view<CharT, Traits>& str) {
+  template<typename CharT, typename Traits, typename S>
+  static void serialize(S& ser, const std::basic_string_view<CharT, Traits>& str) {
     static_assert(std::is_same_v<CharT, char>, "serialize only supports char-based std::string_view");
-    ser.serialize_cstr(str.data());
+    ser.serialize_str(str.data(), str.size());
   }
 };
 
@@ -8,9 +8,9 @@ namespace serde {
 
 template<>
 struct SerializeT<std::tuple> {
-  template<typename... Ts>
-  static void serialize(Serializer& ser, const std::tuple<Ts...>& tuple) {
-    ser.serialize_seq_begin();
+  template<typename... Ts, typename S>
+  static void serialize(S& ser, const std::tuple<Ts...>& tuple) {
+    ser.serialize_seq_begin_sized(sizeof...(Ts));
     std::apply([&ser] (auto&... args) {
       (ser.serialize(args), ...);
     }, tuple);
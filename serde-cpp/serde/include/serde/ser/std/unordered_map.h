@@ -8,9 +8,9 @@ namespace serde {
 
 template<>
 struct SerializeT<std::unordered_map> {
-  template<typename Key, typename Value, typename... U>
-  static void serialize(Serializer& ser, const std::unordered_map<Key, Value, U...>& map) {
-    ser.serialize_map_begin();
+  template<typename Key, typename Value, typename... U, typename S>
+  static void serialize(S& ser, const std::unordered_map<Key, Value, U...>& map) {
+    ser.serialize_map_begin_unordered(map.size());
     for (auto& it : map)
       ser.serialize_map_entry(it.first, it.second);
     ser.serialize_map_end();
@@ -19,9 +19,9 @@ struct SerializeT<std::unordered_map> {
 
 template<>
 struct SerializeT<std::unordered_multimap> {
-  template<typename Key, typename Value, typename... U>
-  static void serialize(Serializer& ser, const std::unordered_multimap<Key, Value, U...>& multimap) {
-    ser.serialize_map_begin();
+  template<typename Key, typename Value, typename... U, typename S>
+  static void serialize(S& ser, const std::unordered_multimap<Key, Value, U...>& multimap) {
+    ser.serialize_map_begin_unordered(multimap.size());
     for (auto& it : multimap)
       ser.serialize_map_entry(it.first, it.second);
     ser.serialize_map_end();
@@ -8,9 +8,9 @@ namespace serde {
 
 template<>
 struct SerializeT<std::unordered_set> {
-  template<typename Key, typename... U>
-  static void serialize(Serializer& ser, const std::unordered_set<Key, U...>& set) {
-    ser.serialize_seq_begin();
+  template<typename Key, typename... U, typename S>
+  static void serialize(S& ser, const std::unordered_set<Key, U...>& set) {
+    ser.serialize_seq_begin_unordered(set.size());
     for (auto& e : set)
       ser.serialize(e);
     ser.serialize_seq_end();
@@ -19,9 +19,9 @@ struct SerializeT<std::unordered_set> {
 
 template<>
 struct SerializeT<std::unordered_multiset> {
-  template<typename Key, typename... U>
-  static void serialize(Serializer& ser, const std::unordered_multiset<Key, U...>& multiset) {
-    ser.serialize_seq_begin();
+  template<typename Key, typename... U, typename S>
+  static void serialize(S& ser, const std::unordered_multiset<Key, U...>& multiset) {
+    ser.serialize_seq_begin_unordered(multiset.size());
     for (auto& e : multiset)
       ser.serialize(e);
     ser.serialize_seq_end();
@@ -8,8 +8,8 @@ namespace serde {
 
 template<>
 struct SerializeT<std::pair> {
-  template<typename T1, typename T2>
-  static void serialize(Serializer& ser, const std::pair<T1, T2>& pair) {
+  template<typename T1, typename T2, typename S>
+  static void serialize(S& ser, const std::pair<T1, T2>& pair) {
     ser.serialize_struct_begin();
     ser.serialize_struct_field("first", pair.first);
     ser.serialize_struct_field("second", pair.second);
@@ -8,10 +8,10 @@ namespace serde {
 
 template<>
 struct SerializeT<std::variant> {
-  template<typename... Ts>
-  static void serialize(Serializer& ser, const std::variant<Ts...>& variant) {
+  template<typename... Ts, typename S>
+  static void serialize(S& ser, const std::variant<Ts...>& variant) {
     size_t index = variant.index();
-    ser.serialize_map_begin();
+    ser.serialize_map_begin_sized(1);
     ser.serialize_map_key(index);
     std::visit([&](const auto& val) {
       ser.serialize_map_value(val);
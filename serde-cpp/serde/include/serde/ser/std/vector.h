@@ -3,17 +3,25 @@
 #include <vector>
 #include "../serialize.h"
 #include "../serializer.h"
+#include "../builtin.h"
+#include "../traits.h"
 
 namespace serde {
 
 template<>
 struct SerializeT<std::vector> {
-  template<typename T, typename Alloc>
-  static void serialize(Serializer& ser, const std::vector<T, Alloc>& vec) {
-    ser.serialize_seq_begin();
-    for (auto& e : vec)
-      ser.serialize(e);
-    ser.serialize_seq_end();
+  template<typename T, typename Alloc, typename S>
+  static void serialize(S& ser, const std::vector<T, Alloc>& vec) {
+    // std::vector<bool> is not contiguous
+    if constexpr (traits::IsSeqBuiltinSerialize<T>::value && !std::is_same_v<T, bool>) {
+      detail::serialize_seq_builtin(ser, vec.data(), vec.size());
+    }
+    else {
+      ser.serialize_seq_begin_sized(vec.size());
+      for (auto& e : vec)
+        ser.serialize(e);
+      ser.serialize_seq_end();
+    }
   }
 };
 
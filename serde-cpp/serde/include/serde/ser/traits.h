@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <type_traits>
+#include <utility>
 
 ////////////////////////////////////////////////////////////////////////////////
 // Foward-declarations
@@ -18,21 +20,43 @@ struct Serialize;
 // Type Traits
 namespace serde::traits {
 
-// Trait for detecting whether T has serialize(Serializer&) member function
-template<typename T, typename = void>
+// Trait for detecting whether T has serialize(S&) member function,
+// where S is serde::Serializer or a concrete serializer type
+template<typename T, typename S = Serializer, typename = void>
 struct HasMemberSerialize : public std::false_type {};
 
-template<typename T>
-struct HasMemberSerialize<T, std::enable_if_t<std::is_invocable_r_v<void, decltype(&T::serialize), const T&, Serializer&>>>
+template<typename T, typename S>
+struct HasMemberSerialize<T, S, std::void_t<decltype(std::declval<const T&>().serialize(std::declval<S&>()))>>
 : public std::true_type {};
 
 
-// Trait for detecting whether T has Serialize<T, void>::serialize static function
-template<typename T, typename = void>
+// Trait for detecting whether T has Serialize<T, void>::serialize(S&, const T&) static function,
+// where S is serde::Serializer or a concrete serializer type
+template<typename T, typename S = Serializer, typename = void>
 struct HasSerialize : public std::false_type {};
 
-template<typename T>
-struct HasSerialize<T, std::enable_if_t<std::is_invocable_r_v<void, decltype(&Serialize<T, void>::serialize), Serializer&, const T&>>>
+template<typename T, typename S>
+struct HasSerialize<T, S, std::void_t<decltype(Serialize<T, void>::serialize(std::declval<S&>(), std::declval<const T&>()))>>
 : public std::true_type {};
 
+
+// Trait for detecting whether S is a concrete serializer type and not the serde::Serializer interface
+template<typename S>
+struct IsConcreteSerializer : public std::bool_constant<!std::is_same_v<std::remove_cv_t<S>, Serializer>> {};
+
+
+// Trait for detecting builtin scalar types which are serialized straight through Serializer methods
+template<typename T>
+struct IsBuiltinSerialize : public std::bool_constant<
+  std::is_arithmetic_v<T> || std::is_same_v<T, char*> || std::is_same_v<T, const char*>> {};
+
+
+// Trait for detecting builtin scalar types which have a Serializer call for
+// serializing a contiguous sequence of them at once (serialize_seq_*)
+template<typename T>
+struct IsSeqBuiltinSerialize : public std::bool_constant<
+  std::is_same_v<T, bool> || std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char> ||
+  std::is_same_v<T, int16_t> || std::is_same_v<T, uint16_t> || std::is_same_v<T, int32_t> || std::is_same_v<T, uint32_t> ||
+  std::is_same_v<T, int64_t> || std::is_same_v<T, uint64_t> || std::is_same_v<T, float> || std::is_same_v<T, double>> {};
+
 } // namespace serde::traits
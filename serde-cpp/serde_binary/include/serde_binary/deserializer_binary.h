@@ -0,0 +1,379 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <serde/de.h>
+#include <serde/error.h>
+#include <serde/result.hpp>
+
+#include "detail/varint.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Serde Binary
+////////////////////////////////////////////////////////////////////////////////
+namespace serde_binary {
+
+/// Binary Deserializer
+///
+/// Reads the encoding written by BinarySerializer straight from the input bytes,
+/// there is no intermediate tree: every Deserializer call consumes the next value.
+/// The type being deserialized must match the serialized one field for field.
+///
+/// The input is borrowed, not copied, it must outlive the deserializer and
+/// any strings borrowed from it (deserialize_str).
+///
+/// Errors have no line, their column is the byte offset in the input (1-based)
+/// where the offending value starts.
+class BinaryDeserializer final : public serde::StaticDeserializer<BinaryDeserializer> {
+public:
+  BinaryDeserializer() = default;
+
+  BinaryDeserializer(const void* data, size_t len) { reset(data, len); }
+
+  /// Deserialize another input, dropping the error
+  void reset(const void* data, size_t len) {
+    first = static_cast<const uint8_t*>(data);
+    pos = first;
+    last = first + len;
+    has_length = false;
+    clear_error();
+  }
+
+  /// Bytes not consumed yet
+  size_t remaining() const { return static_cast<size_t>(last - pos); }
+
+  /// Set an error if the deserialized value didn't consume the whole input
+  void expect_end() {
+    if (!has_error() && pos != last)
+      fail_at(pos, "trailing bytes after value");
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Deserializer interface
+  //////////////////////////////////////////////////////////////////////////////
+
+  // Scalars ///////////////////////////////////////////////////////////////////
+  void deserialize_bool(bool& val) final {
+    uint8_t byte = 0;
+    if (!read_byte(byte)) return;
+    if (byte > 1)
+      return fail_at(pos - 1, "invalid bool");
+    val = byte;
+  }
+  void deserialize_i8(int8_t& val) final { read_raw(val); }
+  void deserialize_u8(uint8_t& val) final { read_raw(val); }
+  void deserialize_i16(int16_t& val) final { read_int(val); }
+  void deserialize_u16(uint16_t& val) final { read_int(val); }
+  void deserialize_i32(int32_t& val) final { read_int(val); }
+  void deserialize_u32(uint32_t& val) final { read_int(val); }
+  void deserialize_i64(int64_t& val) final { read_int(val); }
+  void deserialize_u64(uint64_t& val) final { read_int(val); }
+  void deserialize_float(float& val) final { read_float(val); }
+  void deserialize_double(double& val) final { read_float(val); }
+  void deserialize_char(char& val) final { read_raw(val); }
+  void deserialize_uchar(unsigned char& val) final { read_raw(val); }
+
+  void deserialize_cstr(char* val, size_t len) final {
+    size_t n = 0;
+    if (!take_length(n)) return;
+    const size_t copy = len ? std::min(n, len - 1) : 0;
+    std::memcpy(val, pos, copy);
+    if (len)
+      val[copy] = '\0';
+    pos += n;
+  }
+
+  void deserialize_str(const char*& val, size_t& len) final {
+    size_t n = 0;
+    if (!take_length(n)) return;
+    val = reinterpret_cast<const char*>(pos);
+    len = n;
+    pos += n;
+  }
+
+  void deserialize_bytes(void* val, size_t len) final {
+    const uint8_t* start = pos;
+    size_t n = 0;
+    if (!take_length(n)) return;
+    if (n > len)
+      return fail_at(start, "bytes exceed the destination");
+    if (n)
+      std::memcpy(val, pos, n);
+    pos += n;
+  }
+
+  // The length is kept for the deserialize_cstr() that follows
+  void deserialize_length(size_t& len) final { peek_length(len); }
+
+  // Optional //////////////////////////////////////////////////////////////////
+  void deserialize_is_some(bool& val) final {
+    uint8_t tag = 0;
+    if (!read_byte(tag)) return;
+    if (tag > 1)
+      return fail_at(pos - 1, "invalid optional tag");
+    val = tag;
+  }
+  void deserialize_none() final {}
+
+  // Sequence //////////////////////////////////////////////////////////////////
+  void deserialize_seq_begin() final { size_t n; take_length(n); }
+  // The size is kept for the deserialize_seq_begin() or deserialize_seq_X() that follows
+  void deserialize_seq_size(size_t& size) final { peek_length(size); }
+  void deserialize_seq_end() final {}
+
+  // Sequence of scalars ///////////////////////////////////////////////////////
+  void deserialize_seq_bool(bool* vals, size_t len) final {
+    if (!take_seq_length(len, 1)) return;
+    for (size_t i = 0; i < len; i++) {
+      if (pos[i] > 1)
+        return fail_at(pos + i, "invalid bool");
+      vals[i] = pos[i];
+    }
+    pos += len;
+  }
+  void deserialize_seq_i8(int8_t* vals, size_t len) final { read_seq_raw(vals, len); }
+  void deserialize_seq_u8(uint8_t* vals, size_t len) final { read_seq_raw(vals, len); }
+  void deserialize_seq_i16(int16_t* vals, size_t len) final { read_seq_ints(vals, len); }
+  void deserialize_seq_u16(uint16_t* vals, size_t len) final { read_seq_ints(vals, len); }
+  void deserialize_seq_i32(int32_t* vals, size_t len) final { read_seq_ints(vals, len); }
+  void deserialize_seq_u32(uint32_t* vals, size_t len) final { read_seq_ints(vals, len); }
+  void deserialize_seq_i64(int64_t* vals, size_t len) final { read_seq_ints(vals, len); }
+  void deserialize_seq_u64(uint64_t* vals, size_t len) final { read_seq_ints(vals, len); }
+  void deserialize_seq_float(float* vals, size_t len) final { read_seq_floats(vals, len); }
+  void deserialize_seq_double(double* vals, size_t len) final { read_seq_floats(vals, len); }
+  void deserialize_seq_char(char* vals, size_t len) final { read_seq_raw(vals, len); }
+  void deserialize_seq_uchar(unsigned char* vals, size_t len) final { read_seq_raw(vals, len); }
+
+  // Map ///////////////////////////////////////////////////////////////////////
+  void deserialize_map_begin() final { size_t n; take_length(n); }
+  // The size is kept for the deserialize_map_begin() that follows
+  void deserialize_map_size(size_t& size) final { peek_length(size); }
+  void deserialize_map_end() final {}
+  void deserialize_map_key_begin() final {}
+  void deserialize_map_key_end() final {}
+  // Keys are positional, the next key must be the given one
+  void deserialize_map_key_find(const char* key) final {
+    const uint8_t* start = pos;
+    size_t n = 0;
+    if (!take_length(n)) return;
+    if (n != std::strlen(key) || std::memcmp(pos, key, n) != 0)
+      return fail_at(start, std::string("key not found in map: ").append(key));
+    pos += n;
+  }
+  void deserialize_map_value_begin() final {}
+  void deserialize_map_value_end() final {}
+
+  // Struct ////////////////////////////////////////////////////////////////////
+  void deserialize_struct_begin() final {}
+  void deserialize_struct_end() final {}
+  void deserialize_struct_field_begin(const char* name) final {}
+  void deserialize_struct_field_end() final {}
+
+private:
+  //////////////////////////////////////////////////////////////////////////////
+  // Deserialization Utils
+  //////////////////////////////////////////////////////////////////////////////
+
+  void fail_at(const uint8_t* at, std::string text) {
+    const auto column = static_cast<size_t>(at - first) + 1;
+    set_error({serde::Error::Kind::Invalid, 0, column, std::move(text)});
+  }
+
+  void fail_eof() { fail_at(pos, "unexpected end of input"); }
+
+  bool read_byte(uint8_t& byte) {
+    if (has_error()) return false;
+    if (pos == last) {
+      fail_eof();
+      return false;
+    }
+    byte = *pos++;
+    return true;
+  }
+
+  template<typename T>
+  void read_raw(T& val) {
+    static_assert(sizeof(T) == 1);
+    uint8_t byte = 0;
+    if (read_byte(byte))
+      val = static_cast<T>(byte);
+  }
+
+  bool read_varint(uint64_t& v) {
+    if (has_error()) return false;
+    const uint8_t* end = detail::read_varint(pos, last, v);
+    if (!end) {
+      if (last - pos < static_cast<ptrdiff_t>(detail::varint_max_size) && std::none_of(pos, last, [](uint8_t b) { return b < 0x80; }))
+        fail_eof();
+      else
+        fail_at(pos, "invalid varint");
+      return false;
+    }
+    pos = end;
+    return true;
+  }
+
+  template<typename T>
+  void read_int(T& val) {
+    const uint8_t* start = pos;
+    uint64_t v = 0;
+    if (!read_varint(v)) return;
+    if (!decode_int(v, val))
+      fail_at(start, "number out of range");
+  }
+
+  template<typename T>
+  static bool decode_int(uint64_t v, T& val) {
+    if constexpr (std::is_signed_v<T>) {
+      const int64_t s = detail::zigzag_decode(v);
+      if (s < std::numeric_limits<T>::min() || s > std::numeric_limits<T>::max())
+        return false;
+      val = static_cast<T>(s);
+    }
+    else {
+      if (v > std::numeric_limits<T>::max())
+        return false;
+      val = static_cast<T>(v);
+    }
+    return true;
+  }
+
+  template<typename T>
+  void read_float(T& val) {
+    if (has_error()) return;
+    if (remaining() < sizeof(T))
+      return fail_eof();
+    val = detail::read_float<T>(pos);
+    pos += sizeof(T);
+  }
+
+  // Read a length, checked against the remaining input so a corrupt length
+  // fails here instead of resizing a container to it
+  bool read_length(size_t& len) {
+    const uint8_t* start = pos;
+    uint64_t v = 0;
+    if (!read_varint(v)) return false;
+    if (v > remaining()) {
+      fail_at(start, "length exceeds input");
+      return false;
+    }
+    len = static_cast<size_t>(v);
+    return true;
+  }
+
+  // Read the length of the next value and keep it pending for take_length()
+  void peek_length(size_t& len) {
+    if (has_error()) return;
+    if (!has_length) {
+      if (!read_length(length)) return;
+      has_length = true;
+    }
+    len = length;
+  }
+
+  // The pending length read by peek_length(), or the next one from the input
+  bool take_length(size_t& len) {
+    if (has_error()) return false;
+    if (has_length) {
+      has_length = false;
+      len = length;
+      return true;
+    }
+    return read_length(len);
+  }
+
+  // Length of a sequence of len scalars of at least min_size bytes each
+  bool take_seq_length(size_t len, size_t min_size) {
+    const uint8_t* start = pos;
+    size_t n = 0;
+    if (!take_length(n)) return false;
+    if (n != len) {
+      fail_at(start, "sequence length mismatch");
+      return false;
+    }
+    if (len > remaining() / min_size) {
+      fail_eof();
+      return false;
+    }
+    return true;
+  }
+
+  template<typename T>
+  void read_seq_raw(T* vals, size_t len) {
+    static_assert(sizeof(T) == 1);
+    if (!take_seq_length(len, 1)) return;
+    if (len)
+      std::memcpy(vals, pos, len);
+    pos += len;
+  }
+
+  template<typename T>
+  void read_seq_ints(T* vals, size_t len) {
+    if (!take_seq_length(len, 1)) return;
+    for (size_t i = 0; i < len; i++) {
+      uint64_t v;
+      const uint8_t* end;
+      // inline single byte fast path, the common case for small values
+      if (pos != last && *pos < 0x80) {
+        v = *pos;
+        end = pos + 1;
+      }
+      else if (!(end = detail::read_varint(pos, last, v))) {
+        read_varint(v); // sets the error
+        return;
+      }
+      if (!decode_int(v, vals[i]))
+        return fail_at(pos, "number out of range");
+      pos = end;
+    }
+  }
+
+  template<typename T>
+  void read_seq_floats(T* vals, size_t len) {
+    if (!take_seq_length(len, sizeof(T))) return;
+    if constexpr (detail::little_endian) {
+      if (len)
+        std::memcpy(vals, pos, len * sizeof(T));
+      pos += len * sizeof(T);
+    }
+    else {
+      for (size_t i = 0; i < len; i++, pos += sizeof(T))
+        vals[i] = detail::read_float<T>(pos);
+    }
+  }
+
+  const uint8_t* first = nullptr;
+  const uint8_t* pos = nullptr;
+  const uint8_t* last = nullptr;
+  size_t length = 0;       // pending length from deserialize_length/seq_size/map_size
+  bool has_length = false;
+};
+
+/// Binary Deserializer function from bytes to T, statically dispatched.
+/// Same as from_bytes(), with the deserializer calls resolved at compile time.
+template<typename T>
+auto from_bytes_static(const void* data, size_t len) -> cpp::result<T, serde::Error>
+{
+  BinaryDeserializer de(data, len);
+  T obj{};
+  de.deserialize(obj);
+  de.expect_end();
+  if (de.has_error())
+    return cpp::fail(de.error());
+  return std::move(obj);
+}
+
+/// Binary Deserializer function from a byte vector to T, statically dispatched
+template<typename T>
+auto from_bytes_static(const std::vector<uint8_t>& bytes) -> cpp::result<T, serde::Error>
+{
+  return from_bytes_static<T>(bytes.data(), bytes.size());
+}
+
+} // namespace serde_binary
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <serde/ser/serializer.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// Serde Binary detail
+///////////////////////////////////////////////////////////////////////////////
+namespace serde_binary::detail {
+
+// Serializer appending to out
+auto SerializerNew(std::vector<uint8_t>& out) -> std::unique_ptr<serde::Serializer>;
+
+} // namespace serde_binary::detail
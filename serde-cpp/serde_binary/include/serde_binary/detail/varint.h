@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+///////////////////////////////////////////////////////////////////////////////
+// Serde Binary detail
+///////////////////////////////////////////////////////////////////////////////
+namespace serde_binary::detail {
+
+/// Maximum number of bytes of a 64-bit varint
+inline constexpr size_t varint_max_size = 10;
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+inline constexpr bool little_endian = true;
+#else
+inline constexpr bool little_endian = false;
+#endif
+
+/// Write v as a LEB128 varint: 7 bits per byte, least significant first,
+/// the high bit set on all the bytes but the last. Returns the end of the written bytes.
+inline uint8_t* write_varint(uint8_t* out, uint64_t v) {
+  while (v >= 0x80) {
+    *out++ = static_cast<uint8_t>(v | 0x80);
+    v >>= 7;
+  }
+  *out++ = static_cast<uint8_t>(v);
+  return out;
+}
+
+/// Write v as a varint padded to exactly varint_max_size bytes, for lengths patched in afterwards.
+/// Padded varints decode as the plain ones.
+inline void write_varint_padded(uint8_t* out, uint64_t v) {
+  for (size_t i = 0; i < varint_max_size - 1; i++) {
+    out[i] = static_cast<uint8_t>(v | 0x80);
+    v >>= 7;
+  }
+  out[varint_max_size - 1] = static_cast<uint8_t>(v);
+}
+
+/// Read a varint from [first, last) into v.
+/// Returns the end of the varint, or nullptr if it is truncated or overflows 64 bits.
+inline const uint8_t* read_varint(const uint8_t* first, const uint8_t* last, uint64_t& v) {
+  // fast path for the common single byte values
+  if (first != last && *first < 0x80) {
+    v = *first;
+    return first + 1;
+  }
+  uint64_t result = 0;
+  for (unsigned shift = 0; first != last && shift < 64; shift += 7) {
+    const uint8_t byte = *first++;
+    if (shift == 63 && byte > 1)
+      return nullptr;
+    result |= uint64_t(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      v = result;
+      return first;
+    }
+  }
+  return nullptr;
+}
+
+/// Map signed integers to unsigned ones so small magnitudes get small varints: 0, -1, 1, -2 -> 0, 1, 2, 3
+template<typename T>
+inline uint64_t zigzag_encode(T v) {
+  const int64_t s = v;
+  return (static_cast<uint64_t>(s) << 1) ^ static_cast<uint64_t>(s >> 63);
+}
+
+inline int64_t zigzag_decode(uint64_t v) {
+  return static_cast<int64_t>((v >> 1) ^ (~(v & 1) + 1));
+}
+
+/// Write the IEEE 754 bits of v in little-endian order
+template<typename T>
+inline uint8_t* write_float(uint8_t* out, T v) {
+  using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+  Bits bits;
+  std::memcpy(&bits, &v, sizeof(bits));
+  for (size_t i = 0; i < sizeof(bits); i++)
+    out[i] = static_cast<uint8_t>(bits >> (8 * i));
+  return out + sizeof(bits);
+}
+
+template<typename T>
+inline T read_float(const uint8_t* in) {
+  using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+  Bits bits = 0;
+  for (size_t i = 0; i < sizeof(bits); i++)
+    bits |= Bits(in[i]) << (8 * i);
+  T v;
+  std::memcpy(&v, &bits, sizeof(v));
+  return v;
+}
+
+} // namespace serde_binary::detail
@@ -0,0 +1,5 @@
+#pragma once
+
+// include serialization and deserialization
+#include "ser_binary.h"
+#include "de_binary.h"
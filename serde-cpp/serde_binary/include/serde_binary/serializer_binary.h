@@ -0,0 +1,276 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <serde/ser.h>
+#include <serde/error.h>
+#include <serde/result.hpp>
+
+#include "detail/varint.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Serde Binary
+////////////////////////////////////////////////////////////////////////////////
+namespace serde_binary {
+
+/// Binary Serializer
+///
+/// Writes a compact positional binary encoding, not self-describing: the reader
+/// must deserialize the same types in the same order. There are no field names
+/// nor type tags, struct fields are written in the order they are serialized
+/// (the declaration order for serde_gen generated code).
+///
+///   bool, char, i8, u8       1 byte
+///   u16, u32, u64            varint (LEB128)
+///   i16, i32, i64            zigzag varint
+///   float, double            4/8 bytes IEEE 754, little-endian
+///   str, bytes               varint length + bytes
+///   none / some              1 byte 0 / 1 + the value
+///   seq                      varint number of elements + elements
+///   map                      varint number of entries + key, value, key, value...
+///   struct                   fields, in order
+///
+/// Sequences and maps of unknown size (serialize_seq_begin) get a varint padded
+/// to 10 bytes, filled in when they end.
+///
+/// The output vector is owned by the caller and is appended to, so it can be
+/// reused (cleared) across messages to avoid allocating once warmed up.
+class BinarySerializer final : public serde::StaticSerializer<BinarySerializer> {
+public:
+  explicit BinarySerializer(std::vector<uint8_t>& out) : out(&out) {}
+
+  /// Serialize a new value, keeping the allocated capacity.
+  /// Anything already written to the output vector is left there.
+  void reset() {
+    frames.clear();
+    some = false;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Serializer interface
+  //////////////////////////////////////////////////////////////////////////////
+
+  // Scalars ///////////////////////////////////////////////////////////////////
+  void serialize_bool(bool v) final { write_byte(v ? 1 : 0); }
+  void serialize_i8(int8_t v) final { write_byte(static_cast<uint8_t>(v)); }
+  void serialize_u8(uint8_t v) final { write_byte(v); }
+  void serialize_i16(int16_t v) final { write_varint(detail::zigzag_encode(v)); }
+  void serialize_u16(uint16_t v) final { write_varint(v); }
+  void serialize_i32(int32_t v) final { write_varint(detail::zigzag_encode(v)); }
+  void serialize_u32(uint32_t v) final { write_varint(v); }
+  void serialize_i64(int64_t v) final { write_varint(detail::zigzag_encode(v)); }
+  void serialize_u64(uint64_t v) final { write_varint(v); }
+  void serialize_float(float v) final { write_float(v); }
+  void serialize_double(double v) final { write_float(v); }
+  void serialize_char(char v) final { write_byte(static_cast<uint8_t>(v)); }
+  void serialize_uchar(unsigned char v) final { write_byte(v); }
+  void serialize_str(const char* v, size_t len) final { write_block(v, len); }
+  void serialize_bytes(const void* val, size_t len) final { write_block(val, len); }
+
+  // Optional //////////////////////////////////////////////////////////////////
+  void serialize_none() final { write_byte(0); }
+  void serialize_some() final {
+    write_byte(1);
+    some = true; // the tag and the value count as a single value
+  }
+
+  // Sequence //////////////////////////////////////////////////////////////////
+  void serialize_seq_begin() final { container_begin(Kind::Seq); }
+  void serialize_seq_begin_sized(size_t len) final { container_begin_sized(Kind::Seq, len); }
+  void serialize_seq_end() final { container_end(); }
+
+  // Sequence of scalars ///////////////////////////////////////////////////////
+  void serialize_seq_bool(const bool* vals, size_t len) final {
+    value_begin();
+    put_varint(len);
+    for (size_t i = 0; i < len; i++)
+      out->push_back(vals[i] ? 1 : 0);
+  }
+  void serialize_seq_i8(const int8_t* vals, size_t len) final { serialize_seq_raw(vals, len); }
+  void serialize_seq_u8(const uint8_t* vals, size_t len) final { serialize_seq_raw(vals, len); }
+  void serialize_seq_i16(const int16_t* vals, size_t len) final { serialize_seq_varints(vals, len); }
+  void serialize_seq_u16(const uint16_t* vals, size_t len) final { serialize_seq_varints(vals, len); }
+  void serialize_seq_i32(const int32_t* vals, size_t len) final { serialize_seq_varints(vals, len); }
+  void serialize_seq_u32(const uint32_t* vals, size_t len) final { serialize_seq_varints(vals, len); }
+  void serialize_seq_i64(const int64_t* vals, size_t len) final { serialize_seq_varints(vals, len); }
+  void serialize_seq_u64(const uint64_t* vals, size_t len) final { serialize_seq_varints(vals, len); }
+  void serialize_seq_float(const float* vals, size_t len) final { serialize_seq_floats(vals, len); }
+  void serialize_seq_double(const double* vals, size_t len) final { serialize_seq_floats(vals, len); }
+  void serialize_seq_char(const char* vals, size_t len) final { serialize_seq_raw(vals, len); }
+  void serialize_seq_uchar(const unsigned char* vals, size_t len) final { serialize_seq_raw(vals, len); }
+
+  // Map ///////////////////////////////////////////////////////////////////////
+  void serialize_map_begin() final { container_begin(Kind::Map); }
+  void serialize_map_begin_sized(size_t len) final { container_begin_sized(Kind::Map, len); }
+  void serialize_map_end() final { container_end(); }
+
+  void serialize_map_key_begin() final {
+    if (!frames.empty() && frames.back().kind == Kind::Map)
+      frames.back().count++;
+  }
+  void serialize_map_key_end() final {}
+  void serialize_map_value_begin() final {}
+  void serialize_map_value_end() final {}
+
+  // Struct ////////////////////////////////////////////////////////////////////
+  void serialize_struct_begin() final {
+    value_begin();
+    if (!frames.empty())
+      frames.push_back(Frame{Kind::Struct, npos, 0});
+  }
+  void serialize_struct_end() final { container_end(); }
+  void serialize_struct_field_begin(const char* name) final {}
+  void serialize_struct_field_end() final {}
+
+private:
+  static constexpr size_t npos = size_t(-1);
+
+  enum class Kind : uint8_t { Seq, Map, Struct };
+
+  // Open containers, only tracked while a container of unknown size is open:
+  // its elements are counted to fill in its length when it ends.
+  struct Frame {
+    Kind kind;
+    size_t length_pos; // position of the padded length in the output, npos if written up front
+    size_t count;      // elements (entries for maps) written so far
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Serialization Utils
+  //////////////////////////////////////////////////////////////////////////////
+
+  // Count a new element of the enclosing sequence of unknown size, if any
+  void value_begin() {
+    if (some) { // consumed here even at top level, or it would skip the next count
+      some = false;
+      return;
+    }
+    if (frames.empty())
+      return;
+    Frame& top = frames.back();
+    if (top.kind == Kind::Seq)
+      top.count++;
+  }
+
+  void container_begin(Kind kind) {
+    value_begin();
+    frames.push_back(Frame{kind, out->size(), 0});
+    out->resize(out->size() + detail::varint_max_size);
+  }
+
+  void container_begin_sized(Kind kind, size_t len) {
+    value_begin();
+    put_varint(len);
+    if (!frames.empty())
+      frames.push_back(Frame{kind, npos, 0});
+  }
+
+  void container_end() {
+    if (frames.empty())
+      return;
+    const Frame& top = frames.back();
+    if (top.length_pos != npos)
+      detail::write_varint_padded(out->data() + top.length_pos, top.count);
+    frames.pop_back();
+  }
+
+  void write_byte(uint8_t v) {
+    value_begin();
+    out->push_back(v);
+  }
+
+  void write_varint(uint64_t v) {
+    value_begin();
+    put_varint(v);
+  }
+
+  template<typename T>
+  void write_float(T v) {
+    value_begin();
+    uint8_t buf[sizeof(T)];
+    detail::write_float(buf, v);
+    out->insert(out->end(), buf, buf + sizeof(buf));
+  }
+
+  void write_block(const void* val, size_t len) {
+    value_begin();
+    put_varint(len);
+    const auto* bytes = static_cast<const uint8_t*>(val);
+    out->insert(out->end(), bytes, bytes + len);
+  }
+
+  void put_varint(uint64_t v) {
+    uint8_t buf[detail::varint_max_size];
+    out->insert(out->end(), buf, detail::write_varint(buf, v));
+  }
+
+  template<typename T>
+  void serialize_seq_raw(const T* vals, size_t len) {
+    static_assert(sizeof(T) == 1);
+    write_block(vals, len);
+  }
+
+  template<typename T>
+  void serialize_seq_varints(const T* vals, size_t len) {
+    value_begin();
+    put_varint(len);
+    // reserve the worst case once, then write without checking the capacity per element
+    const size_t pos = out->size();
+    out->resize(pos + len * detail::varint_max_size);
+    uint8_t* p = out->data() + pos;
+    for (size_t i = 0; i < len; i++) {
+      if constexpr (std::is_signed_v<T>)
+        p = detail::write_varint(p, detail::zigzag_encode(vals[i]));
+      else
+        p = detail::write_varint(p, vals[i]);
+    }
+    out->resize(static_cast<size_t>(p - out->data()));
+  }
+
+  template<typename T>
+  void serialize_seq_floats(const T* vals, size_t len) {
+    value_begin();
+    put_varint(len);
+    const size_t pos = out->size();
+    out->resize(pos + len * sizeof(T));
+    if constexpr (detail::little_endian) {
+      if (len)
+        std::memcpy(out->data() + pos, vals, len * sizeof(T));
+    }
+    else {
+      uint8_t* p = out->data() + pos;
+      for (size_t i = 0; i < len; i++)
+        p = detail::write_float(p, vals[i]);
+    }
+  }
+
+  std::vector<uint8_t>* out;
+  std::vector<Frame> frames;
+  bool some = false;
+};
+
+/// Binary Serializer function from T to bytes, statically dispatched.
+/// Same output as to_bytes(), with the serializer calls resolved at compile time.
+template<typename T>
+auto to_bytes_static(T&& obj) -> cpp::result<std::vector<uint8_t>, serde::Error>
+{
+  std::vector<uint8_t> out;
+  BinarySerializer ser(out);
+  ser.serialize(std::forward<T>(obj));
+  return out;
+}
+
+/// Binary Serializer function from T to bytes appended to out, statically dispatched
+template<typename T>
+auto to_bytes_static(T&& obj, std::vector<uint8_t>& out) -> cpp::result<void, serde::Error>
+{
+  BinarySerializer ser(out);
+  ser.serialize(std::forward<T>(obj));
+  return {};
+}
+
+} // namespace serde_binary
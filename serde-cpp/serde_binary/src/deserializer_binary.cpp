@@ -0,0 +1,23 @@
+#include "serde_binary/de_binary.h"
+#include "serde_binary/deserializer_binary.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Serde Binary
+////////////////////////////////////////////////////////////////////////////////
+namespace serde_binary {
+
+namespace detail {
+
+auto DeserializerNew(const void* data, size_t len) -> std::unique_ptr<serde::Deserializer>
+{
+  return std::make_unique<BinaryDeserializer>(data, len);
+}
+
+void DeserializerExpectEnd(serde::Deserializer* de)
+{
+  static_cast<BinaryDeserializer*>(de)->expect_end();
+}
+
+} // namespace detail
+
+} // namespace serde_binary
@@ -0,0 +1,18 @@
+#include "serde_binary/ser_binary.h"
+#include "serde_binary/serializer_binary.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Serde Binary
+////////////////////////////////////////////////////////////////////////////////
+namespace serde_binary {
+
+namespace detail {
+
+auto SerializerNew(std::vector<uint8_t>& out) -> std::unique_ptr<serde::Serializer>
+{
+  return std::make_unique<BinarySerializer>(out);
+}
+
+} // namespace detail
+
+} // namespace serde_binary
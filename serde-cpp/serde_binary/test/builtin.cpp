@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+#include <cfloat>
+#include <cstdint>
+
+#include "serde/std.h"
+#include "serde/serde.h"
+#include "serde_binary/serde_binary.h"
+#include "serde_binary/serializer_binary.h"
+#include "serde_binary/deserializer_binary.h"
+
+using Bytes = std::vector<uint8_t>;
+
+///////////////////////////////////////////////////////////////////////////////
+// Scalars
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+static void roundtrip(T val, size_t size)
+{
+  auto bytes = serde_binary::to_bytes(val).value();
+  EXPECT_EQ(bytes.size(), size) << +val;
+  auto de_val = serde_binary::from_bytes<T>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Builtin, Int_Limits)
+{
+  roundtrip<int8_t>(INT8_MIN, 1);
+  roundtrip<uint8_t>(UINT8_MAX, 1);
+  roundtrip<int16_t>(INT16_MIN, 3);
+  roundtrip<uint16_t>(UINT16_MAX, 3);
+  roundtrip<int32_t>(-64, 1);
+  roundtrip<int32_t>(64, 2);
+  roundtrip<int32_t>(INT32_MIN, 5);
+  roundtrip<uint32_t>(UINT32_MAX, 5);
+  roundtrip<int64_t>(INT64_MIN, 10);
+  roundtrip<int64_t>(INT64_MAX, 10);
+  roundtrip<uint64_t>(0, 1);
+  roundtrip<uint64_t>(127, 1);
+  roundtrip<uint64_t>(128, 2);
+  roundtrip<uint64_t>(UINT64_MAX, 10);
+}
+
+TEST(Builtin, Float_Bits)
+{
+  roundtrip<float>(FLT_MIN, 4);
+  roundtrip<float>(-FLT_MAX, 4);
+  roundtrip<double>(DBL_TRUE_MIN, 8);
+  roundtrip<double>(0.1, 8);
+  auto bytes = serde_binary::to_bytes(1.0).value();
+  EXPECT_EQ(bytes, (Bytes{0, 0, 0, 0, 0, 0, 0xF0, 0x3F})); // little-endian
+}
+
+TEST(Builtin, Bool_Char)
+{
+  roundtrip<bool>(true, 1);
+  roundtrip<bool>(false, 1);
+  roundtrip<char>('\0', 1);
+  roundtrip<unsigned char>(0xFF, 1);
+}
+
+TEST(Builtin, Bytes)
+{
+  struct Blob {
+    uint8_t data[4];
+    void serialize(serde::Serializer& ser) const { ser.serialize_bytes(data, sizeof(data)); }
+    void deserialize(serde::Deserializer& de) { de.deserialize_bytes(data, sizeof(data)); }
+  };
+  const Blob val{{0xDE, 0xAD, 0xBE, 0xEF}};
+  auto bytes = serde_binary::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{4, 0xDE, 0xAD, 0xBE, 0xEF}));
+  auto de_val = serde_binary::from_bytes<Blob>(bytes).value();
+  EXPECT_EQ(std::memcmp(de_val.data, val.data, sizeof(val.data)), 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Struct
+///////////////////////////////////////////////////////////////////////////////
+
+struct Record {
+  std::string name;
+  int32_t id;
+  std::vector<float> values;
+  std::optional<std::string> note;
+
+  void serialize(serde::Serializer& ser) const {
+    ser.serialize_struct_begin();
+    ser.serialize_struct_field("name", name);
+    ser.serialize_struct_field("id", id);
+    ser.serialize_struct_field("values", values);
+    ser.serialize_struct_field("note", note);
+    ser.serialize_struct_end();
+  }
+  void deserialize(serde::Deserializer& de) {
+    de.deserialize_struct_begin();
+    de.deserialize_struct_field("name", name);
+    de.deserialize_struct_field("id", id);
+    de.deserialize_struct_field("values", values);
+    de.deserialize_struct_field("note", note);
+    de.deserialize_struct_end();
+  }
+  bool operator==(const Record& o) const {
+    return std::tie(name, id, values, note) == std::tie(o.name, o.id, o.values, o.note);
+  }
+};
+
+TEST(Builtin, Struct_Positional)
+{
+  const Record val{"ab", -2, {0.5f}, std::nullopt};
+  auto bytes = serde_binary::to_bytes(val).value();
+  // no field names: name, id, values, note
+  EXPECT_EQ(bytes, (Bytes{2, 'a', 'b', 3, 1, 0, 0, 0, 0x3F, 0}));
+  auto de_val = serde_binary::from_bytes<Record>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Builtin, Struct_InForwardList)
+{
+  const std::forward_list<Record> val = {{"a", 1, {}, "x"}, {"b", 2, {1.f, 2.f}, std::nullopt}};
+  auto bytes = serde_binary::to_bytes(val).value();
+  auto de_val = serde_binary::from_bytes<std::forward_list<Record>>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+struct OptionalThenList {
+  std::optional<int> a = 5;
+  std::forward_list<int> b = {1, 2, 3};
+
+  void serialize(serde::Serializer& ser) const {
+    ser.serialize_struct_begin();
+    ser.serialize_struct_field("a", a);
+    ser.serialize_struct_field("b", b);
+    ser.serialize_struct_end();
+  }
+  void deserialize(serde::Deserializer& de) {
+    de.deserialize_struct_begin();
+    de.deserialize_struct_field("a", a);
+    de.deserialize_struct_field("b", b);
+    de.deserialize_struct_end();
+  }
+};
+
+TEST(Builtin, Struct_OptionalThenForwardList)
+{
+  // the value of a top-level optional must not eat the first element count of the next list
+  const OptionalThenList val;
+  auto bytes = serde_binary::to_bytes(val).value();
+  ASSERT_GE(bytes.size(), 3u);
+  EXPECT_EQ(bytes[2] & 0x7F, 3); // count of b, not 2
+  auto de_val = serde_binary::from_bytes<OptionalThenList>(bytes).value();
+  EXPECT_EQ(de_val.a, val.a);
+  EXPECT_EQ(de_val.b, val.b);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Static dispatch
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Builtin, Static_SameBytes)
+{
+  const std::map<std::string, std::vector<Record>> val = {{"k", {{"n", 7, {1.f}, "note"}}}};
+  auto bytes = serde_binary::to_bytes(val).value();
+  auto static_bytes = serde_binary::to_bytes_static(val).value();
+  EXPECT_EQ(static_bytes, bytes);
+  auto de_val = serde_binary::from_bytes_static<std::map<std::string, std::vector<Record>>>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Builtin, Reuse_Output)
+{
+  std::vector<uint8_t> out;
+  serde_binary::to_bytes(uint32_t(300), out).value();
+  serde_binary::to_bytes(std::string("a"), out).value();
+  EXPECT_EQ(out, (Bytes{0xAC, 0x02, 1, 'a'}));
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include "serde/std.h"
+#include "serde/serde.h"
+#include "serde_binary/serde_binary.h"
+
+using Bytes = std::vector<uint8_t>;
+
+TEST(Errors, UnexpectedEnd)
+{
+  auto res = serde_binary::from_bytes<std::pair<int, std::string>>(Bytes{2, 5, 'a', 'b'});
+  ASSERT_TRUE(res.has_error());
+  EXPECT_EQ(res.error().text, "length exceeds input");
+  EXPECT_EQ(res.error().column, 2u);
+
+  auto res2 = serde_binary::from_bytes<double>(Bytes{0, 0, 0});
+  ASSERT_TRUE(res2.has_error());
+  EXPECT_EQ(res2.error().text, "unexpected end of input");
+
+  auto res3 = serde_binary::from_bytes<uint64_t>(Bytes{0x80, 0x80});
+  ASSERT_TRUE(res3.has_error());
+  EXPECT_EQ(res3.error().text, "unexpected end of input");
+}
+
+TEST(Errors, TrailingBytes)
+{
+  auto res = serde_binary::from_bytes<int>(Bytes{2, 4});
+  ASSERT_TRUE(res.has_error());
+  EXPECT_EQ(res.error().text, "trailing bytes after value");
+  EXPECT_EQ(res.error().column, 2u);
+}
+
+TEST(Errors, NumberOutOfRange)
+{
+  auto bytes = serde_binary::to_bytes(int32_t(200)).value();
+  auto res = serde_binary::from_bytes<int8_t>(bytes);
+  EXPECT_TRUE(res.has_error()); // int8_t is a raw byte, 200 is two bytes of varint
+  auto res16 = serde_binary::from_bytes<int16_t>(serde_binary::to_bytes(int32_t(40000)).value());
+  ASSERT_TRUE(res16.has_error());
+  EXPECT_EQ(res16.error().text, "number out of range");
+  auto res_seq = serde_binary::from_bytes<std::vector<uint16_t>>(serde_binary::to_bytes(std::vector<uint32_t>{1, 70000}).value());
+  ASSERT_TRUE(res_seq.has_error());
+  EXPECT_EQ(res_seq.error().text, "number out of range");
+}
+
+TEST(Errors, InvalidVarint)
+{
+  Bytes bytes(11, 0xFF);
+  auto res = serde_binary::from_bytes<uint64_t>(bytes);
+  ASSERT_TRUE(res.has_error());
+  EXPECT_EQ(res.error().text, "invalid varint");
+}
+
+TEST(Errors, InvalidTags)
+{
+  auto res = serde_binary::from_bytes<std::optional<int>>(Bytes{2, 0});
+  ASSERT_TRUE(res.has_error());
+  EXPECT_EQ(res.error().text, "invalid optional tag");
+  auto res_bool = serde_binary::from_bytes<bool>(Bytes{7});
+  ASSERT_TRUE(res_bool.has_error());
+  EXPECT_EQ(res_bool.error().text, "invalid bool");
+}
+
+TEST(Errors, ArrayLengthMismatch)
+{
+  auto bytes = serde_binary::to_bytes(std::array<int, 3>{1, 2, 3}).value();
+  auto res = serde_binary::from_bytes<std::array<int, 2>>(bytes);
+  ASSERT_TRUE(res.has_error());
+  EXPECT_EQ(res.error().text, "sequence length mismatch");
+}
+
+TEST(Errors, HugeLength)
+{
+  // a corrupt length must not resize the vector to it
+  auto res = serde_binary::from_bytes<std::vector<std::string>>(Bytes{0xFF, 0xFF, 0xFF, 0xFF, 0x0F});
+  ASSERT_TRUE(res.has_error());
+  EXPECT_EQ(res.error().text, "length exceeds input");
+}
+
+TEST(Errors, BorrowedBytesUnsupported)
+{
+  // serde_binary does not lend bytes from its input, the default reports it
+  struct Blob {
+    const void* data = nullptr;
+    size_t size = 0;
+    void deserialize(serde::Deserializer& de) { de.deserialize_bytes_borrowed(data, size); }
+  };
+  auto res = serde_binary::from_bytes<Blob>(Bytes{3, 'a', 'b', 'c'});
+  ASSERT_TRUE(res.has_error());
+  EXPECT_EQ(res.error().text, "borrowed bytes not supported");
+}
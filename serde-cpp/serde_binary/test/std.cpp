@@ -0,0 +1,542 @@
+#include <gtest/gtest.h>
+
+#include "serde/std.h"
+#include "serde/serde.h"
+#include "serde_binary/serde_binary.h"
+
+using Bytes = std::vector<uint8_t>;
+
+///////////////////////////////////////////////////////////////////////////////
+// std::string
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, String_Value)
+{
+  using Type = std::string;
+  const Type val = "Hello";
+  auto bytes = serde_binary::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{5, 'H', 'e', 'l', 'l', 'o'}));
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, String_Empty)
+{
+  using Type = std::string;
+  const Type val = {};
+  auto bytes = serde_binary::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0}));
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, String_EmbeddedNull)
+{
+  using Type = std::string;
+  const Type val("Hello\0World", 11);
+  auto bytes = serde_binary::to_bytes(val).value();
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, String_Long)
+{
+  using Type = std::string;
+  const Type val(300, 'x');
+  auto bytes = serde_binary::to_bytes(val).value();
+  EXPECT_EQ(bytes.size(), 302u); // two bytes varint length
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::string_view
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, StringView_Borrowed)
+{
+  using Type = std::map<std::string_view, std::vector<std::string_view>>;
+  const Type val = {{"first", {"a", "bb"}}, {"second", {"ccc"}}};
+  auto bytes = serde_binary::to_bytes(val).value();
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+  // the views point into the input bytes
+  const auto* data = reinterpret_cast<const char*>(bytes.data());
+  EXPECT_GE(de_val.at("second").at(0).data(), data);
+  EXPECT_LT(de_val.at("second").at(0).data(), data + bytes.size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::unique_ptr
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, UniquePtr_Value)
+{
+  using Type = std::unique_ptr<std::string>;
+  const Type val = std::make_unique<std::string>("Potatoes");
+  auto bytes = serde_binary::to_bytes(val).value();
+  EXPECT_EQ(bytes.front(), 1);
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(*de_val, *val);
+}
+
+TEST(Std, UniquePtr_Empty)
+{
+  using Type = std::unique_ptr<std::string>;
+  const Type val = {};
+  auto bytes = serde_binary::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0}));
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::shared_ptr
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, SharedPtr_Value)
+{
+  using Type = std::shared_ptr<std::string>;
+  const Type val = std::make_shared<std::string>("Bananas");
+  auto bytes = serde_binary::to_bytes(val).value();
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(*de_val, *val);
+}
+
+TEST(Std, SharedPtr_Empty)
+{
+  using Type = std::shared_ptr<std::string>;
+  const Type val = {};
+  auto bytes = serde_binary::to_bytes(val).value();
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::optional
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, Optional_Value)
+{
+  using Type = std::optional<int>;
+  const Type val = 10;
+  auto bytes = serde_binary::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{1, 20}));
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ((int)*val, (int)*de_val);
+}
+
+TEST(Std, Optional_Null)
+{
+  using Type = std::optional<int>;
+  const Type val = std::nullopt;
+  auto bytes = serde_binary::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0}));
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_FALSE(de_val.has_value());
+}
+
+TEST(Std, Optional_InForwardList)
+{
+  using Type = std::forward_list<std::optional<int>>;
+  const Type val = {1, std::nullopt, 3};
+  auto bytes = serde_binary::to_bytes(val).value();
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::array
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, Array_Value)
+{
+  using Type = std::array<size_t, 6>;
+  const Type val = {56, 333, 1, 3, 49, 100};
+  auto bytes = serde_binary::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{6, 56, 0xCD, 0x02, 1, 3, 49, 100}));
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Array_Empty)
+{
+  using Type = std::array<size_t, 0>;
+  const Type val = {};
+  auto bytes = serde_binary::to_bytes(val).value();
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::vector
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, Vector_Value)
+{
+  using Type = std::vector<size_t>;
+  const Type val = {56, 333, 1, 3, 49, 100};
+  auto bytes = serde_binary::to_bytes(val).value();
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Vector_Empty)
+{
+  using Type = std::vector<size_t>;
+  const Type val = {};
+  auto bytes = serde_binary::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0}));
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Vector_Signed)
+{
+  using Type = std::vector<int64_t>;
+  const Type val = {0, -1, 1, -64, INT64_MIN, INT64_MAX};
+  auto bytes = serde_binary::to_bytes(val).value();
+  EXPECT_EQ(Bytes(bytes.begin(), bytes.begin() + 5), (Bytes{6, 0, 1, 2, 127}));
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Vector_Double)
+{
+  using Type = std::vector<double>;
+  const Type val = {1.5, -2.25, 0.125, 0};
+  auto bytes = serde_binary::to_bytes(val).value();
+  EXPECT_EQ(bytes.size(), 1 + 4 * sizeof(double));
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Array_Bool)
+{
+  using Type = std::array<bool, 3>;
+  const Type val = {true, false, true};
+  auto bytes = serde_binary::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{3, 1, 0, 1}));
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Vector_Nested)
+{
+  using Type = std::vector<std::vector<int>>;
+  const Type val = {{1, 2}, {3}};
+  auto bytes = serde_binary::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{2, 2, 2, 4, 1, 6}));
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Vector_NestedInMap)
+{
+  using Type = std::map<std::string, std::vector<std::array<uint8_t, 2>>>;
+  const Type val = {{"a", {{1, 2}, {3, 4}}}, {"b", {}}};
+  auto bytes = serde_binary::to_bytes(val).value();
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::variant
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, Variant_Index0) {
+  using Type = std::variant<char, int, std::string>;
+  const Type val = 'c';
+  auto bytes = serde_binary::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{1, 0, 'c'}));
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Variant_Index1) {
+  using Type = std::variant<char, int, std::string>;
+  const Type val = 431;
+  auto bytes = serde_binary::to_bytes(val).value();
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Variant_Index2) {
+  using Type = std::variant<char, int, std::string>;
+  const Type val = "Hello World";
+  auto bytes = serde_binary::to_bytes(val).value();
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::tuple
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, Tuple_Value)
+{
+  using Type = std::tuple<char, int, std::string>;
+  const Type val = {'z', 3467, "MyTuple"};
+  auto bytes = serde_binary::to_bytes(val).value();
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::pair
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, Pair_Value)
+{
+  using Type = std::pair<int, std::string>;
+  const Type val = {69, "sixty-nine"};
+  auto bytes = serde_binary::to_bytes(val).value();
+  // fields are positional, no names
+  EXPECT_EQ(bytes.size(), 2 + 1 + 10u);
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::initializer_list
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, InitializerList_Value)
+{
+  using Type = std::initializer_list<std::string>;
+  const Type val = {"apple", "banana"};
+  auto bytes = serde_binary::to_bytes(val).value();
+  // deserializes as any other sequence
+  auto de_val = serde_binary::from_bytes<std::vector<std::string>>(bytes).value();
+  EXPECT_EQ(de_val, (std::vector<std::string>{"apple", "banana"}));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::list
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, List_Value)
+{
+  using Type = std::list<int>;
+  const Type val = {7, 9, 4, -1};
+  auto bytes = serde_binary::to_bytes(val).value();
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, List_Empty)
+{
+  using Type = std::list<int>;
+  const Type val = {};
+  auto bytes = serde_binary::to_bytes(val).value();
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::forward_list
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, ForwardList_Value)
+{
+  using Type = std::forward_list<int>;
+  const Type val = {7, 9, 4, -1};
+  auto bytes = serde_binary::to_bytes(val).value();
+  // unknown size up front, the length is a padded varint
+  EXPECT_EQ(bytes.size(), 10 + 4u);
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, ForwardList_Empty)
+{
+  using Type = std::forward_list<int>;
+  const Type val = {};
+  auto bytes = serde_binary::to_bytes(val).value();
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, ForwardList_Nested)
+{
+  using Type = std::forward_list<std::forward_list<std::string>>;
+  const Type val = {{"a", "b"}, {}, {"c"}};
+  auto bytes = serde_binary::to_bytes(val).value();
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::set
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, Set_Value)
+{
+  using Type = std::set<char>;
+  const Type val = {'w', 'o', 'r', 'l', 'd'};
+  auto bytes = serde_binary::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{5, 'd', 'l', 'o', 'r', 'w'}));
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Set_Empty)
+{
+  using Type = std::set<char>;
+  const Type val = {};
+  auto bytes = serde_binary::to_bytes(val).value();
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::unordered_set
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, UnorderedSet_Value)
+{
+  using Type = std::unordered_set<char>;
+  const Type val = {'w', 'o', 'r', 'l', 'd'};
+  auto bytes = serde_binary::to_bytes(val).value();
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::multiset
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, MultiSet_Value)
+{
+  using Type = std::multiset<char>;
+  const Type val = {'b', 'e', 'e', 'f'};
+  auto bytes = serde_binary::to_bytes(val).value();
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::unordered_multiset
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, UnorderedMultiSet_Value)
+{
+  using Type = std::unordered_multiset<char>;
+  const Type val = {'b', 'e', 'e', 'f'};
+  auto bytes = serde_binary::to_bytes(val).value();
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::map
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, Map_Value)
+{
+  using Type = std::map<std::string, long int>;
+  const Type val = {{"foo", 10}, {"bar", 22}};
+  auto bytes = serde_binary::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{2, 3, 'b', 'a', 'r', 44, 3, 'f', 'o', 'o', 20}));
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Map_Empty)
+{
+  using Type = std::map<std::string, long int>;
+  const Type val = {};
+  auto bytes = serde_binary::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0}));
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::unordered_map
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, UnorderedMap_Value)
+{
+  using Type = std::unordered_map<std::string, long int>;
+  const Type val = {{"foo", 10}, {"bar", 22}, {"egg", 67}};
+  auto bytes = serde_binary::to_bytes(val).value();
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::multimap
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, MultiMap_Value)
+{
+  using Type = std::multimap<short int, std::string>;
+  const Type val = {{1, "one"}, {1, "uno"}, {2, "two"}};
+  auto bytes = serde_binary::to_bytes(val).value();
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::unordered_multimap
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, UnorderedMultiMap_Value)
+{
+  using Type = std::unordered_multimap<short int, std::string>;
+  const Type val = {{1, "one"}, {1, "uno"}, {2, "two"}};
+  auto bytes = serde_binary::to_bytes(val).value();
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::deque
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, Deque_Value)
+{
+  using Type = std::deque<std::string>;
+  const Type val = {"clubs", "queen", "king"};
+  auto bytes = serde_binary::to_bytes(val).value();
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Deque_Empty)
+{
+  using Type = std::deque<std::string>;
+  const Type val = {};
+  auto bytes = serde_binary::to_bytes(val).value();
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::queue
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, Queue_Value)
+{
+  using Type = std::queue<std::string>;
+  Type val; val.push("clubs"); val.push("queen"); val.push("king");
+  // no serialization for queue, any sequence deserializes into it
+  auto bytes = serde_binary::to_bytes(std::vector<std::string>{"clubs", "queen", "king"}).value();
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::stack
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, Stack_Value)
+{
+  using Type = std::stack<std::string>;
+  Type val; val.push("clubs"); val.push("queen"); val.push("king");
+  // no serialization for stack, any sequence deserializes into it
+  auto bytes = serde_binary::to_bytes(std::vector<std::string>{"clubs", "queen", "king"}).value();
+  auto de_val = serde_binary::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
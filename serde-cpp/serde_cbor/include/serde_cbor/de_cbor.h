@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <serde/de.h>
+#include <serde/error.h>
+#include <serde/result.hpp>
+
+#include "detail/de_detail.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// Serde CBOR
+///////////////////////////////////////////////////////////////////////////////
+namespace serde_cbor {
+
+/// CBOR Deserializer function from bytes to T.
+/// The whole input must be consumed by T, trailing bytes are an error.
+template<typename T>
+auto from_bytes(const void* data, size_t len) -> cpp::result<T, serde::Error>
+{
+  auto de = detail::DeserializerNew(data, len);
+  T obj{};
+  de->deserialize(obj);
+  detail::DeserializerExpectEnd(de.get());
+  if (de->has_error())
+    return cpp::fail(de->error());
+  return std::move(obj);
+}
+
+/// CBOR Deserializer function from a byte vector to T
+template<typename T>
+auto from_bytes(const std::vector<uint8_t>& bytes) -> cpp::result<T, serde::Error>
+{
+  return from_bytes<T>(bytes.data(), bytes.size());
+}
+
+} // namespace serde_cbor
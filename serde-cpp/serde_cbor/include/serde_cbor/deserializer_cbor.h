@@ -0,0 +1,536 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <serde/de.h>
+#include <serde/error.h>
+#include <serde/result.hpp>
+
+#include "detail/format.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Serde CBOR
+////////////////////////////////////////////////////////////////////////////////
+namespace serde_cbor {
+
+/// CBOR Deserializer
+///
+/// Reads CBOR straight from the input bytes, there is no intermediate tree:
+/// every Deserializer call consumes the next data item. Definite and indefinite
+/// lengths are both read, integers and floats in any width as long as the value
+/// fits (integers are accepted for floats), and tags are skipped.
+///
+/// Structs are read from maps by field name. Fields are looked up at the entry
+/// following the previous field first, so maps in field order are read in a
+/// single pass, otherwise the map is searched (deterministic encoding sorts the
+/// fields by name). Entries of unknown names are skipped.
+///
+/// The input is borrowed, not copied, it must outlive the deserializer and any
+/// strings or bytes borrowed from it (deserialize_str, deserialize_bytes_borrowed),
+/// which must have definite lengths.
+///
+/// Errors have no line, their column is the byte offset in the input (1-based)
+/// where the offending item starts.
+class CborDeserializer final : public serde::StaticDeserializer<CborDeserializer> {
+public:
+  CborDeserializer() = default;
+
+  CborDeserializer(const void* data, size_t len) { reset(data, len); }
+
+  /// Deserialize another input, dropping the error
+  void reset(const void* data, size_t len) {
+    first = static_cast<const uint8_t*>(data);
+    pos = first;
+    last = first + len;
+    frames.clear();
+    clear_error();
+  }
+
+  /// Bytes not consumed yet
+  size_t remaining() const { return static_cast<size_t>(last - pos); }
+
+  /// Set an error if the deserialized value didn't consume the whole input
+  void expect_end() {
+    if (!has_error() && pos != last)
+      fail_at(pos, "trailing bytes after value");
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Deserializer interface
+  //////////////////////////////////////////////////////////////////////////////
+
+  // Scalars ///////////////////////////////////////////////////////////////////
+  void deserialize_bool(bool& val) final {
+    const uint8_t* start = pos;
+    detail::Head h;
+    if (!read_head(h)) return;
+    if (h.major != detail::Major::Simple || (h.info != 20 && h.info != 21))
+      return fail_at(start, "expected a bool");
+    val = h.info == 21;
+  }
+  void deserialize_i8(int8_t& val) final { read_int(val); }
+  void deserialize_u8(uint8_t& val) final { read_int(val); }
+  void deserialize_i16(int16_t& val) final { read_int(val); }
+  void deserialize_u16(uint16_t& val) final { read_int(val); }
+  void deserialize_i32(int32_t& val) final { read_int(val); }
+  void deserialize_u32(uint32_t& val) final { read_int(val); }
+  void deserialize_i64(int64_t& val) final { read_int(val); }
+  void deserialize_u64(uint64_t& val) final { read_int(val); }
+  void deserialize_float(float& val) final { read_float(val); }
+  void deserialize_double(double& val) final { read_float(val); }
+  void deserialize_char(char& val) final { read_int(val); }
+  void deserialize_uchar(unsigned char& val) final { read_int(val); }
+
+  void deserialize_cstr(char* val, size_t len) final {
+    size_t n = 0;
+    read_string(detail::Major::Text, "expected a string", [&](const uint8_t* chunk, size_t chunk_len) {
+      const size_t copy = len ? std::min(chunk_len, len - 1 - n) : 0;
+      if (copy)
+        std::memcpy(val + n, chunk, copy);
+      n += copy;
+    });
+    if (len)
+      val[n] = '\0';
+  }
+
+  void deserialize_str(const char*& val, size_t& len) final {
+    const void* bytes = nullptr;
+    borrow_string(detail::Major::Text, "expected a string", bytes, len);
+    val = static_cast<const char*>(bytes);
+  }
+
+  void deserialize_bytes(void* val, size_t len) final {
+    const uint8_t* start = pos;
+    size_t n = 0;
+    bool overflow = false;
+    read_string(detail::Major::Bytes, "expected bytes", [&](const uint8_t* chunk, size_t chunk_len) {
+      if (chunk_len > len - n) {
+        overflow = true;
+        return;
+      }
+      if (chunk_len)
+        std::memcpy(static_cast<uint8_t*>(val) + n, chunk, chunk_len);
+      n += chunk_len;
+    });
+    if (overflow)
+      fail_at(start, "bytes exceed the destination");
+  }
+
+  void deserialize_bytes_borrowed(const void*& val, size_t& len) final {
+    borrow_string(detail::Major::Bytes, "expected bytes", val, len);
+  }
+
+  // Length of the text string that follows (of all its chunks), it is not consumed
+  void deserialize_length(size_t& len) final {
+    const uint8_t* start = pos;
+    size_t n = 0;
+    read_string(detail::Major::Text, "expected a string", [&](const uint8_t*, size_t chunk_len) { n += chunk_len; });
+    if (has_error()) return;
+    len = n;
+    pos = start;
+  }
+
+  // Optional //////////////////////////////////////////////////////////////////
+  // null (or undefined) is none, anything else is the value. Not consumed, the value or none follows.
+  void deserialize_is_some(bool& val) final {
+    if (has_error()) return;
+    if (pos == last)
+      return fail_eof();
+    val = *pos != detail::code::null && *pos != detail::code::undefined;
+  }
+  void deserialize_none() final {
+    const uint8_t* start = pos;
+    detail::Head h;
+    if (!read_head(h)) return;
+    if (h.major != detail::Major::Simple || (h.info != 22 && h.info != 23))
+      fail_at(start, "expected null");
+  }
+
+  // Sequence //////////////////////////////////////////////////////////////////
+  void deserialize_seq_begin() final { container_begin(detail::Major::Array, "expected an array"); }
+  // Number of elements of the array that follows, it is not consumed
+  void deserialize_seq_size(size_t& size) final { peek_size(size, detail::Major::Array, "expected an array"); }
+  void deserialize_seq_end() final { container_end(); }
+
+  // Sequence of scalars ///////////////////////////////////////////////////////
+  void deserialize_seq_bool(bool* vals, size_t len) final { read_seq(vals, len); }
+  void deserialize_seq_i8(int8_t* vals, size_t len) final { read_seq(vals, len); }
+  void deserialize_seq_u8(uint8_t* vals, size_t len) final { read_seq(vals, len); }
+  void deserialize_seq_i16(int16_t* vals, size_t len) final { read_seq(vals, len); }
+  void deserialize_seq_u16(uint16_t* vals, size_t len) final { read_seq(vals, len); }
+  void deserialize_seq_i32(int32_t* vals, size_t len) final { read_seq(vals, len); }
+  void deserialize_seq_u32(uint32_t* vals, size_t len) final { read_seq(vals, len); }
+  void deserialize_seq_i64(int64_t* vals, size_t len) final { read_seq(vals, len); }
+  void deserialize_seq_u64(uint64_t* vals, size_t len) final { read_seq(vals, len); }
+  void deserialize_seq_float(float* vals, size_t len) final { read_seq(vals, len); }
+  void deserialize_seq_double(double* vals, size_t len) final { read_seq(vals, len); }
+  void deserialize_seq_char(char* vals, size_t len) final { read_seq(vals, len); }
+  void deserialize_seq_uchar(unsigned char* vals, size_t len) final { read_seq(vals, len); }
+
+  // Map ///////////////////////////////////////////////////////////////////////
+  void deserialize_map_begin() final { container_begin(detail::Major::Map, "expected a map"); }
+  // Number of entries of the map that follows, it is not consumed
+  void deserialize_map_size(size_t& size) final { peek_size(size, detail::Major::Map, "expected a map"); }
+  void deserialize_map_end() final { container_end(); }
+  void deserialize_map_key_begin() final {
+    if (!frames.empty())
+      frames.back().current = frames.back().next;
+  }
+  void deserialize_map_key_end() final {}
+  // Position the input at the value of the entry with the given text key
+  void deserialize_map_key_find(const char* key) final {
+    if (has_error()) return;
+    if (frames.empty() || frames.back().major != detail::Major::Map)
+      return fail_at(pos, "no map to find key");
+    Frame& top = frames.back();
+    const size_t key_len = std::strlen(key);
+    // keys are usually in the same order as they are looked up (struct field order),
+    // so try the entry at the cursor before searching the whole map
+    if (!map_end_at(top, top.cursor, top.next)) {
+      if (const uint8_t* value = match_key(top.cursor, key, key_len)) {
+        top.current = top.next;
+        pos = value;
+        return;
+      }
+    }
+    const uint8_t* entry = top.entries;
+    for (size_t i = 0; !map_end_at(top, entry, i); i++) {
+      if (const uint8_t* value = match_key(entry, key, key_len)) {
+        top.current = i;
+        pos = value;
+        return;
+      }
+      if (!(entry = detail::skip_item(entry, last)) || !(entry = detail::skip_item(entry, last)))
+        return fail_at(top.start, "invalid map");
+    }
+    fail_at(top.start, std::string("key not found in map: ").append(key));
+  }
+  void deserialize_map_value_begin() final {}
+  void deserialize_map_value_end() final { entry_end(); }
+
+  // Struct ////////////////////////////////////////////////////////////////////
+  void deserialize_struct_begin() final { container_begin(detail::Major::Map, "expected a map"); }
+  void deserialize_struct_end() final { container_end(); }
+  void deserialize_struct_field_begin(const char* name) final { deserialize_map_key_find(name); }
+  void deserialize_struct_field_end() final { entry_end(); }
+
+private:
+  // Open arrays, maps and structs
+  struct Frame {
+    detail::Major major;    // Array or Map
+    bool indefinite;        // ends with a break
+    const uint8_t* start;   // head, for errors
+    const uint8_t* entries; // first entry (maps)
+    const uint8_t* cursor;  // entry after the last one read (maps)
+    size_t count;           // number of entries (definite maps, indefinite ones once their break is reached)
+    size_t next;            // index of the entry at the cursor (maps)
+    size_t current;         // index of the entry being read (maps)
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Deserialization Utils
+  //////////////////////////////////////////////////////////////////////////////
+
+  void fail_at(const uint8_t* at, std::string text) {
+    const auto column = static_cast<size_t>(at - first) + 1;
+    set_error({serde::Error::Kind::Invalid, 0, column, std::move(text)});
+  }
+
+  void fail_eof() { fail_at(pos, "unexpected end of input"); }
+
+  // Read the head of the next data item, skipping its tags, and check its definite
+  // length (and for arrays and maps the minimum size of their items) is within the input,
+  // so a corrupt length fails here instead of resizing a container to it
+  bool read_head(detail::Head& h) {
+    if (has_error()) return false;
+    do {
+      const uint8_t* start = pos;
+      const uint8_t* content = detail::read_head(pos, last, h);
+      if (!content) {
+        // a truncated argument, or reserved additional info / misplaced indefinite length
+        if (pos == last || ((*pos & 0x1F) >= 24 && (*pos & 0x1F) <= 27))
+          fail_eof();
+        else
+          fail_at(start, "invalid head");
+        return false;
+      }
+      if (!h.indefinite && h.major >= detail::Major::Bytes && h.major <= detail::Major::Map) {
+        const uint64_t avail = static_cast<uint64_t>(last - content);
+        if (h.arg > avail || (h.major == detail::Major::Map && 2 * h.arg > avail)) {
+          fail_at(start, h.major >= detail::Major::Array ? "length exceeds input" : "unexpected end of input");
+          return false;
+        }
+      }
+      pos = content;
+    } while (h.major == detail::Major::Tag);
+    return true;
+  }
+
+  template<typename T>
+  static bool decode_int(const detail::Head& h, T& val) {
+    if (h.major == detail::Major::UInt) {
+      if (h.arg > static_cast<std::make_unsigned_t<T>>(std::numeric_limits<T>::max()))
+        return false;
+      val = static_cast<T>(h.arg);
+      return true;
+    }
+    // -1 - arg
+    if constexpr (std::is_signed_v<T>) {
+      if (h.arg > static_cast<uint64_t>(-(static_cast<int64_t>(std::numeric_limits<T>::min()) + 1)))
+        return false;
+      val = static_cast<T>(-1 - static_cast<int64_t>(h.arg));
+      return true;
+    }
+    return false;
+  }
+
+  template<typename T>
+  void read_int(T& val) {
+    const uint8_t* start = pos;
+    detail::Head h;
+    if (!read_head(h)) return;
+    if (h.major != detail::Major::UInt && h.major != detail::Major::NegInt)
+      return fail_at(start, "expected an integer");
+    if (!decode_int(h, val))
+      fail_at(start, "number out of range");
+  }
+
+  template<typename T>
+  void read_float(T& val) {
+    const uint8_t* start = pos;
+    detail::Head h;
+    if (!read_head(h)) return;
+    if (h.major == detail::Major::Simple && h.info >= 25 && h.info <= 27) {
+      if (h.info == 25) {
+        val = static_cast<T>(detail::half_to_double(static_cast<uint16_t>(h.arg)));
+      }
+      else if (h.info == 26) {
+        const auto bits = static_cast<uint32_t>(h.arg);
+        float f;
+        std::memcpy(&f, &bits, sizeof(f));
+        val = static_cast<T>(f);
+      }
+      else {
+        double d;
+        std::memcpy(&d, &h.arg, sizeof(d));
+        val = static_cast<T>(d);
+      }
+    }
+    else if (h.major == detail::Major::UInt) {
+      val = static_cast<T>(h.arg);
+    }
+    else if (h.major == detail::Major::NegInt) {
+      val = static_cast<T>(-1.0L - static_cast<long double>(h.arg));
+    }
+    else {
+      fail_at(start, "expected a float");
+    }
+  }
+
+  // Read the text or byte string that follows, calling fn with each chunk
+  template<typename Fn>
+  void read_string(detail::Major major, const char* mismatch, Fn&& fn) {
+    const uint8_t* start = pos;
+    detail::Head h;
+    if (!read_head(h)) return;
+    if (h.major != major)
+      return fail_at(start, mismatch);
+    if (!h.indefinite) {
+      fn(pos, static_cast<size_t>(h.arg));
+      pos += h.arg;
+      return;
+    }
+    // definite length chunks of the same major type until break
+    for (;;) {
+      if (pos == last)
+        return fail_eof();
+      if (*pos == detail::code::break_) {
+        pos++;
+        return;
+      }
+      const uint8_t* chunk_start = pos;
+      detail::Head chunk;
+      if (!read_head(chunk)) return;
+      if (chunk.major != major || chunk.indefinite)
+        return fail_at(chunk_start, "invalid string chunk");
+      fn(pos, static_cast<size_t>(chunk.arg));
+      pos += chunk.arg;
+    }
+  }
+
+  void borrow_string(detail::Major major, const char* mismatch, const void*& val, size_t& len) {
+    const uint8_t* start = pos;
+    detail::Head h;
+    if (!read_head(h)) return;
+    if (h.major != major)
+      return fail_at(start, mismatch);
+    if (h.indefinite)
+      return fail_at(start, "indefinite length string can't be borrowed");
+    val = pos;
+    len = static_cast<size_t>(h.arg);
+    pos += h.arg;
+  }
+
+  // Number of items of the indefinite length array (or entries of the map) whose items
+  // start at p. Sets end to its break.
+  bool count_items(const uint8_t* p, detail::Major major, size_t& count, const uint8_t*& end) {
+    size_t n = 0;
+    while (p && p != last && *p != detail::code::break_) {
+      p = detail::skip_item(p, last);
+      n++;
+    }
+    if (!p || p == last || (major == detail::Major::Map && n % 2)) {
+      fail_at(p ? p : pos, p == last ? "unexpected end of input" : "invalid item");
+      return false;
+    }
+    count = major == detail::Major::Map ? n / 2 : n;
+    end = p;
+    return true;
+  }
+
+  void peek_size(size_t& size, detail::Major major, const char* mismatch) {
+    const uint8_t* start = pos;
+    detail::Head h;
+    if (!read_head(h)) return;
+    if (h.major != major) {
+      pos = start;
+      return fail_at(start, mismatch);
+    }
+    if (h.indefinite) {
+      const uint8_t* end;
+      if (!count_items(pos, major, size, end)) return;
+    }
+    else {
+      size = static_cast<size_t>(h.arg);
+    }
+    pos = start;
+  }
+
+  void container_begin(detail::Major major, const char* mismatch) {
+    const uint8_t* start = pos;
+    detail::Head h;
+    if (!read_head(h)) return;
+    if (h.major != major)
+      return fail_at(start, mismatch);
+    // entries of indefinite maps are counted as they are walked, up to the break,
+    // rather than scanned up front (which nested structs would repeat at every level)
+    frames.push_back(Frame{major, h.indefinite, start, pos, pos, static_cast<size_t>(h.arg), 0, 0});
+  }
+
+  // Whether p, the entry of index i of the map top, is past its last entry
+  bool map_end_at(Frame& top, const uint8_t* p, size_t i) {
+    if (!top.indefinite)
+      return i >= top.count;
+    if (p == last) {
+      fail_eof();
+      return true;
+    }
+    if (*p != detail::code::break_)
+      return false;
+    top.count = i;
+    return true;
+  }
+
+  void entry_end() {
+    if (has_error() || frames.empty()) return;
+    Frame& top = frames.back();
+    top.next = top.current + 1;
+    top.cursor = pos;
+  }
+
+  // Skip the map entries which were not read, and the break of indefinite lengths
+  void container_end() {
+    if (has_error() || frames.empty()) return;
+    Frame top = frames.back();
+    frames.pop_back();
+    if (top.major == detail::Major::Map) {
+      const uint8_t* p = top.cursor;
+      for (size_t i = top.next; p && !map_end_at(top, p, i); i++) {
+        p = detail::skip_item(p, last);
+        p = p ? detail::skip_item(p, last) : nullptr;
+      }
+      if (!p)
+        return fail_at(top.cursor, "invalid map");
+      pos = p;
+    }
+    if (top.indefinite) {
+      if (pos == last)
+        return fail_eof();
+      if (*pos != detail::code::break_)
+        return fail_at(pos, "expected the end of the container");
+      pos++;
+    }
+  }
+
+  template<typename T>
+  void read_seq(T* vals, size_t len) {
+    const uint8_t* start = pos;
+    detail::Head h;
+    if (!read_head(h)) return;
+    if (h.major != detail::Major::Array)
+      return fail_at(start, "expected an array");
+    if (!h.indefinite && h.arg != len)
+      return fail_at(start, "sequence length mismatch");
+    for (size_t i = 0; i < len && !has_error(); i++) {
+      if constexpr (std::is_same_v<T, bool>)
+        deserialize_bool(vals[i]);
+      else if constexpr (std::is_floating_point_v<T>)
+        read_float(vals[i]);
+      // inline small unsigned integer fast path, the common case
+      else if (pos != last && *pos < 24 && *pos <= static_cast<std::make_unsigned_t<T>>(std::numeric_limits<T>::max()))
+        vals[i] = static_cast<T>(*pos++);
+      else
+        read_int(vals[i]);
+    }
+    if (h.indefinite && !has_error()) {
+      if (pos == last || *pos != detail::code::break_)
+        return fail_at(start, "sequence length mismatch");
+      pos++;
+    }
+  }
+
+  // The value after the entry at p if its key is the definite length text key, nullptr otherwise
+  const uint8_t* match_key(const uint8_t* p, const char* key, size_t key_len) const {
+    detail::Head h;
+    const uint8_t* str = detail::read_head(p, last, h);
+    if (!str || h.major != detail::Major::Text || h.indefinite || h.arg != key_len || key_len > static_cast<size_t>(last - str))
+      return nullptr;
+    if (key_len && std::memcmp(str, key, key_len) != 0)
+      return nullptr;
+    return str + key_len;
+  }
+
+  const uint8_t* first = nullptr;
+  const uint8_t* pos = nullptr;
+  const uint8_t* last = nullptr;
+  std::vector<Frame> frames;
+};
+
+/// CBOR Deserializer function from bytes to T, statically dispatched.
+/// Same as from_bytes(), with the deserializer calls resolved at compile time.
+template<typename T>
+auto from_bytes_static(const void* data, size_t len) -> cpp::result<T, serde::Error>
+{
+  CborDeserializer de(data, len);
+  T obj{};
+  de.deserialize(obj);
+  de.expect_end();
+  if (de.has_error())
+    return cpp::fail(de.error());
+  return std::move(obj);
+}
+
+/// CBOR Deserializer function from a byte vector to T, statically dispatched
+template<typename T>
+auto from_bytes_static(const std::vector<uint8_t>& bytes) -> cpp::result<T, serde::Error>
+{
+  return from_bytes_static<T>(bytes.data(), bytes.size());
+}
+
+} // namespace serde_cbor
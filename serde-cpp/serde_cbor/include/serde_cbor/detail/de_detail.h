@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <serde/de/deserializer.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// Serde CBOR detail
+///////////////////////////////////////////////////////////////////////////////
+namespace serde_cbor::detail {
+
+// Deserializer borrowing [data, data + len)
+auto DeserializerNew(const void* data, size_t len) -> std::unique_ptr<serde::Deserializer>;
+// Set an error in de if it didn't consume all of its input
+void DeserializerExpectEnd(serde::Deserializer* de);
+
+} // namespace serde_cbor::detail
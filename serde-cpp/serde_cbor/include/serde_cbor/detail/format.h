@@ -0,0 +1,244 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+///////////////////////////////////////////////////////////////////////////////
+// Serde CBOR detail
+///////////////////////////////////////////////////////////////////////////////
+namespace serde_cbor::detail {
+
+// CBOR major types (the top 3 bits of the initial byte), see RFC 8949
+enum class Major : uint8_t { UInt = 0, NegInt = 1, Bytes = 2, Text = 3, Array = 4, Map = 5, Tag = 6, Simple = 7 };
+
+namespace code {
+inline constexpr uint8_t false_ = 0xf4;
+inline constexpr uint8_t true_ = 0xf5;
+inline constexpr uint8_t null = 0xf6;
+inline constexpr uint8_t undefined = 0xf7;
+inline constexpr uint8_t float16 = 0xf9;
+inline constexpr uint8_t float32 = 0xfa;
+inline constexpr uint8_t float64 = 0xfb;
+inline constexpr uint8_t break_ = 0xff;
+inline constexpr uint8_t indefinite = 31; // additional info of indefinite length items
+} // namespace code
+
+/// Maximum number of bytes of a head (initial byte + 8 bytes argument)
+inline constexpr size_t head_max_size = 9;
+
+inline uint8_t* write_be(uint8_t* out, uint64_t v, size_t n) {
+  for (size_t i = 0; i < n; i++)
+    out[i] = static_cast<uint8_t>(v >> (8 * (n - 1 - i)));
+  return out + n;
+}
+
+inline uint64_t read_be(const uint8_t* in, size_t n) {
+  uint64_t v = 0;
+  for (size_t i = 0; i < n; i++)
+    v = v << 8 | in[i];
+  return v;
+}
+
+/// Write the head of a data item: major type and argument in its shortest form
+/// (in the initial byte up to 23, then 1, 2, 4 or 8 bytes), as deterministic encoding requires.
+/// Returns the end of the written bytes.
+inline uint8_t* write_head(uint8_t* out, Major major, uint64_t arg) {
+  const auto mt = static_cast<uint8_t>(static_cast<uint8_t>(major) << 5);
+  if (arg < 24) {
+    *out++ = static_cast<uint8_t>(mt | arg);
+    return out;
+  }
+  if (arg <= UINT8_MAX) { *out++ = mt | 24; return write_be(out, arg, 1); }
+  if (arg <= UINT16_MAX) { *out++ = mt | 25; return write_be(out, arg, 2); }
+  if (arg <= UINT32_MAX) { *out++ = mt | 26; return write_be(out, arg, 4); }
+  *out++ = mt | 27;
+  return write_be(out, arg, 8);
+}
+
+/// Size of the head write_head() writes for arg
+inline size_t head_size(uint64_t arg) {
+  return arg < 24 ? 1 : arg <= UINT8_MAX ? 2 : arg <= UINT16_MAX ? 3 : arg <= UINT32_MAX ? 5 : 9;
+}
+
+inline uint8_t* write_int(uint8_t* out, int64_t v) {
+  if (v >= 0)
+    return write_head(out, Major::UInt, static_cast<uint64_t>(v));
+  // -1 - n, computed without overflowing for INT64_MIN
+  return write_head(out, Major::NegInt, ~static_cast<uint64_t>(v));
+}
+
+/// The half precision bits of f if it converts to half without loss
+inline bool float_to_half(float f, uint16_t& half) {
+  uint32_t bits;
+  std::memcpy(&bits, &f, sizeof(bits));
+  const auto sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+  const int exp = static_cast<int>((bits >> 23) & 0xFF);
+  const uint32_t mant = bits & 0x7FFFFF;
+  if (exp == 0 && mant == 0) { // zero
+    half = sign;
+    return true;
+  }
+  if (exp == 0 || exp == 0xFF) // float subnormals are below the half range, non finite are handled by the caller
+    return false;
+  const int e = exp - 127;
+  if (e >= -14 && e <= 15) { // half normal
+    if (mant & 0x1FFF)
+      return false;
+    half = static_cast<uint16_t>(sign | (e + 15) << 10 | mant >> 13);
+    return true;
+  }
+  if (e >= -24 && e < -14) { // half subnormal, value = m * 2^-24
+    const uint32_t full = 0x800000 | mant;
+    const int shift = 13 + (-14 - e);
+    if (full & ((uint32_t(1) << shift) - 1))
+      return false;
+    half = static_cast<uint16_t>(sign | full >> shift);
+    return true;
+  }
+  return false;
+}
+
+inline double half_to_double(uint16_t half) {
+  const int exp = (half >> 10) & 0x1F;
+  const int mant = half & 0x3FF;
+  double v;
+  if (exp == 0)
+    v = std::ldexp(mant, -24);
+  else if (exp != 31)
+    v = std::ldexp(mant + 1024, exp - 25);
+  else
+    v = mant == 0 ? INFINITY : NAN;
+  return half & 0x8000 ? -v : v;
+}
+
+/// Write v in the shortest of float16, float32 and float64 which represents it exactly.
+/// NaN is written as the canonical half 0x7e00.
+inline uint8_t* write_float(uint8_t* out, double v) {
+  if (std::isnan(v)) {
+    *out++ = code::float16;
+    return write_be(out, 0x7e00, 2);
+  }
+  const auto f = static_cast<float>(v);
+  if (static_cast<double>(f) == v) {
+    uint16_t half;
+    if (std::isinf(f)) {
+      *out++ = code::float16;
+      return write_be(out, f > 0 ? 0x7c00 : 0xfc00, 2);
+    }
+    if (float_to_half(f, half)) {
+      *out++ = code::float16;
+      return write_be(out, half, 2);
+    }
+    uint32_t bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+    *out++ = code::float32;
+    return write_be(out, bits, 4);
+  }
+  uint64_t bits;
+  std::memcpy(&bits, &v, sizeof(bits));
+  *out++ = code::float64;
+  return write_be(out, bits, 8);
+}
+
+/// Decoded head of a data item
+struct Head {
+  Major major = Major::UInt;
+  uint8_t info = 0;      // additional info, the low 5 bits of the initial byte
+  uint64_t arg = 0;      // value, length, tag or simple value / float bits
+  bool indefinite = false;
+};
+
+/// Read the head of the item at [first, last) into h.
+/// Returns the start of the item content, or nullptr if the head is truncated or malformed
+/// (reserved additional info 28-30, or an indefinite length on a major type that has none).
+inline const uint8_t* read_head(const uint8_t* first, const uint8_t* last, Head& h) {
+  if (first == last)
+    return nullptr;
+  const uint8_t c = *first++;
+  h.major = static_cast<Major>(c >> 5);
+  h.info = c & 0x1F;
+  h.indefinite = false;
+  if (h.info < 24) {
+    h.arg = h.info;
+    return first;
+  }
+  if (h.info <= 27) {
+    const size_t n = size_t(1) << (h.info - 24);
+    if (static_cast<size_t>(last - first) < n)
+      return nullptr;
+    h.arg = read_be(first, n);
+    return first + n;
+  }
+  if (h.info == code::indefinite) {
+    switch (h.major) {
+      case Major::Bytes: case Major::Text: case Major::Array: case Major::Map:
+        h.indefinite = true;
+        h.arg = 0;
+        return first;
+      case Major::Simple: // break, checked by the caller
+        h.arg = 0;
+        return first;
+      default:
+        return nullptr;
+    }
+  }
+  return nullptr;
+}
+
+inline bool is_break(const Head& h) { return h.major == Major::Simple && h.info == code::indefinite; }
+
+/// Maximum nesting of arrays, maps and tags skip_item() goes through
+inline constexpr int max_depth = 512;
+
+/// Skip the data item at [first, last), arrays and maps with all their items.
+/// Returns the end of the item, or nullptr if it is truncated, malformed or nested too deep.
+inline const uint8_t* skip_item(const uint8_t* first, const uint8_t* last, int depth = 0) {
+  Head h;
+  first = read_head(first, last, h);
+  if (!first || depth > max_depth || is_break(h))
+    return nullptr;
+  const auto avail = [&] { return static_cast<uint64_t>(last - first); };
+  switch (h.major) {
+    case Major::Bytes: case Major::Text:
+      if (!h.indefinite) {
+        if (h.arg > avail())
+          return nullptr;
+        return first + h.arg;
+      }
+      // chunks of the same major type, definite length, until break
+      while (first != last && *first != code::break_) {
+        Head chunk;
+        first = read_head(first, last, chunk);
+        if (!first || chunk.major != h.major || chunk.indefinite || chunk.arg > avail())
+          return nullptr;
+        first += chunk.arg;
+      }
+      return first == last ? nullptr : first + 1;
+    case Major::Array: case Major::Map: {
+      const uint64_t items = h.major == Major::Map ? 2 * h.arg : h.arg;
+      if (!h.indefinite) {
+        if (items > avail())
+          return nullptr;
+        for (uint64_t i = 0; i < items && first; i++)
+          first = skip_item(first, last, depth + 1);
+        return first;
+      }
+      uint64_t n = 0;
+      while (first && first != last && *first != code::break_) {
+        first = skip_item(first, last, depth + 1);
+        n++;
+      }
+      if (!first || first == last || (h.major == Major::Map && n % 2))
+        return nullptr;
+      return first + 1;
+    }
+    case Major::Tag:
+      return skip_item(first, last, depth + 1);
+    default:
+      return first;
+  }
+}
+
+} // namespace serde_cbor::detail
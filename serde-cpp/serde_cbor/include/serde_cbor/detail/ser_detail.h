@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <serde/ser/serializer.h>
+
+#include "../encode_options.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// Serde CBOR detail
+///////////////////////////////////////////////////////////////////////////////
+namespace serde_cbor::detail {
+
+// Serializer appending to out
+auto SerializerNew(std::vector<uint8_t>& out, const EncodeOptions& options) -> std::unique_ptr<serde::Serializer>;
+
+} // namespace serde_cbor::detail
@@ -0,0 +1,25 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// Serde CBOR
+////////////////////////////////////////////////////////////////////////////////
+namespace serde_cbor {
+
+/// CBOR encoding options of CborSerializer.
+/// By default containers of unknown size (structs, std::forward_list) are written with
+/// indefinite lengths and entries are written in the order they are serialized.
+struct EncodeOptions {
+  /// Deterministic encoding (RFC 8949 section 4.2.1), the same value is always the same bytes:
+  /// all lengths are definite, map keys (struct fields included) are sorted by their encoded
+  /// bytes, and so are the elements of std::unordered_set and friends.
+  bool deterministic = false;
+
+  /// Deterministic encoding, for hashing and comparing encoded values
+  static EncodeOptions canonical() {
+    EncodeOptions options;
+    options.deterministic = true;
+    return options;
+  }
+};
+
+} // namespace serde_cbor
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <serde/ser.h>
+#include <serde/error.h>
+#include <serde/result.hpp>
+
+#include "encode_options.h"
+#include "detail/ser_detail.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// Serde CBOR
+///////////////////////////////////////////////////////////////////////////////
+namespace serde_cbor {
+
+/// CBOR Serializer function from T to bytes.
+/// Use EncodeOptions::canonical() for the deterministic encoding.
+template<typename T>
+auto to_bytes(T&& obj, const EncodeOptions& options = {}) -> cpp::result<std::vector<uint8_t>, serde::Error>
+{
+  std::vector<uint8_t> out;
+  auto ser = detail::SerializerNew(out, options);
+  ser->serialize(std::forward<T>(obj));
+  return out;
+}
+
+/// CBOR Serializer function from T to bytes, appended to out.
+/// Reusing out (cleared) across calls avoids allocating once its capacity is warmed up.
+template<typename T>
+auto to_bytes(T&& obj, std::vector<uint8_t>& out, const EncodeOptions& options = {}) -> cpp::result<void, serde::Error>
+{
+  auto ser = detail::SerializerNew(out, options);
+  ser->serialize(std::forward<T>(obj));
+  return {};
+}
+
+} // namespace serde_cbor
@@ -0,0 +1,5 @@
+#pragma once
+
+// include serialization and deserialization
+#include "ser_cbor.h"
+#include "de_cbor.h"
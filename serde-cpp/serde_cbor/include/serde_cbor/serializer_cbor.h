@@ -0,0 +1,331 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <serde/ser.h>
+#include <serde/error.h>
+#include <serde/result.hpp>
+
+#include "encode_options.h"
+#include "detail/format.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Serde CBOR
+////////////////////////////////////////////////////////////////////////////////
+namespace serde_cbor {
+
+/// CBOR Serializer
+///
+/// Writes CBOR (RFC 8949) with every integer, length and float in its shortest form:
+///
+///   bool, none               true / false, null
+///   ints, char, uchar        unsigned / negative integer
+///   float, double            the shortest of float16, float32 and float64 holding the exact value
+///   str                      text string
+///   bytes                    byte string
+///   seq                      array
+///   map                      map
+///   struct                   map of field name (text) to field value
+///
+/// Containers of known size have definite lengths. The others (structs, std::forward_list)
+/// have indefinite lengths, unless EncodeOptions::deterministic is set, then their one byte
+/// head is filled in when they end and the rare ones with more than 23 elements are moved
+/// forward to make room for the wider head. Deterministic encoding also sorts map entries
+/// and unordered sequences by their encoded bytes once they end, see EncodeOptions.
+///
+/// The output vector is owned by the caller and is appended to, so it can be
+/// reused (cleared) across messages to avoid allocating once warmed up.
+class CborSerializer final : public serde::StaticSerializer<CborSerializer> {
+public:
+  explicit CborSerializer(std::vector<uint8_t>& out, const EncodeOptions& options = {}) : out(&out), options(options) {}
+
+  /// Serialize a new value, keeping the allocated capacity.
+  /// Anything already written to the output vector is left there.
+  void reset() {
+    frames.clear();
+    marks.clear();
+  }
+
+  /// Encoding options of the following serializations
+  void set_options(const EncodeOptions& options) { this->options = options; }
+  const EncodeOptions& get_options() const { return options; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Serializer interface
+  //////////////////////////////////////////////////////////////////////////////
+
+  // Scalars ///////////////////////////////////////////////////////////////////
+  void serialize_bool(bool v) final { write_byte(v ? detail::code::true_ : detail::code::false_); }
+  void serialize_i8(int8_t v) final { write_int(v); }
+  void serialize_u8(uint8_t v) final { write_uint(v); }
+  void serialize_i16(int16_t v) final { write_int(v); }
+  void serialize_u16(uint16_t v) final { write_uint(v); }
+  void serialize_i32(int32_t v) final { write_int(v); }
+  void serialize_u32(uint32_t v) final { write_uint(v); }
+  void serialize_i64(int64_t v) final { write_int(v); }
+  void serialize_u64(uint64_t v) final { write_uint(v); }
+  void serialize_float(float v) final { write_float(v); }
+  void serialize_double(double v) final { write_float(v); }
+  void serialize_char(char v) final { write_int(v); }
+  void serialize_uchar(unsigned char v) final { write_uint(v); }
+  void serialize_str(const char* v, size_t len) final {
+    value_begin();
+    write_block(detail::Major::Text, v, len);
+  }
+  void serialize_bytes(const void* val, size_t len) final {
+    value_begin();
+    write_block(detail::Major::Bytes, val, len);
+  }
+
+  // Optional //////////////////////////////////////////////////////////////////
+  void serialize_none() final { write_byte(detail::code::null); }
+
+  // Sequence //////////////////////////////////////////////////////////////////
+  void serialize_seq_begin() final { container_begin(detail::Major::Array); }
+  void serialize_seq_begin_sized(size_t len) final { container_begin_sized(detail::Major::Array, len, false); }
+  void serialize_seq_begin_unordered(size_t len) final { container_begin_sized(detail::Major::Array, len, true); }
+  void serialize_seq_end() final { container_end(); }
+
+  // Sequence of scalars ///////////////////////////////////////////////////////
+  void serialize_seq_bool(const bool* vals, size_t len) final {
+    uint8_t* p = seq_begin(len, 1);
+    for (size_t i = 0; i < len; i++)
+      *p++ = vals[i] ? detail::code::true_ : detail::code::false_;
+  }
+  void serialize_seq_i8(const int8_t* vals, size_t len) final { serialize_seq_numbers(vals, len); }
+  void serialize_seq_u8(const uint8_t* vals, size_t len) final { serialize_seq_numbers(vals, len); }
+  void serialize_seq_i16(const int16_t* vals, size_t len) final { serialize_seq_numbers(vals, len); }
+  void serialize_seq_u16(const uint16_t* vals, size_t len) final { serialize_seq_numbers(vals, len); }
+  void serialize_seq_i32(const int32_t* vals, size_t len) final { serialize_seq_numbers(vals, len); }
+  void serialize_seq_u32(const uint32_t* vals, size_t len) final { serialize_seq_numbers(vals, len); }
+  void serialize_seq_i64(const int64_t* vals, size_t len) final { serialize_seq_numbers(vals, len); }
+  void serialize_seq_u64(const uint64_t* vals, size_t len) final { serialize_seq_numbers(vals, len); }
+  void serialize_seq_float(const float* vals, size_t len) final { serialize_seq_numbers(vals, len); }
+  void serialize_seq_double(const double* vals, size_t len) final { serialize_seq_numbers(vals, len); }
+  void serialize_seq_char(const char* vals, size_t len) final { serialize_seq_numbers(vals, len); }
+  void serialize_seq_uchar(const unsigned char* vals, size_t len) final { serialize_seq_numbers(vals, len); }
+
+  // Map ///////////////////////////////////////////////////////////////////////
+  void serialize_map_begin() final { container_begin(detail::Major::Map); }
+  void serialize_map_begin_sized(size_t len) final { container_begin_sized(detail::Major::Map, len, false); }
+  void serialize_map_begin_unordered(size_t len) final { container_begin_sized(detail::Major::Map, len, true); }
+  void serialize_map_end() final { container_end(); }
+
+  void serialize_map_key_begin() final { entry_begin(); }
+  void serialize_map_key_end() final { entry_key_end(); }
+  void serialize_map_value_begin() final {}
+  void serialize_map_value_end() final {}
+
+  // Struct ////////////////////////////////////////////////////////////////////
+  void serialize_struct_begin() final { container_begin(detail::Major::Map); }
+  void serialize_struct_end() final { container_end(); }
+  void serialize_struct_field_begin(const char* name) final {
+    entry_begin();
+    write_block(detail::Major::Text, name, std::strlen(name));
+    entry_key_end();
+  }
+  void serialize_struct_field_end() final {}
+
+private:
+  static constexpr size_t npos = size_t(-1);
+
+  // Open containers
+  struct Frame {
+    detail::Major major; // Array or Map
+    bool sort;           // sort the elements (entries by key) when it ends
+    bool indefinite;     // indefinite length, ends with a break
+    size_t head_pos;     // position of the one byte head to fill in, npos if written up front
+    size_t count;        // elements (entries for maps) written so far
+    size_t marks_base;   // first mark of the container in marks
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Serialization Utils
+  //////////////////////////////////////////////////////////////////////////////
+
+  // Count a new element of the enclosing array, and mark where it starts for sorting.
+  // Map keys count their entry instead, values don't count.
+  void value_begin() {
+    if (frames.empty())
+      return;
+    Frame& top = frames.back();
+    if (top.major != detail::Major::Array)
+      return;
+    top.count++;
+    if (top.sort)
+      marks.push_back(out->size());
+  }
+
+  void entry_begin() {
+    if (frames.empty())
+      return;
+    Frame& top = frames.back();
+    top.count++;
+    if (top.sort)
+      marks.push_back(out->size());
+  }
+
+  void entry_key_end() {
+    if (!frames.empty() && frames.back().sort)
+      marks.push_back(out->size());
+  }
+
+  void container_begin(detail::Major major) {
+    value_begin();
+    // maps are sorted by key in deterministic encoding, arrays keep their order
+    const bool sort = options.deterministic && major == detail::Major::Map;
+    if (options.deterministic) {
+      frames.push_back(Frame{major, sort, false, out->size(), 0, marks.size()});
+      out->push_back(0);
+    }
+    else {
+      frames.push_back(Frame{major, false, true, npos, 0, marks.size()});
+      out->push_back(static_cast<uint8_t>(static_cast<uint8_t>(major) << 5 | detail::code::indefinite));
+    }
+  }
+
+  void container_begin_sized(detail::Major major, size_t len, bool unordered) {
+    value_begin();
+    const bool sort = options.deterministic && (unordered || major == detail::Major::Map);
+    uint8_t buf[detail::head_max_size];
+    out->insert(out->end(), buf, detail::write_head(buf, major, len));
+    frames.push_back(Frame{major, sort, false, npos, 0, marks.size()});
+  }
+
+  void container_end() {
+    if (frames.empty())
+      return;
+    const Frame top = frames.back();
+    frames.pop_back();
+    if (top.sort)
+      sort_elements(top);
+    marks.resize(top.marks_base);
+    if (top.indefinite)
+      return out->push_back(detail::code::break_);
+    if (top.head_pos == npos)
+      return;
+    uint8_t buf[detail::head_max_size];
+    uint8_t* end = detail::write_head(buf, top.major, top.count);
+    // the placeholder is one byte, wider heads shift the elements forward
+    if (end - buf > 1)
+      out->insert(out->begin() + static_cast<ptrdiff_t>(top.head_pos) + 1, buf + 1, end);
+    (*out)[top.head_pos] = buf[0];
+  }
+
+  // Reorder the elements (entries) of the container which just ended by their encoded
+  // bytes (their keys' encoded bytes), bytewise lexicographic as RFC 8949 4.2.1
+  void sort_elements(const Frame& top) {
+    const bool map = top.major == detail::Major::Map;
+    const size_t step = map ? 2 : 1;
+    const size_t num = (marks.size() - top.marks_base) / step;
+    if (num < 2)
+      return;
+    const size_t* m = marks.data() + top.marks_base;
+    const size_t content_end = out->size();
+    // element i spans [start(i), start(i + 1)), its sort key [start(i), key_end(i))
+    auto start = [&](size_t i) { return i < num ? m[i * step] : content_end; };
+    auto key_end = [&](size_t i) { return map ? m[i * step + 1] : start(i + 1); };
+    order.resize(num);
+    for (size_t i = 0; i < num; i++)
+      order[i] = i;
+    const uint8_t* data = out->data();
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+      return std::lexicographical_compare(data + start(a), data + key_end(a), data + start(b), data + key_end(b));
+    });
+    const size_t first = start(0);
+    scratch.clear();
+    for (size_t i : order)
+      scratch.insert(scratch.end(), data + start(i), data + start(i + 1));
+    std::copy(scratch.begin(), scratch.end(), out->begin() + static_cast<ptrdiff_t>(first));
+  }
+
+  void write_byte(uint8_t v) {
+    value_begin();
+    out->push_back(v);
+  }
+
+  void write_uint(uint64_t v) {
+    value_begin();
+    uint8_t buf[detail::head_max_size];
+    out->insert(out->end(), buf, detail::write_head(buf, detail::Major::UInt, v));
+  }
+
+  void write_int(int64_t v) {
+    value_begin();
+    uint8_t buf[detail::head_max_size];
+    out->insert(out->end(), buf, detail::write_int(buf, v));
+  }
+
+  void write_float(double v) {
+    value_begin();
+    uint8_t buf[detail::head_max_size];
+    out->insert(out->end(), buf, detail::write_float(buf, v));
+  }
+
+  void write_block(detail::Major major, const void* val, size_t len) {
+    uint8_t buf[detail::head_max_size];
+    out->insert(out->end(), buf, detail::write_head(buf, major, len));
+    const auto* bytes = static_cast<const uint8_t*>(val);
+    out->insert(out->end(), bytes, bytes + len);
+  }
+
+  // Write the array head and grow the output for len elements of at most
+  // max_size bytes each, returns where the first element goes
+  uint8_t* seq_begin(size_t len, size_t max_size) {
+    value_begin();
+    uint8_t buf[detail::head_max_size];
+    out->insert(out->end(), buf, detail::write_head(buf, detail::Major::Array, len));
+    const size_t pos = out->size();
+    out->resize(pos + len * max_size);
+    return out->data() + pos;
+  }
+
+  template<typename T>
+  void serialize_seq_numbers(const T* vals, size_t len) {
+    // reserve the worst case once, then write without checking the capacity per element
+    uint8_t* p = seq_begin(len, detail::head_max_size);
+    for (size_t i = 0; i < len; i++) {
+      if constexpr (std::is_floating_point_v<T>)
+        p = detail::write_float(p, vals[i]);
+      else if constexpr (std::is_signed_v<T>)
+        p = detail::write_int(p, vals[i]);
+      else
+        p = detail::write_head(p, detail::Major::UInt, vals[i]);
+    }
+    out->resize(static_cast<size_t>(p - out->data()));
+  }
+
+  std::vector<uint8_t>* out;
+  EncodeOptions options;
+  std::vector<Frame> frames;
+  std::vector<size_t> marks;   // element starts (entry starts and key ends for maps) of the containers being sorted
+  std::vector<size_t> order;   // sorting scratch
+  std::vector<uint8_t> scratch;
+};
+
+/// CBOR Serializer function from T to bytes, statically dispatched.
+/// Same output as to_bytes(), with the serializer calls resolved at compile time.
+template<typename T>
+auto to_bytes_static(T&& obj, const EncodeOptions& options = {}) -> cpp::result<std::vector<uint8_t>, serde::Error>
+{
+  std::vector<uint8_t> out;
+  CborSerializer ser(out, options);
+  ser.serialize(std::forward<T>(obj));
+  return out;
+}
+
+/// CBOR Serializer function from T to bytes appended to out, statically dispatched
+template<typename T>
+auto to_bytes_static(T&& obj, std::vector<uint8_t>& out, const EncodeOptions& options = {}) -> cpp::result<void, serde::Error>
+{
+  CborSerializer ser(out, options);
+  ser.serialize(std::forward<T>(obj));
+  return {};
+}
+
+} // namespace serde_cbor
@@ -0,0 +1,23 @@
+#include "serde_cbor/de_cbor.h"
+#include "serde_cbor/deserializer_cbor.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Serde CBOR
+////////////////////////////////////////////////////////////////////////////////
+namespace serde_cbor {
+
+namespace detail {
+
+auto DeserializerNew(const void* data, size_t len) -> std::unique_ptr<serde::Deserializer>
+{
+  return std::make_unique<CborDeserializer>(data, len);
+}
+
+void DeserializerExpectEnd(serde::Deserializer* de)
+{
+  static_cast<CborDeserializer*>(de)->expect_end();
+}
+
+} // namespace detail
+
+} // namespace serde_cbor
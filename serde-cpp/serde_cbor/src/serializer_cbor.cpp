@@ -0,0 +1,18 @@
+#include "serde_cbor/ser_cbor.h"
+#include "serde_cbor/serializer_cbor.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Serde CBOR
+////////////////////////////////////////////////////////////////////////////////
+namespace serde_cbor {
+
+namespace detail {
+
+auto SerializerNew(std::vector<uint8_t>& out, const EncodeOptions& options) -> std::unique_ptr<serde::Serializer>
+{
+  return std::make_unique<CborSerializer>(out, options);
+}
+
+} // namespace detail
+
+} // namespace serde_cbor
@@ -0,0 +1,296 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstring>
+
+#include "serde/std.h"
+#include "serde/serde.h"
+#include "serde_cbor/serde_cbor.h"
+#include "serde_cbor/serializer_cbor.h"
+#include "serde_cbor/deserializer_cbor.h"
+
+using Bytes = std::vector<uint8_t>;
+
+namespace {
+struct Point {
+  int32_t x;
+  int32_t y;
+  std::string label;
+  template<typename S>
+  void serialize(S& ser) const {
+    ser.serialize_struct_begin();
+    ser.serialize_struct_field("x", x);
+    ser.serialize_struct_field("y", y);
+    ser.serialize_struct_field("label", label);
+    ser.serialize_struct_end();
+  }
+  template<typename D>
+  void deserialize(D& de) {
+    de.deserialize_struct_begin();
+    de.deserialize_struct_field("x", x);
+    de.deserialize_struct_field("y", y);
+    de.deserialize_struct_field("label", label);
+    de.deserialize_struct_end();
+  }
+  bool operator==(const Point& o) const { return x == o.x && y == o.y && label == o.label; }
+};
+
+// byte string borrowed from the input
+struct Blob {
+  const uint8_t* data = nullptr;
+  size_t size = 0;
+  void serialize(serde::Serializer& ser) const { ser.serialize_bytes(data, size); }
+  void deserialize(serde::Deserializer& de) {
+    const void* bytes = nullptr;
+    de.deserialize_bytes_borrowed(bytes, size);
+    data = static_cast<const uint8_t*>(bytes);
+  }
+};
+
+// byte string copied into a fixed buffer
+struct Digest {
+  uint8_t data[4] = {};
+  void serialize(serde::Serializer& ser) const { ser.serialize_bytes(data, sizeof(data)); }
+  void deserialize(serde::Deserializer& de) { de.deserialize_bytes(data, sizeof(data)); }
+};
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////////
+// Scalars
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+static void expect_bytes(T val, Bytes expected)
+{
+  auto bytes = serde_cbor::to_bytes(val).value();
+  EXPECT_EQ(bytes, expected);
+  auto de_val = serde_cbor::from_bytes<T>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Builtin, Int_Shortest)
+{
+  expect_bytes<int>(0, {0x00});
+  expect_bytes<int>(23, {0x17});
+  expect_bytes<int>(24, {0x18, 0x18});
+  expect_bytes<int>(100, {0x18, 0x64});
+  expect_bytes<int>(1000, {0x19, 0x03, 0xe8});
+  expect_bytes<int>(1000000, {0x1a, 0x00, 0x0f, 0x42, 0x40});
+  expect_bytes<int64_t>(1000000000000, {0x1b, 0x00, 0x00, 0x00, 0xe8, 0xd4, 0xa5, 0x10, 0x00});
+  expect_bytes<int>(-1, {0x20});
+  expect_bytes<int>(-10, {0x29});
+  expect_bytes<int>(-100, {0x38, 0x63});
+  expect_bytes<int>(-1000, {0x39, 0x03, 0xe7});
+  expect_bytes<int64_t>(INT64_MIN, {0x3b, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff});
+}
+
+TEST(Builtin, Int_AnyWidth)
+{
+  // other encoders may not pick the shortest form, any one is read if the value fits
+  EXPECT_EQ(serde_cbor::from_bytes<uint8_t>(Bytes{0x1b, 0, 0, 0, 0, 0, 0, 0, 200}).value(), 200);
+  EXPECT_EQ(serde_cbor::from_bytes<int16_t>(Bytes{0x3a, 0, 0, 0, 1}).value(), -2);
+  EXPECT_EQ(serde_cbor::from_bytes<double>(Bytes{0x24}).value(), -5.0);
+  EXPECT_EQ(serde_cbor::from_bytes<float>(Bytes{0xfb, 0x3f, 0xf8, 0, 0, 0, 0, 0, 0}).value(), 1.5f);
+  // tag 1 (epoch time), tags are skipped
+  EXPECT_EQ(serde_cbor::from_bytes<int64_t>(Bytes{0xc1, 0x1a, 0x51, 0x4b, 0x67, 0xb0}).value(), 1363896240);
+}
+
+TEST(Builtin, Float_ShortestWidth)
+{
+  expect_bytes<double>(0.0, {0xf9, 0x00, 0x00});
+  expect_bytes<double>(-0.0, {0xf9, 0x80, 0x00});
+  expect_bytes<double>(1.0, {0xf9, 0x3c, 0x00});
+  expect_bytes<double>(1.5, {0xf9, 0x3e, 0x00});
+  expect_bytes<double>(65504.0, {0xf9, 0x7b, 0xff});
+  expect_bytes<double>(5.960464477539063e-8, {0xf9, 0x00, 0x01}); // smallest half subnormal
+  expect_bytes<double>(0.00006103515625, {0xf9, 0x04, 0x00});
+  expect_bytes<double>(-4.0, {0xf9, 0xc4, 0x00});
+  expect_bytes<double>(100000.0, {0xfa, 0x47, 0xc3, 0x50, 0x00});
+  expect_bytes<double>(3.4028234663852886e+38, {0xfa, 0x7f, 0x7f, 0xff, 0xff});
+  expect_bytes<double>(1.1, {0xfb, 0x3f, 0xf1, 0x99, 0x99, 0x99, 0x99, 0x99, 0x9a});
+  expect_bytes<double>(1.0e+300, {0xfb, 0x7e, 0x37, 0xe4, 0x3c, 0x88, 0x00, 0x75, 0x9c});
+  expect_bytes<double>(-4.1, {0xfb, 0xc0, 0x10, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66});
+  expect_bytes<float>(0.1f, {0xfa, 0x3d, 0xcc, 0xcc, 0xcd});
+  expect_bytes<double>(INFINITY, {0xf9, 0x7c, 0x00});
+  expect_bytes<double>(-INFINITY, {0xf9, 0xfc, 0x00});
+  auto nan = serde_cbor::to_bytes(std::nan("")).value();
+  EXPECT_EQ(nan, (Bytes{0xf9, 0x7e, 0x00}));
+  EXPECT_TRUE(std::isnan(serde_cbor::from_bytes<double>(nan).value()));
+}
+
+TEST(Builtin, Float_Seq)
+{
+  using Type = std::vector<double>;
+  const Type val = {1.5, 100000.0, 1.1};
+  auto bytes = serde_cbor::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0x83, 0xf9, 0x3e, 0x00, 0xfa, 0x47, 0xc3, 0x50, 0x00,
+                          0xfb, 0x3f, 0xf1, 0x99, 0x99, 0x99, 0x99, 0x99, 0x9a}));
+  EXPECT_EQ(serde_cbor::from_bytes<Type>(bytes).value(), val);
+}
+
+TEST(Builtin, Bool_Char)
+{
+  expect_bytes<bool>(false, {0xf4});
+  expect_bytes<bool>(true, {0xf5});
+  expect_bytes<char>('A', {0x18, 0x41});
+  expect_bytes<unsigned char>(250, {0x18, 0xfa});
+}
+
+TEST(Builtin, Bytes_ByteString)
+{
+  const uint8_t data[] = {1, 2, 3, 4};
+  auto bytes = serde_cbor::to_bytes(Blob{data, sizeof(data)}).value();
+  EXPECT_EQ(bytes, (Bytes{0x44, 1, 2, 3, 4}));
+  auto blob = serde_cbor::from_bytes<Blob>(bytes).value();
+  ASSERT_EQ(blob.size, 4u);
+  EXPECT_EQ(blob.data, bytes.data() + 1); // borrowed, not copied
+  EXPECT_EQ(std::memcmp(blob.data, data, 4), 0);
+
+  // (_ h'0102', h'0304') is copied chunk by chunk
+  auto digest = serde_cbor::from_bytes<Digest>(Bytes{0x5f, 0x42, 1, 2, 0x42, 3, 4, 0xff}).value();
+  EXPECT_EQ(std::memcmp(digest.data, data, 4), 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Structs
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Builtin, Struct_IndefiniteMap)
+{
+  const Point val{1, -2, "p"};
+  auto bytes = serde_cbor::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0xbf, 0x61, 'x', 0x01, 0x61, 'y', 0x21, 0x65, 'l', 'a', 'b', 'e', 'l', 0x61, 'p', 0xff}));
+  EXPECT_EQ(serde_cbor::from_bytes<Point>(bytes).value(), val);
+  EXPECT_EQ(serde_cbor::from_bytes_static<Point>(bytes).value(), val);
+}
+
+TEST(Builtin, Struct_FieldsOutOfOrder)
+{
+  // {"label": "q", "extra": [1, {"a": null}], "y": 7, "x": 8}, as a dict from another language
+  const Bytes bytes = {0xa4, 0x65, 'l', 'a', 'b', 'e', 'l', 0x61, 'q',
+                       0x65, 'e', 'x', 't', 'r', 'a', 0x82, 0x01, 0xa1, 0x61, 'a', 0xf6,
+                       0x61, 'y', 0x07, 0x61, 'x', 0x08};
+  const Point val{8, 7, "q"};
+  EXPECT_EQ(serde_cbor::from_bytes<Point>(bytes).value(), val);
+  using Many = std::vector<Point>;
+  Bytes many = {0x82};
+  many.insert(many.end(), bytes.begin(), bytes.end());
+  many.insert(many.end(), bytes.begin(), bytes.end());
+  EXPECT_EQ(serde_cbor::from_bytes<Many>(many).value(), (Many{val, val}));
+}
+
+TEST(Builtin, Struct_NestedIndefinite)
+{
+  // indefinite maps are counted as their entries are read, nested ones included
+  using Nested = std::vector<std::pair<Point, std::optional<Point>>>;
+  const Nested val = {{{1, 2, "a"}, Point{3, 4, "b"}}, {{5, 6, "c"}, std::nullopt}};
+  auto bytes = serde_cbor::to_bytes(val).value();
+  EXPECT_EQ(serde_cbor::from_bytes<Nested>(bytes).value(), val);
+  EXPECT_EQ(serde_cbor::from_bytes_static<Nested>(bytes).value(), val);
+
+  // {_ "extra": {_ "a": 1}, "label": "q", "y": 7, "x": 8}, out of order with an unknown field
+  const Bytes out_of_order = {0xbf, 0x65, 'e', 'x', 't', 'r', 'a', 0xbf, 0x61, 'a', 0x01, 0xff,
+                              0x65, 'l', 'a', 'b', 'e', 'l', 0x61, 'q',
+                              0x61, 'y', 0x07, 0x61, 'x', 0x08, 0xff};
+  EXPECT_EQ(serde_cbor::from_bytes<Point>(out_of_order).value(), (Point{8, 7, "q"}));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Deterministic encoding
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Builtin, Deterministic_Struct)
+{
+  // definite length, fields sorted by their encoded key: shorter keys first
+  const Point val{1, -2, "p"};
+  auto bytes = serde_cbor::to_bytes(val, serde_cbor::EncodeOptions::canonical()).value();
+  EXPECT_EQ(bytes, (Bytes{0xa3, 0x61, 'x', 0x01, 0x61, 'y', 0x21, 0x65, 'l', 'a', 'b', 'e', 'l', 0x61, 'p'}));
+  EXPECT_EQ(serde_cbor::from_bytes<Point>(bytes).value(), val);
+}
+
+TEST(Builtin, Deterministic_UnorderedMap)
+{
+  using Type = std::unordered_map<std::string, int>;
+  const std::vector<std::pair<std::string, int>> entries = {{"aa", 3}, {"b", 2}, {"a", 1}, {"c", 4}, {"ab", 5}};
+  // the same entries inserted in different orders (and buckets) encode to the same bytes
+  Type forward(entries.begin(), entries.end());
+  Type backward(entries.rbegin(), entries.rend(), 64);
+  const auto options = serde_cbor::EncodeOptions::canonical();
+  auto bytes = serde_cbor::to_bytes(forward, options).value();
+  EXPECT_EQ(serde_cbor::to_bytes(backward, options).value(), bytes);
+  EXPECT_EQ(serde_cbor::to_bytes(std::map<std::string, int>(forward.begin(), forward.end()), options).value(), bytes);
+  EXPECT_EQ(bytes, (Bytes{0xa5, 0x61, 'a', 0x01, 0x61, 'b', 0x02, 0x61, 'c', 0x04,
+                          0x62, 'a', 'a', 0x03, 0x62, 'a', 'b', 0x05}));
+  EXPECT_EQ(serde_cbor::from_bytes<Type>(bytes).value(), forward);
+  EXPECT_EQ(serde_cbor::to_bytes_static(backward, options).value(), bytes);
+}
+
+TEST(Builtin, Deterministic_UnorderedSet)
+{
+  using Type = std::unordered_set<int>;
+  Type val;
+  for (int i = -300; i <= 300; i += 7)
+    val.insert(i);
+  const auto options = serde_cbor::EncodeOptions::canonical();
+  auto bytes = serde_cbor::to_bytes(val, options).value();
+  Type rehashed(val.begin(), val.end(), 1024);
+  EXPECT_EQ(serde_cbor::to_bytes(rehashed, options).value(), bytes);
+  EXPECT_EQ(serde_cbor::from_bytes<Type>(bytes).value(), val);
+  // ordered sequences keep their order
+  EXPECT_EQ(serde_cbor::to_bytes(std::vector<int>{3, 1, 2}, options).value(), (Bytes{0x83, 3, 1, 2}));
+}
+
+TEST(Builtin, Deterministic_Nested)
+{
+  using Type = std::unordered_map<int, std::unordered_map<std::string, Point>>;
+  Type a, b;
+  for (int i = 0; i < 40; i++) {
+    a[i]["p" + std::to_string(i)] = Point{i, -i, std::string(size_t(i), 'z')};
+    a[i]["q"] = Point{0, 0, ""};
+  }
+  for (int i = 39; i >= 0; i--) {
+    b[i]["q"] = Point{0, 0, ""};
+    b[i]["p" + std::to_string(i)] = Point{i, -i, std::string(size_t(i), 'z')};
+  }
+  const auto options = serde_cbor::EncodeOptions::canonical();
+  auto bytes = serde_cbor::to_bytes(a, options).value();
+  EXPECT_EQ(serde_cbor::to_bytes(b, options).value(), bytes);
+  EXPECT_EQ(bytes[0], 0xb8); // map, 1 byte length
+  EXPECT_EQ(bytes[1], 40);
+  EXPECT_EQ(bytes[2], 0x00); // key 0 first
+  auto de_val = serde_cbor::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val.size(), 40u);
+  EXPECT_EQ(de_val.at(7).at("p7"), (Point{7, -7, "zzzzzzz"}));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Static / reuse
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Builtin, Static_SameBytes)
+{
+  using Type = std::map<std::string, std::vector<std::optional<Point>>>;
+  const Type val = {{"a", {Point{1, 2, "one"}, std::nullopt}}, {"b", {}}};
+  auto bytes = serde_cbor::to_bytes(val).value();
+  EXPECT_EQ(serde_cbor::to_bytes_static(val).value(), bytes);
+  EXPECT_EQ(serde_cbor::from_bytes_static<Type>(bytes).value(), val);
+}
+
+TEST(Builtin, Reuse_Serializer)
+{
+  Bytes out;
+  serde_cbor::CborSerializer ser(out);
+  serde_cbor::CborDeserializer de;
+  for (int i = 0; i < 3; i++) {
+    out.clear();
+    ser.reset();
+    ser.set_options(i % 2 ? serde_cbor::EncodeOptions::canonical() : serde_cbor::EncodeOptions{});
+    ser.serialize(Point{i, i, "r"});
+    EXPECT_EQ(out.front(), i % 2 ? 0xa3 : 0xbf);
+    de.reset(out.data(), out.size());
+    Point val{};
+    de.deserialize(val);
+    de.expect_end();
+    ASSERT_FALSE(de.has_error());
+    EXPECT_EQ(val, (Point{i, i, "r"}));
+  }
+}
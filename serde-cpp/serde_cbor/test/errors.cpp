@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include "serde/std.h"
+#include "serde/serde.h"
+#include "serde_cbor/serde_cbor.h"
+#include "serde_cbor/deserializer_cbor.h"
+
+using Bytes = std::vector<uint8_t>;
+
+namespace {
+struct Pos {
+  int x = 0;
+  int y = 0;
+  template<typename D>
+  void deserialize(D& de) {
+    de.deserialize_struct_begin();
+    de.deserialize_struct_field("x", x);
+    de.deserialize_struct_field("y", y);
+    de.deserialize_struct_end();
+  }
+};
+} // namespace
+
+TEST(Errors, Truncated)
+{
+  auto res = serde_cbor::from_bytes<std::string>(Bytes{0x65, 'H', 'e'});
+  ASSERT_TRUE(res.has_error());
+  EXPECT_EQ(res.error().text, "unexpected end of input");
+  EXPECT_EQ(res.error().column, 1u);
+  EXPECT_EQ(serde_cbor::from_bytes<int>(Bytes{0x19, 0x01}).error().text, "unexpected end of input");
+  EXPECT_EQ(serde_cbor::from_bytes<int>(Bytes{}).error().text, "unexpected end of input");
+  EXPECT_EQ(serde_cbor::from_bytes<std::vector<int>>(Bytes{0x83, 1, 2}).error().text, "length exceeds input");
+  EXPECT_EQ(serde_cbor::from_bytes<std::vector<int>>(Bytes{0x9f, 1, 2}).error().text, "unexpected end of input");
+  EXPECT_EQ(serde_cbor::from_bytes<Pos>(Bytes{0xbf, 0x61, 'x', 1}).error().text, "unexpected end of input");
+  EXPECT_EQ(serde_cbor::from_bytes<Pos>(Bytes{0xbf, 0x61, 'y', 2, 0x61, 'x', 1}).error().text, "unexpected end of input");
+}
+
+TEST(Errors, CorruptLength)
+{
+  // an array of 4G elements must fail before resizing the vector to it
+  auto res = serde_cbor::from_bytes<std::vector<std::string>>(Bytes{0x9a, 0xff, 0xff, 0xff, 0xff, 0x60});
+  ASSERT_TRUE(res.has_error());
+  EXPECT_EQ(res.error().text, "length exceeds input");
+  using Map = std::map<int, int>;
+  EXPECT_EQ(serde_cbor::from_bytes<Map>(Bytes{0xa2, 1, 2, 3}).error().text, "length exceeds input");
+}
+
+TEST(Errors, WrongType)
+{
+  EXPECT_EQ(serde_cbor::from_bytes<int>(Bytes{0x61, '1'}).error().text, "expected an integer");
+  EXPECT_EQ(serde_cbor::from_bytes<bool>(Bytes{0x01}).error().text, "expected a bool");
+  EXPECT_EQ(serde_cbor::from_bytes<std::string>(Bytes{0x41, 'a'}).error().text, "expected a string");
+  EXPECT_EQ(serde_cbor::from_bytes<std::vector<int>>(Bytes{0xa0}).error().text, "expected an array");
+  EXPECT_EQ(serde_cbor::from_bytes<Pos>(Bytes{0x80}).error().text, "expected a map");
+  EXPECT_EQ(serde_cbor::from_bytes<double>(Bytes{0xf6}).error().text, "expected a float");
+  EXPECT_EQ(serde_cbor::from_bytes<int>(Bytes{0x1c}).error().text, "invalid head");
+}
+
+TEST(Errors, NumberOutOfRange)
+{
+  EXPECT_EQ(serde_cbor::from_bytes<int16_t>(Bytes{0x19, 0x80, 0x00}).error().text, "number out of range");
+  EXPECT_EQ(serde_cbor::from_bytes<uint32_t>(Bytes{0x20}).error().text, "number out of range");
+  EXPECT_EQ(serde_cbor::from_bytes<int64_t>(Bytes{0x3b, 0x80, 0, 0, 0, 0, 0, 0, 0}).error().text, "number out of range");
+  EXPECT_EQ(serde_cbor::from_bytes<std::vector<uint8_t>>(Bytes{0x82, 1, 0x19, 0x01, 0x00}).error().text, "number out of range");
+}
+
+TEST(Errors, IndefiniteNotBorrowed)
+{
+  using Type = std::string_view;
+  const Bytes bytes = {0x7f, 0x61, 'a', 0xff};
+  EXPECT_EQ(serde_cbor::from_bytes<Type>(bytes).error().text, "indefinite length string can't be borrowed");
+  EXPECT_EQ(serde_cbor::from_bytes<std::string>(Bytes{0x7f, 0x41, 'a', 0xff}).error().text, "invalid string chunk");
+}
+
+TEST(Errors, MissingField)
+{
+  const Bytes bytes = {0xa2, 0x61, 'x', 0x01, 0x61, 'z', 0x02};
+  auto res = serde_cbor::from_bytes<Pos>(bytes);
+  ASSERT_TRUE(res.has_error());
+  EXPECT_EQ(res.error().text, "key not found in map: y");
+  EXPECT_EQ(res.error().column, 1u);
+  EXPECT_EQ(serde_cbor::from_bytes_static<Pos>(bytes).error().text, res.error().text);
+}
+
+TEST(Errors, SequenceLengthMismatch)
+{
+  using Type = std::array<int, 3>;
+  EXPECT_EQ(serde_cbor::from_bytes<Type>(Bytes{0x82, 1, 2}).error().text, "sequence length mismatch");
+  EXPECT_EQ(serde_cbor::from_bytes<Type>(Bytes{0x9f, 1, 2, 3, 4, 0xff}).error().text, "sequence length mismatch");
+}
+
+TEST(Errors, TrailingBytes)
+{
+  auto res = serde_cbor::from_bytes<int>(Bytes{0x01, 0x02});
+  ASSERT_TRUE(res.has_error());
+  EXPECT_EQ(res.error().text, "trailing bytes after value");
+  EXPECT_EQ(res.error().column, 2u);
+}
@@ -0,0 +1,311 @@
+#include <gtest/gtest.h>
+
+#include "serde/std.h"
+#include "serde/serde.h"
+#include "serde_cbor/serde_cbor.h"
+#include "serde_cbor/deserializer_cbor.h"
+
+using Bytes = std::vector<uint8_t>;
+
+// Expected bytes are from the examples of RFC 8949 Appendix A where there is one
+
+///////////////////////////////////////////////////////////////////////////////
+// std::string
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, String_Value)
+{
+  using Type = std::string;
+  const Type val = "IETF";
+  auto bytes = serde_cbor::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0x64, 'I', 'E', 'T', 'F'}));
+  auto de_val = serde_cbor::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, String_Empty_Utf8)
+{
+  using Type = std::string;
+  EXPECT_EQ(serde_cbor::to_bytes(Type{}).value(), (Bytes{0x60}));
+  EXPECT_EQ(serde_cbor::to_bytes(Type("ü")).value(), (Bytes{0x62, 0xc3, 0xbc}));
+  EXPECT_EQ(serde_cbor::from_bytes<Type>(Bytes{0x62, 0xc3, 0xbc}).value(), "ü");
+}
+
+TEST(Std, String_Long)
+{
+  using Type = std::string;
+  for (size_t len : {23u, 24u, 255u, 256u, 65535u, 65536u}) {
+    const Type val(len, 'x');
+    auto bytes = serde_cbor::to_bytes(val).value();
+    const size_t head = len < 24 ? 1 : len <= 255 ? 2 : len <= 65535 ? 3 : 5;
+    EXPECT_EQ(bytes.size(), head + len);
+    auto de_val = serde_cbor::from_bytes<Type>(bytes).value();
+    EXPECT_EQ(de_val, val);
+  }
+}
+
+TEST(Std, String_Indefinite)
+{
+  // (_ "strea", "ming")
+  const Bytes bytes = {0x7f, 0x65, 's', 't', 'r', 'e', 'a', 0x64, 'm', 'i', 'n', 'g', 0xff};
+  EXPECT_EQ(serde_cbor::from_bytes<std::string>(bytes).value(), "streaming");
+  EXPECT_EQ(serde_cbor::from_bytes_static<std::string>(bytes).value(), "streaming");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::string_view
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, StringView_Borrowed)
+{
+  using Type = std::map<std::string_view, std::vector<std::string_view>>;
+  const Type val = {{"first", {"a", "bb"}}, {"second", {"ccc"}}};
+  auto bytes = serde_cbor::to_bytes(val).value();
+  auto de_val = serde_cbor::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+  // the views point into the input bytes
+  const auto* data = reinterpret_cast<const char*>(bytes.data());
+  EXPECT_GE(de_val.at("second").at(0).data(), data);
+  EXPECT_LT(de_val.at("second").at(0).data(), data + bytes.size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::unique_ptr / std::shared_ptr / std::optional
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, UniquePtr_Empty)
+{
+  using Type = std::unique_ptr<std::string>;
+  const Type val = {};
+  auto bytes = serde_cbor::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0xf6})); // null
+  auto de_val = serde_cbor::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, SharedPtr_Value)
+{
+  using Type = std::shared_ptr<int>;
+  const Type val = std::make_shared<int>(-1000);
+  auto bytes = serde_cbor::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0x39, 0x03, 0xe7}));
+  auto de_val = serde_cbor::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(*de_val, *val);
+}
+
+TEST(Std, Optional_Value)
+{
+  using Type = std::vector<std::optional<int>>;
+  const Type val = {10, std::nullopt, 1000};
+  auto bytes = serde_cbor::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0x83, 0x0a, 0xf6, 0x19, 0x03, 0xe8}));
+  auto de_val = serde_cbor::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+  // undefined is none as well
+  EXPECT_EQ(serde_cbor::from_bytes<Type>(Bytes{0x81, 0xf7}).value(), (Type{std::nullopt}));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::array / std::vector
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, Array_Value)
+{
+  using Type = std::array<int32_t, 3>;
+  const Type val = {1, 2, 3};
+  auto bytes = serde_cbor::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0x83, 0x01, 0x02, 0x03}));
+  auto de_val = serde_cbor::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Array_Bool)
+{
+  using Type = std::array<bool, 3>;
+  const Type val = {true, false, true};
+  auto bytes = serde_cbor::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0x83, 0xf5, 0xf4, 0xf5}));
+  auto de_val = serde_cbor::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Vector_Empty)
+{
+  using Type = std::vector<size_t>;
+  const Type val = {};
+  auto bytes = serde_cbor::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0x80}));
+  auto de_val = serde_cbor::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Vector_Limits)
+{
+  using Type = std::vector<int64_t>;
+  const Type val = {INT64_MIN, INT32_MIN, -1000, -100, -25, -24, -1, 0, 23, 24, 100, 1000, 1000000, 1000000000000, INT64_MAX};
+  auto bytes = serde_cbor::to_bytes(val).value();
+  auto de_val = serde_cbor::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+  auto u64_bytes = serde_cbor::to_bytes(std::vector<uint64_t>{UINT64_MAX}).value();
+  EXPECT_EQ(u64_bytes, (Bytes{0x81, 0x1b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}));
+  EXPECT_EQ(serde_cbor::from_bytes<std::vector<uint64_t>>(u64_bytes).value().at(0), UINT64_MAX);
+}
+
+TEST(Std, Vector_Nested)
+{
+  using Type = std::vector<std::vector<int>>;
+  const Type val = {{1}, {2, 3}, {4, 5}};
+  auto bytes = serde_cbor::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0x83, 0x81, 0x01, 0x82, 0x02, 0x03, 0x82, 0x04, 0x05}));
+  auto de_val = serde_cbor::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Vector_Indefinite)
+{
+  // [_ [1], [2, 3], [_ 4, 5]]
+  using Type = std::vector<std::vector<int>>;
+  const Bytes bytes = {0x9f, 0x81, 0x01, 0x82, 0x02, 0x03, 0x9f, 0x04, 0x05, 0xff, 0xff};
+  EXPECT_EQ(serde_cbor::from_bytes<Type>(bytes).value(), (Type{{1}, {2, 3}, {4, 5}}));
+  EXPECT_EQ(serde_cbor::from_bytes<Type>(Bytes{0x9f, 0xff}).value(), Type{});
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::variant / std::tuple / std::pair
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, Variant_Index)
+{
+  using Type = std::variant<char, int, std::string>;
+  const Type val = "Hi";
+  auto bytes = serde_cbor::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0xa1, 0x02, 0x62, 'H', 'i'})); // {2: "Hi"}
+  auto de_val = serde_cbor::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Tuple_Value)
+{
+  using Type = std::tuple<char, int, std::string>;
+  const Type val = {'z', 3467, "T"};
+  auto bytes = serde_cbor::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0x83, 0x18, 'z', 0x19, 0x0d, 0x8b, 0x61, 'T'}));
+  auto de_val = serde_cbor::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Pair_Value)
+{
+  using Type = std::pair<int, std::string>;
+  const Type val = {69, "x"};
+  auto bytes = serde_cbor::to_bytes(val).value();
+  // {_ "first": 69, "second": "x"}
+  EXPECT_EQ(bytes, (Bytes{0xbf, 0x65, 'f', 'i', 'r', 's', 't', 0x18, 69, 0x66, 's', 'e', 'c', 'o', 'n', 'd', 0x61, 'x', 0xff}));
+  auto de_val = serde_cbor::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Containers
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, List_Value)
+{
+  using Type = std::list<int>;
+  const Type val = {7, 9, 4, -1};
+  auto bytes = serde_cbor::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0x84, 7, 9, 4, 0x20}));
+  auto de_val = serde_cbor::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, ForwardList_Value)
+{
+  // unknown size, indefinite length
+  using Type = std::forward_list<int>;
+  const Type val = {7, 9, 4, -1};
+  auto bytes = serde_cbor::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0x9f, 7, 9, 4, 0x20, 0xff}));
+  auto de_val = serde_cbor::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, ForwardList_Deterministic)
+{
+  // definite length, the head is widened to 2 bytes at the end
+  using Type = std::vector<std::forward_list<int>>;
+  Type val(2);
+  for (int i = 0; i < 30; i++)
+    val[0].push_front(i);
+  val[1] = {1};
+  auto bytes = serde_cbor::to_bytes(val, serde_cbor::EncodeOptions::canonical()).value();
+  EXPECT_EQ((Bytes{bytes.begin(), bytes.begin() + 3}), (Bytes{0x82, 0x98, 30}));
+  EXPECT_EQ((Bytes{bytes.end() - 2, bytes.end()}), (Bytes{0x81, 0x01}));
+  auto de_val = serde_cbor::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Set_Value)
+{
+  using Type = std::set<std::string>;
+  const Type val = {"b", "a"};
+  auto bytes = serde_cbor::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0x82, 0x61, 'a', 0x61, 'b'}));
+  auto de_val = serde_cbor::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, UnorderedSet_Value)
+{
+  using Type = std::unordered_set<int>;
+  const Type val = {5, 600, -70000};
+  auto bytes = serde_cbor::to_bytes(val).value();
+  auto de_val = serde_cbor::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Map_Value)
+{
+  using Type = std::map<std::string, std::vector<int>>;
+  const Type val = {{"a", {1}}, {"b", {2, 3}}};
+  auto bytes = serde_cbor::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0xa2, 0x61, 'a', 0x81, 0x01, 0x61, 'b', 0x82, 0x02, 0x03}));
+  auto de_val = serde_cbor::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Map_IntKeys)
+{
+  using Type = std::map<int, int>;
+  const Type val = {{1, 2}, {3, 4}};
+  auto bytes = serde_cbor::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0xa2, 0x01, 0x02, 0x03, 0x04}));
+  auto de_val = serde_cbor::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Map_Indefinite)
+{
+  // {_ "a": 1, "b": [_ 2, 3]}
+  using Type = std::map<std::string, std::vector<int>>;
+  const Bytes bytes = {0xbf, 0x61, 'a', 0x81, 0x01, 0x61, 'b', 0x9f, 0x02, 0x03, 0xff, 0xff};
+  EXPECT_EQ(serde_cbor::from_bytes<Type>(bytes).value(), (Type{{"a", {1}}, {"b", {2, 3}}}));
+}
+
+TEST(Std, UnorderedMultiMap_Value)
+{
+  using Type = std::unordered_multimap<short int, std::string>;
+  const Type val = {{1, "one"}, {1, "uno"}, {2, "two"}};
+  auto bytes = serde_cbor::to_bytes(val).value();
+  auto de_val = serde_cbor::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Deque_Queue_Stack)
+{
+  const std::deque<std::string> val = {"clubs", "queen", "king"};
+  auto bytes = serde_cbor::to_bytes(val).value();
+  EXPECT_EQ(serde_cbor::from_bytes<std::deque<std::string>>(bytes).value(), val);
+  EXPECT_EQ(serde_cbor::from_bytes<std::queue<std::string>>(bytes).value(), std::queue<std::string>(val));
+  EXPECT_EQ(serde_cbor::from_bytes<std::stack<std::string>>(bytes).value(), std::stack<std::string>(val));
+}
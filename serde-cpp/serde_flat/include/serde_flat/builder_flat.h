@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <serde/error.h>
+#include <serde/result.hpp>
+
+#include "layout.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Serde Flat
+////////////////////////////////////////////////////////////////////////////////
+namespace serde_flat {
+
+namespace detail {
+
+/// Writes a struct and everything it refers to as a flat buffer appended to out.
+/// Tables, strings and vectors are written after the slot referring to them,
+/// so offsets always point forward.
+class Builder {
+public:
+  explicit Builder(std::vector<uint8_t>& out) : out(&out), base(out.size()) {}
+
+  template<typename T>
+  void build(const T& root) {
+    reserve(4, 4);
+    store_offset(base, write_table(root));
+  }
+
+  /// Whether the buffer grew beyond what u32 offsets address
+  bool overflow() const { return out->size() - base > UINT32_MAX; }
+
+private:
+  // Append zeroed space of size bytes, placed so that pos + skew is aligned (relative to the
+  // buffer start). Returns its position in out.
+  size_t reserve(size_t size, size_t align, size_t skew = 0) {
+    const size_t rel = out->size() - base + skew;
+    const size_t pos = out->size() + (align - rel % align) % align;
+    out->resize(pos + size);
+    return pos;
+  }
+
+  void store_offset(size_t pos, size_t target) {
+    store(out->data() + pos, static_cast<uint32_t>(target - base));
+  }
+
+  template<typename T>
+  size_t write_table(const T& obj) {
+    using Layout = TableLayout<T>;
+    // u32 size, then the fields table_align aligned
+    const size_t table = reserve(4 + Layout::offsets.size, table_align, 4);
+    store(out->data() + table, Layout::offsets.size);
+    write_fields(obj, table + 4, std::make_index_sequence<Layout::count>{});
+    return table;
+  }
+
+  template<typename T, size_t... I>
+  void write_fields(const T& obj, size_t fields, std::index_sequence<I...>) {
+    using Layout = TableLayout<T>;
+    constexpr auto members = Table<T>::fields();
+    (write_slot(fields + Layout::offsets.offset[I], obj.*std::get<I>(members)), ...);
+  }
+
+  template<typename F>
+  void write_slot(size_t pos, const F& val) {
+    using S = Slot<F>;
+    if constexpr (S::kind == Kind::Scalar) {
+      store(out->data() + pos, val);
+    }
+    else if constexpr (S::kind == Kind::String) {
+      store_offset(pos, write_string(val.data(), val.size()));
+    }
+    else if constexpr (S::kind == Kind::Vector) {
+      store_offset(pos, write_vector<typename S::element_type>(val));
+    }
+    else if constexpr (S::kind == Kind::Optional) {
+      if (val) {
+        using E = typename S::element_type;
+        const size_t target = reserve(Slot<E>::size, Slot<E>::align);
+        write_slot(target, *val);
+        store_offset(pos, target);
+      }
+    }
+    else {
+      store_offset(pos, write_table(val));
+    }
+  }
+
+  size_t write_string(const char* str, size_t len) {
+    const size_t pos = reserve(4 + len + 1, 4);
+    store(out->data() + pos, static_cast<uint32_t>(len));
+    if (len)
+      std::memcpy(out->data() + pos + 4, str, len);
+    return pos;
+  }
+
+  template<typename E, typename V>
+  size_t write_vector(const V& vec) {
+    using S = Slot<E>;
+    constexpr size_t align = S::align > 4 ? S::align : 4;
+    // u32 count, then the elements aligned
+    const size_t pos = reserve(4 + vec.size() * S::size, align, 4);
+    store(out->data() + pos, static_cast<uint32_t>(vec.size()));
+    if constexpr (S::kind == Kind::Scalar && !std::is_same_v<E, bool> && !big_endian) {
+      if (!vec.empty())
+        std::memcpy(out->data() + pos + 4, vec.data(), vec.size() * sizeof(E));
+    }
+    else {
+      size_t slot = pos + 4;
+      for (const auto& e : vec) {
+        write_slot(slot, e);
+        slot += S::size;
+      }
+    }
+    return pos;
+  }
+
+  std::vector<uint8_t>* out;
+  size_t base; // start of the buffer in out
+};
+
+} // namespace detail
+
+/// Flat buffer of obj, to be read with from_bytes<T>() without parsing, see serde_flat/layout.h
+template<typename T>
+auto to_bytes(const T& obj) -> cpp::result<std::vector<uint8_t>, serde::Error>
+{
+  std::vector<uint8_t> out;
+  detail::Builder builder(out);
+  builder.build(obj);
+  if (builder.overflow())
+    return cpp::fail(serde::Error{serde::Error::Kind::Invalid, 0, 0, "flat buffer exceeds 4 GiB"});
+  return out;
+}
+
+/// Flat buffer of obj appended to out.
+/// Reusing out (cleared) across calls avoids allocating once its capacity is warmed up.
+template<typename T>
+auto to_bytes(const T& obj, std::vector<uint8_t>& out) -> cpp::result<void, serde::Error>
+{
+  detail::Builder builder(out);
+  builder.build(obj);
+  if (builder.overflow())
+    return cpp::fail(serde::Error{serde::Error::Kind::Invalid, 0, 0, "flat buffer exceeds 4 GiB"});
+  return {};
+}
+
+} // namespace serde_flat
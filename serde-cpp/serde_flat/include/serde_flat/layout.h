@@ -0,0 +1,225 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+// Serde Flat
+////////////////////////////////////////////////////////////////////////////////
+//
+// Flat buffer layout, all integers little-endian:
+//
+//   buffer    u32 offset of the root table, then the tables, strings and vectors it refers to
+//   table     u32 size of its fields, then its fields at fixed positions (natural alignment)
+//   string    u32 length, then the chars and a '\0' (not counted in the length)
+//   vector    u32 count, then the elements at fixed positions (natural alignment)
+//
+// A field (or vector element) is stored in a slot:
+//
+//   scalar    the value (bool is one byte 0/1, enums their underlying integer)
+//   string    u32 offset of the string
+//   vector    u32 offset of the vector
+//   optional  u32 offset of a slot holding the value, 0 if none
+//   struct    u32 offset of its table
+//
+// Offsets count from the start of the buffer. Fields are laid out in declaration order, so
+// fields appended to a struct are read as their defaults from buffers written before them.
+//
+namespace serde_flat {
+
+/// Fields of a struct, as member pointers, e.g. for `struct Point { int x; int y; };`:
+///
+///   template<typename T>
+///   struct Table<T, std::enable_if_t<std::is_same_v<T, Point>>> {
+///     static constexpr auto fields() { return std::make_tuple(&T::x, &T::y); }
+///   };
+///
+/// serde_gen generates it for [[serde]] structs with --flat.
+template<typename T, typename = void>
+struct Table {};
+
+/// Read-only view of a struct table in a flat buffer, see TableView.
+/// serde_gen generates a specialization with a named accessor per field.
+template<typename T, typename = void>
+class View;
+
+template<typename T>
+class VectorView;
+
+namespace detail {
+
+template<typename T, typename = void>
+struct IsTable : std::false_type {};
+template<typename T>
+struct IsTable<T, std::void_t<decltype(Table<T>::fields())>> : std::true_type {};
+
+template<typename M>
+struct MemberType;
+template<typename C, typename F>
+struct MemberType<F C::*> {
+  using type = F;
+};
+
+template<typename T>
+inline constexpr bool dependent_false = false;
+
+enum class Kind { Scalar, String, Vector, Optional, Table };
+
+/// Slot of a field of type T: kind, size and alignment, and the type its view returns
+template<typename T, typename = void>
+struct Slot {
+  static_assert(dependent_false<T>, "serde_flat: unsupported field type, see serde_flat/layout.h");
+};
+
+template<typename T>
+struct Slot<T, std::enable_if_t<(std::is_arithmetic_v<T> && !std::is_same_v<T, long double>) || std::is_enum_v<T>>> {
+  static constexpr Kind kind = Kind::Scalar;
+  static constexpr size_t size = sizeof(T);
+  static constexpr size_t align = sizeof(T);
+  using view_type = T;
+};
+
+template<typename T>
+struct OffsetSlot {
+  static constexpr size_t size = 4;
+  static constexpr size_t align = 4;
+};
+
+template<typename... U>
+struct Slot<std::basic_string<char, U...>> : OffsetSlot<void> {
+  static constexpr Kind kind = Kind::String;
+  using view_type = std::string_view;
+};
+template<>
+struct Slot<std::string_view> : OffsetSlot<void> {
+  static constexpr Kind kind = Kind::String;
+  using view_type = std::string_view;
+};
+
+template<typename E, typename A>
+struct Slot<std::vector<E, A>> : OffsetSlot<void> {
+  static_assert(!std::is_same_v<E, bool>, "serde_flat: std::vector<bool> is not supported");
+  static constexpr Kind kind = Kind::Vector;
+  using element_type = E;
+  using view_type = VectorView<E>;
+};
+template<typename E, size_t N>
+struct Slot<std::array<E, N>> : OffsetSlot<void> {
+  static constexpr Kind kind = Kind::Vector;
+  using element_type = E;
+  using view_type = VectorView<E>;
+};
+
+template<typename E>
+struct Slot<std::optional<E>> : OffsetSlot<void> {
+  static constexpr Kind kind = Kind::Optional;
+  using element_type = E;
+  using view_type = std::optional<typename Slot<E>::view_type>;
+};
+
+template<typename T>
+struct Slot<T, std::enable_if_t<IsTable<T>::value>> : OffsetSlot<void> {
+  static constexpr Kind kind = Kind::Table;
+  using view_type = View<T>;
+};
+
+template<typename T>
+using view_t = typename Slot<T>::view_type;
+
+/// Fixed layout of the fields of struct T
+template<typename T>
+struct TableLayout {
+  using Fields = decltype(Table<T>::fields());
+  static constexpr size_t count = std::tuple_size_v<Fields>;
+
+  template<size_t I>
+  using field_type = typename MemberType<std::tuple_element_t<I, Fields>>::type;
+
+  // Offset of each field from the start of the fields, and their total size
+  struct Offsets {
+    std::array<uint32_t, count> offset{};
+    uint32_t size = 0;
+  };
+
+  template<size_t... I>
+  static constexpr Offsets compute(std::index_sequence<I...>) {
+    Offsets r{};
+    const std::array<size_t, count> sizes = {Slot<field_type<I>>::size...};
+    const std::array<size_t, count> aligns = {Slot<field_type<I>>::align...};
+    size_t pos = 0;
+    for (size_t i = 0; i < count; i++) {
+      pos = (pos + aligns[i] - 1) / aligns[i] * aligns[i];
+      r.offset[i] = static_cast<uint32_t>(pos);
+      pos += sizes[i];
+    }
+    r.size = static_cast<uint32_t>(pos);
+    return r;
+  }
+
+  static constexpr Offsets offsets = compute(std::make_index_sequence<count>{});
+};
+
+// Little-endian loads and stores of scalars, from/to unaligned memory
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+inline constexpr bool big_endian = true;
+#else
+inline constexpr bool big_endian = false;
+#endif
+
+template<typename U>
+inline U byteswap(U v) {
+  if constexpr (sizeof(U) == 2) return __builtin_bswap16(v);
+  else if constexpr (sizeof(U) == 4) return __builtin_bswap32(v);
+  else if constexpr (sizeof(U) == 8) return __builtin_bswap64(v);
+  else return v;
+}
+
+template<size_t N> struct UInt;
+template<> struct UInt<1> { using type = uint8_t; };
+template<> struct UInt<2> { using type = uint16_t; };
+template<> struct UInt<4> { using type = uint32_t; };
+template<> struct UInt<8> { using type = uint64_t; };
+
+template<typename T>
+inline T load(const uint8_t* p) {
+  if constexpr (std::is_same_v<T, bool>) {
+    return *p != 0;
+  }
+  else {
+    typename UInt<sizeof(T)>::type u;
+    std::memcpy(&u, p, sizeof(u));
+    if constexpr (big_endian) u = byteswap(u);
+    T v;
+    std::memcpy(&v, &u, sizeof(v));
+    return v;
+  }
+}
+
+template<typename T>
+inline void store(uint8_t* p, T v) {
+  if constexpr (std::is_same_v<T, bool>) {
+    *p = v ? 1 : 0;
+  }
+  else {
+    typename UInt<sizeof(T)>::type u;
+    std::memcpy(&u, &v, sizeof(u));
+    if constexpr (big_endian) u = byteswap(u);
+    std::memcpy(p, &u, sizeof(u));
+  }
+}
+
+/// Alignment of tables, their fields start 8 aligned after their u32 size
+inline constexpr size_t table_align = 8;
+
+} // namespace detail
+
+} // namespace serde_flat
@@ -0,0 +1,5 @@
+#pragma once
+
+// include flat buffer builders and views
+#include "builder_flat.h"
+#include "view_flat.h"
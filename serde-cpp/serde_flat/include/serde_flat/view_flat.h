@@ -0,0 +1,206 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <string_view>
+#include <vector>
+#include <serde/error.h>
+#include <serde/result.hpp>
+
+#include "layout.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Serde Flat
+////////////////////////////////////////////////////////////////////////////////
+namespace serde_flat {
+
+namespace detail {
+
+// View of the slot of type T at pos, which is within [data, data + len)
+template<typename T>
+view_t<T> load_slot(const uint8_t* data, size_t len, size_t pos);
+
+// Position of the object an offset slot at pos refers to, if the object's u32 header is within the buffer
+inline bool load_offset(const uint8_t* data, size_t len, size_t pos, size_t& target) {
+  target = load<uint32_t>(data + pos);
+  return target != 0 && target <= len - 4;
+}
+
+} // namespace detail
+
+/// Read-only view of the table of struct T in a flat buffer.
+///
+/// Reading a field loads it from its fixed position in the table, there is no parsing nor
+/// allocation: scalars are returned by value, strings as std::string_view, vectors as
+/// VectorView, optionals as std::optional of the view, and structs as their View.
+/// Every load is bounds checked, a field whose offset (or table) is out of the buffer
+/// reads as empty, as do the fields which are missing from a buffer written by an older
+/// version of the struct (with fewer fields).
+///
+/// A view borrows the buffer, which must outlive it and the strings and views read from it.
+template<typename T>
+class TableView {
+public:
+  TableView() = default;
+
+  /// View of the table at offset table of [data, data + len), empty if it is not within the buffer
+  TableView(const uint8_t* data, size_t len, size_t table) {
+    if (table == 0 || len < 4 || table > len - 4)
+      return;
+    const uint32_t size = detail::load<uint32_t>(data + table);
+    if (size > len - table - 4)
+      return;
+    this->data = data;
+    this->len = len;
+    this->fields = table + 4;
+    this->size = size;
+  }
+
+  /// Whether the view refers to a table, default constructed and invalid views don't
+  explicit operator bool() const { return data != nullptr; }
+
+  /// Field I, in declaration order
+  template<size_t I>
+  auto get() const -> detail::view_t<typename detail::TableLayout<T>::template field_type<I>> {
+    using Layout = detail::TableLayout<T>;
+    using F = typename Layout::template field_type<I>;
+    constexpr size_t offset = Layout::offsets.offset[I];
+    if (offset + detail::Slot<F>::size > size)
+      return {};
+    return detail::load_slot<F>(data, len, fields + offset);
+  }
+
+private:
+  const uint8_t* data = nullptr;
+  size_t len = 0;
+  size_t fields = 0; // position of the first field
+  size_t size = 0;   // size of the fields
+};
+
+/// Read-only view of the struct T in a flat buffer, with the fields read by index with get<I>().
+/// serde_gen specializes it for [[serde]] structs with an accessor named after each field.
+template<typename T, typename>
+class View : public TableView<T> {
+public:
+  using TableView<T>::TableView;
+};
+
+/// Read-only view of a vector (or array) of E in a flat buffer.
+/// Elements are bounds checked as table fields are, see TableView.
+template<typename E>
+class VectorView {
+public:
+  using value_type = detail::view_t<E>;
+
+  class iterator {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = detail::view_t<E>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = value_type;
+
+    iterator(const VectorView* vec, size_t i) : vec(vec), i(i) {}
+    value_type operator*() const { return (*vec)[i]; }
+    iterator& operator++() { i++; return *this; }
+    iterator operator++(int) { iterator it = *this; i++; return it; }
+    bool operator==(const iterator& o) const { return i == o.i; }
+    bool operator!=(const iterator& o) const { return i != o.i; }
+
+  private:
+    const VectorView* vec;
+    size_t i;
+  };
+
+  VectorView() = default;
+
+  /// View of the vector whose u32 count is at pos, empty if its elements are not within the buffer
+  VectorView(const uint8_t* data, size_t len, size_t pos) {
+    const size_t count = detail::load<uint32_t>(data + pos);
+    if (count > (len - pos - 4) / detail::Slot<E>::size)
+      return;
+    this->data = data;
+    this->len = len;
+    this->elements = pos + 4;
+    this->count = count;
+  }
+
+  size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+
+  /// Element i, empty if i is out of range
+  value_type operator[](size_t i) const {
+    if (i >= count)
+      return {};
+    return detail::load_slot<E>(data, len, elements + i * detail::Slot<E>::size);
+  }
+
+  iterator begin() const { return iterator(this, 0); }
+  iterator end() const { return iterator(this, count); }
+
+private:
+  const uint8_t* data = nullptr;
+  size_t len = 0;
+  size_t elements = 0; // position of the first element
+  size_t count = 0;
+};
+
+namespace detail {
+
+template<typename T>
+view_t<T> load_slot(const uint8_t* data, size_t len, size_t pos) {
+  using S = Slot<T>;
+  if constexpr (S::kind == Kind::Scalar) {
+    return load<T>(data + pos);
+  }
+  else {
+    size_t target;
+    if (!load_offset(data, len, pos, target))
+      return {};
+    if constexpr (S::kind == Kind::String) {
+      const size_t n = load<uint32_t>(data + target);
+      if (n > len - target - 4)
+        return {};
+      return std::string_view(reinterpret_cast<const char*>(data + target + 4), n);
+    }
+    else if constexpr (S::kind == Kind::Vector) {
+      return VectorView<typename S::element_type>(data, len, target);
+    }
+    else if constexpr (S::kind == Kind::Optional) {
+      using E = typename S::element_type;
+      if (Slot<E>::size > len - target)
+        return {};
+      return load_slot<E>(data, len, target);
+    }
+    else {
+      return View<T>(data, len, target);
+    }
+  }
+}
+
+} // namespace detail
+
+/// View of the root struct T of the flat buffer [data, data + len), see TableView.
+/// Only the root table is checked here, the rest is checked as it is read.
+template<typename T>
+auto from_bytes(const void* data, size_t len) -> cpp::result<View<T>, serde::Error>
+{
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  if (len < 4)
+    return cpp::fail(serde::Error{serde::Error::Kind::Invalid, 0, 0, "flat buffer too short"});
+  View<T> view(bytes, len, detail::load<uint32_t>(bytes));
+  if (!view)
+    return cpp::fail(serde::Error{serde::Error::Kind::Invalid, 0, 0, "root table out of the buffer"});
+  return view;
+}
+
+/// View of the root struct T of a flat buffer held in a byte vector
+template<typename T>
+auto from_bytes(const std::vector<uint8_t>& bytes) -> cpp::result<View<T>, serde::Error>
+{
+  return from_bytes<T>(bytes.data(), bytes.size());
+}
+
+} // namespace serde_flat
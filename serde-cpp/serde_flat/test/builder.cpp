@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include <cstring>
+
+#include "types.h"
+
+using Bytes = std::vector<uint8_t>;
+
+TEST(Builder, Layout)
+{
+  // root offset, then the table: u32 size of the fields and the fields, 8 aligned
+  auto bytes = serde_flat::to_bytes(Vec3{1.0f, 2.0f, -2.0f}).value();
+  EXPECT_EQ(bytes, (Bytes{0x04, 0, 0, 0, 0x0c, 0, 0, 0,
+                          0x00, 0x00, 0x80, 0x3f, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0xc0}));
+}
+
+TEST(Builder, FieldOffsets)
+{
+  // declaration order, naturally aligned: offsets are 4 bytes, speed 8 aligned
+  using Layout = serde_flat::detail::TableLayout<Monster>;
+  constexpr auto offsets = Layout::offsets;
+  EXPECT_EQ(offsets.offset[0], 0u);  // name
+  EXPECT_EQ(offsets.offset[1], 4u);  // hp
+  EXPECT_EQ(offsets.offset[2], 8u);  // pos
+  EXPECT_EQ(offsets.offset[3], 12u); // color
+  EXPECT_EQ(offsets.offset[4], 16u); // inventory
+  EXPECT_EQ(offsets.offset[8], 32u); // title
+  EXPECT_EQ(offsets.offset[9], 40u); // speed
+  EXPECT_EQ(offsets.offset[10], 48u); // boss
+  EXPECT_EQ(offsets.size, 49u);
+}
+
+TEST(Builder, Strings)
+{
+  auto bytes = serde_flat::to_bytes(Pair{1, "ab"}).value();
+  // table at 4: size 16, key at 8, value offset at 16, string at 20
+  ASSERT_EQ(bytes.size(), 27u);
+  EXPECT_EQ((Bytes{bytes.begin() + 16, bytes.end()}), (Bytes{20, 0, 0, 0, 2, 0, 0, 0, 'a', 'b', 0}));
+}
+
+TEST(Builder, AppendToOut)
+{
+  // offsets are relative to the start of the buffer, not of out
+  Bytes out = {0xaa, 0xbb, 0xcc};
+  const Monster m = make_monster();
+  serde_flat::to_bytes(m, out).value();
+  EXPECT_EQ(out[0], 0xaa);
+  auto view = serde_flat::from_bytes<Monster>(out.data() + 3, out.size() - 3).value();
+  EXPECT_EQ(view.name(), "Orc");
+  EXPECT_EQ(view.path()[1].z(), 1.0f);
+  EXPECT_EQ(Bytes(out.begin() + 3, out.end()), serde_flat::to_bytes(m).value());
+}
+
+TEST(Builder, Reuse)
+{
+  Bytes out;
+  for (int i = 0; i < 3; i++) {
+    out.clear();
+    serde_flat::to_bytes(Pair{i, std::string(size_t(i), 'x')}, out).value();
+    auto view = serde_flat::from_bytes<Pair>(out).value();
+    EXPECT_EQ(view.get<0>(), i);
+    EXPECT_EQ(view.get<1>().size(), size_t(i));
+  }
+}
+
+TEST(Builder, LargeVectors)
+{
+  Monster m = make_monster();
+  m.inventory.assign(100000, 7);
+  for (int i = 0; i < 1000; i++)
+    m.path.push_back(Vec3{float(i), 0, 0});
+  auto bytes = serde_flat::to_bytes(m).value();
+  auto view = serde_flat::from_bytes<Monster>(bytes).value();
+  EXPECT_EQ(view.inventory().size(), 100000u);
+  EXPECT_EQ(view.inventory()[99999], 7);
+  EXPECT_EQ(view.path().size(), 1002u);
+  EXPECT_EQ(view.path()[1001].x(), 999.0f);
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include "types.h"
+
+using Bytes = std::vector<uint8_t>;
+
+// Read every field of the view, as a reader of untrusted input would
+static size_t read_all(const serde_flat::View<Monster>& view)
+{
+  size_t n = view.name().size() + view.tags().size() + view.inventory().size();
+  n += size_t(view.hp()) + size_t(view.pos().x()) + size_t(view.color());
+  for (std::string_view tag : view.tags())
+    n += tag.size();
+  for (auto pos : view.path())
+    n += size_t(pos.y());
+  n += size_t(view.mana().value_or(0)) + view.title().value_or("").size();
+  n += size_t(view.speed()) + view.boss();
+  return n;
+}
+
+TEST(Errors, TooShort)
+{
+  auto res = serde_flat::from_bytes<Monster>(Bytes{0x04, 0x00});
+  ASSERT_TRUE(res.has_error());
+  EXPECT_EQ(res.error().text, "flat buffer too short");
+}
+
+TEST(Errors, RootOutOfBuffer)
+{
+  EXPECT_EQ(serde_flat::from_bytes<Monster>(Bytes{0x04, 0, 0, 0}).error().text, "root table out of the buffer");
+  EXPECT_EQ(serde_flat::from_bytes<Monster>(Bytes{0x00, 0, 0, 0, 0, 0, 0, 0}).error().text, "root table out of the buffer");
+  // table size beyond the end
+  EXPECT_EQ(serde_flat::from_bytes<Vec3>(Bytes{0x04, 0, 0, 0, 0x0c, 0, 0, 0, 0, 0}).error().text, "root table out of the buffer");
+}
+
+TEST(Errors, CorruptOffsets)
+{
+  auto bytes = serde_flat::to_bytes(make_monster()).value();
+  auto view = serde_flat::from_bytes<Monster>(bytes).value();
+  const size_t fields = 8; // root at 4, fields after its size
+  // name offset past the end reads as empty
+  Bytes corrupt = bytes;
+  serde_flat::detail::store<uint32_t>(corrupt.data() + fields, uint32_t(corrupt.size()));
+  EXPECT_EQ(serde_flat::from_bytes<Monster>(corrupt).value().name(), "");
+  // huge string length reads as empty
+  corrupt = bytes;
+  const uint32_t name = serde_flat::detail::load<uint32_t>(bytes.data() + fields);
+  serde_flat::detail::store<uint32_t>(corrupt.data() + name, 0xffffffff);
+  EXPECT_EQ(serde_flat::from_bytes<Monster>(corrupt).value().name(), "");
+  // huge vector count reads as empty
+  corrupt = bytes;
+  const uint32_t inventory = serde_flat::detail::load<uint32_t>(bytes.data() + fields + 16);
+  serde_flat::detail::store<uint32_t>(corrupt.data() + inventory, 0x40000000);
+  EXPECT_TRUE(serde_flat::from_bytes<Monster>(corrupt).value().inventory().empty());
+  EXPECT_EQ(view.inventory().size(), 4u);
+}
+
+TEST(Errors, Truncated)
+{
+  // every prefix of a buffer is safe to read, the fields out of it are empty
+  auto bytes = serde_flat::to_bytes(make_monster()).value();
+  for (size_t len = 0; len < bytes.size(); len++) {
+    const Bytes prefix(bytes.begin(), bytes.begin() + long(len));
+    auto res = serde_flat::from_bytes<Monster>(prefix);
+    if (res.has_value())
+      read_all(res.value());
+  }
+}
+
+TEST(Errors, RandomCorruption)
+{
+  auto bytes = serde_flat::to_bytes(make_monster()).value();
+  uint32_t seed = 1;
+  for (int i = 0; i < 20000; i++) {
+    Bytes corrupt = bytes;
+    for (int k = 0; k < 4; k++) {
+      seed = seed * 1664525u + 1013904223u;
+      corrupt[(seed >> 8) % corrupt.size()] = uint8_t(seed >> 24);
+    }
+    auto res = serde_flat::from_bytes<Monster>(corrupt);
+    if (res.has_value())
+      read_all(res.value());
+  }
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "serde_flat/serde_flat.h"
+
+enum class Color : uint8_t { Red, Green, Blue };
+
+struct Vec3 {
+  float x;
+  float y;
+  float z;
+};
+
+struct Monster {
+  std::string name;
+  int16_t hp;
+  Vec3 pos;
+  Color color;
+  std::vector<uint8_t> inventory;
+  std::vector<std::string> tags;
+  std::vector<Vec3> path;
+  std::optional<int32_t> mana;
+  std::optional<std::string> title;
+  double speed;
+  bool boss;
+};
+
+// An older version of Monster, with its first fields only
+struct MonsterV1 {
+  std::string name;
+  int16_t hp;
+};
+
+// No named view, fields are read with get<I>()
+struct Pair {
+  int64_t key;
+  std::string value;
+};
+
+// Same as what serde_gen --flat generates for the structs above
+namespace serde_flat {
+
+template<typename T>
+struct Table<T, std::enable_if_t<std::is_same_v<T, Vec3>>> {
+  static constexpr auto fields() { return std::make_tuple(&T::x, &T::y, &T::z); }
+};
+
+template<typename T>
+class View<T, std::enable_if_t<std::is_same_v<T, Vec3>>> : public TableView<T> {
+public:
+  using TableView<T>::TableView;
+  auto x() const { return this->template get<0>(); }
+  auto y() const { return this->template get<1>(); }
+  auto z() const { return this->template get<2>(); }
+};
+
+template<typename T>
+struct Table<T, std::enable_if_t<std::is_same_v<T, Monster>>> {
+  static constexpr auto fields() {
+    return std::make_tuple(&T::name, &T::hp, &T::pos, &T::color, &T::inventory, &T::tags, &T::path,
+                           &T::mana, &T::title, &T::speed, &T::boss);
+  }
+};
+
+template<typename T>
+class View<T, std::enable_if_t<std::is_same_v<T, Monster>>> : public TableView<T> {
+public:
+  using TableView<T>::TableView;
+  auto name() const { return this->template get<0>(); }
+  auto hp() const { return this->template get<1>(); }
+  auto pos() const { return this->template get<2>(); }
+  auto color() const { return this->template get<3>(); }
+  auto inventory() const { return this->template get<4>(); }
+  auto tags() const { return this->template get<5>(); }
+  auto path() const { return this->template get<6>(); }
+  auto mana() const { return this->template get<7>(); }
+  auto title() const { return this->template get<8>(); }
+  auto speed() const { return this->template get<9>(); }
+  auto boss() const { return this->template get<10>(); }
+};
+
+template<typename T>
+struct Table<T, std::enable_if_t<std::is_same_v<T, MonsterV1>>> {
+  static constexpr auto fields() { return std::make_tuple(&T::name, &T::hp); }
+};
+
+template<typename T>
+class View<T, std::enable_if_t<std::is_same_v<T, MonsterV1>>> : public TableView<T> {
+public:
+  using TableView<T>::TableView;
+  auto name() const { return this->template get<0>(); }
+  auto hp() const { return this->template get<1>(); }
+};
+
+template<typename T>
+struct Table<T, std::enable_if_t<std::is_same_v<T, Pair>>> {
+  static constexpr auto fields() { return std::make_tuple(&T::key, &T::value); }
+};
+
+} // namespace serde_flat
+
+inline Monster make_monster()
+{
+  Monster m;
+  m.name = "Orc";
+  m.hp = -300;
+  m.pos = Vec3{1.0f, 2.5f, -3.0f};
+  m.color = Color::Blue;
+  m.inventory = {1, 2, 3, 250};
+  m.tags = {"green", "", "big"};
+  m.path = {Vec3{0, 0, 0}, Vec3{1, 1, 1}};
+  m.mana = 150;
+  m.title = std::nullopt;
+  m.speed = 0.1;
+  m.boss = true;
+  return m;
+}
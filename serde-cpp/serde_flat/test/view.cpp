@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include "types.h"
+
+using Bytes = std::vector<uint8_t>;
+
+TEST(View, Fields)
+{
+  const Monster m = make_monster();
+  auto bytes = serde_flat::to_bytes(m).value();
+  auto view = serde_flat::from_bytes<Monster>(bytes).value();
+  EXPECT_EQ(view.name(), "Orc");
+  EXPECT_EQ(view.hp(), -300);
+  EXPECT_EQ(view.pos().x(), 1.0f);
+  EXPECT_EQ(view.pos().y(), 2.5f);
+  EXPECT_EQ(view.pos().z(), -3.0f);
+  EXPECT_EQ(view.color(), Color::Blue);
+  EXPECT_EQ(view.mana(), std::optional<int32_t>(150));
+  EXPECT_FALSE(view.title().has_value());
+  EXPECT_EQ(view.speed(), 0.1);
+  EXPECT_TRUE(view.boss());
+}
+
+TEST(View, Vectors)
+{
+  const Monster m = make_monster();
+  auto bytes = serde_flat::to_bytes(m).value();
+  auto view = serde_flat::from_bytes<Monster>(bytes).value();
+
+  auto inventory = view.inventory();
+  ASSERT_EQ(inventory.size(), 4u);
+  EXPECT_EQ(std::vector<uint8_t>(inventory.begin(), inventory.end()), m.inventory);
+
+  std::vector<std::string_view> tags;
+  for (std::string_view tag : view.tags())
+    tags.push_back(tag);
+  EXPECT_EQ(tags, (std::vector<std::string_view>{"green", "", "big"}));
+
+  ASSERT_EQ(view.path().size(), 2u);
+  EXPECT_EQ(view.path()[1].y(), 1.0f);
+  // out of range elements are empty
+  EXPECT_EQ(inventory[4], 0);
+  EXPECT_FALSE(view.path()[2]);
+}
+
+TEST(View, Borrowed)
+{
+  const Monster m = make_monster();
+  auto bytes = serde_flat::to_bytes(m).value();
+  auto view = serde_flat::from_bytes<Monster>(bytes).value();
+  // strings point into the buffer, '\0' terminated
+  const auto* data = reinterpret_cast<const char*>(bytes.data());
+  const std::string_view name = view.name();
+  EXPECT_GE(name.data(), data);
+  EXPECT_LT(name.data(), data + bytes.size());
+  EXPECT_EQ(name.data()[name.size()], '\0');
+}
+
+TEST(View, Optionals)
+{
+  Monster m = make_monster();
+  m.mana = std::nullopt;
+  m.title = "Warlord";
+  auto bytes = serde_flat::to_bytes(m).value();
+  auto view = serde_flat::from_bytes<Monster>(bytes).value();
+  EXPECT_FALSE(view.mana().has_value());
+  EXPECT_EQ(view.title(), std::optional<std::string_view>("Warlord"));
+}
+
+TEST(View, GetByIndex)
+{
+  // structs without a generated view read their fields by index
+  const Pair p{-5, "five"};
+  auto bytes = serde_flat::to_bytes(p).value();
+  auto view = serde_flat::from_bytes<Pair>(bytes).value();
+  EXPECT_EQ(view.get<0>(), -5);
+  EXPECT_EQ(view.get<1>(), "five");
+}
+
+TEST(View, EmptyView)
+{
+  // a default (or invalid) view reads every field as empty
+  serde_flat::View<Monster> view;
+  EXPECT_FALSE(view);
+  EXPECT_EQ(view.name(), "");
+  EXPECT_EQ(view.hp(), 0);
+  EXPECT_FALSE(view.pos());
+  EXPECT_EQ(view.pos().x(), 0.0f);
+  EXPECT_TRUE(view.tags().empty());
+  EXPECT_FALSE(view.mana().has_value());
+}
+
+TEST(View, OlderAndNewerVersions)
+{
+  // fields appended after a buffer was written read as empty
+  auto v1_bytes = serde_flat::to_bytes(MonsterV1{"Imp", 12}).value();
+  auto view = serde_flat::from_bytes<Monster>(v1_bytes).value();
+  EXPECT_EQ(view.name(), "Imp");
+  EXPECT_EQ(view.hp(), 12);
+  EXPECT_TRUE(view.inventory().empty());
+  EXPECT_FALSE(view.boss());
+
+  // and older readers skip the fields they don't know
+  auto bytes = serde_flat::to_bytes(make_monster()).value();
+  auto v1_view = serde_flat::from_bytes<MonsterV1>(bytes).value();
+  EXPECT_EQ(v1_view.name(), "Orc");
+  EXPECT_EQ(v1_view.hp(), -300);
+}
@@ -7,12 +7,13 @@ include(CMakeParseArguments)
 #   SUFFIX default: "_serde.h"
 #   OUTPUT_DIRECTORY default: "${CMAKE_CURRENT_BINARY_DIR}/"
 #   VERBOSE default: OFF
+#   FLAT default: OFF, also generate serde_flat tables and views (link serde_flat)
 #########################################################################################
 function(serde_generate TARGET)
 
   # Parse arguments
   set(prefix ARG)
-  set(flags VERBOSE)
+  set(flags VERBOSE FLAT)
   set(singleValues SUFFIX OUTPUT_DIRECTORY)
   set(multiValues)
   cmake_parse_arguments(PARSE_ARGV 1 "${prefix}" "${flags}" "${singleValues}" "${multiValues}")
@@ -35,6 +36,10 @@ function(serde_generate TARGET)
     set(VERBOSE "--verbose")
   endif()
 
+  if(ARG_FLAT)
+    set(FLAT "--flat")
+  endif()
+
   # Generate new list of serde header file names
   foreach(FILE IN LISTS ARG_SOURCES)
     # Get file absolute path
@@ -87,6 +92,7 @@ function(serde_generate TARGET)
                 --database_file=compile_commands.json
                 --include_directory=${ARG_OUTPUT_DIRECTORY}
                 ${VERBOSE}
+                ${FLAT}
       WORKING_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR}
       DEPENDS serde_cpp::serde_gen ${SOURCE})
   endforeach()
@@ -224,6 +224,55 @@ struct ApiDeserializeStructField : public GenT<ApiDeserializeStructField> {
     }
 };
 
+struct StructFlatTableBegin : public GenT<StructFlatTableBegin> {
+    std::string name;
+    explicit StructFlatTableBegin(std::string&& name) : name(std::move(name)) {}
+    std::ostream& write(std::ostream& os, IoCtl& ctl) const override
+    {
+        os << "template<typename T>\n";
+        os << "struct Table<T, std::enable_if_t<std::is_same_v<T, " << name << ">>> {\n";
+        return os;
+    }
+};
+
+struct FlatTableFields : public GenT<FlatTableFields> {
+    std::vector<std::string> fields;
+    explicit FlatTableFields(std::vector<std::string>&& fields) : fields(std::move(fields)) {}
+    std::ostream& write(std::ostream& os, IoCtl& ctl) const override
+    {
+        os << "static constexpr auto fields() { return std::make_tuple(";
+        for (size_t i = 0; i < fields.size(); i++)
+            os << (i ? ", " : "") << "&T::" << fields[i];
+        os << "); }\n";
+        return os;
+    }
+};
+
+struct StructFlatViewBegin : public GenT<StructFlatViewBegin> {
+    std::string name;
+    explicit StructFlatViewBegin(std::string&& name) : name(std::move(name)) {}
+    std::ostream& write(std::ostream& os, IoCtl& ctl) const override
+    {
+        os << "template<typename T>\n";
+        os << "class View<T, std::enable_if_t<std::is_same_v<T, " << name
+           << ">>> : public TableView<T> {\n";
+        os << "public:\n";
+        os << "using TableView<T>::TableView;\n";
+        return os;
+    }
+};
+
+struct ApiFlatViewField : public GenT<ApiFlatViewField> {
+    std::string name;
+    size_t index;
+    explicit ApiFlatViewField(const std::string& name, size_t index) : name(name), index(index) {}
+    std::ostream& write(std::ostream& os, IoCtl& ctl) const override
+    {
+        os << "auto " << name << "() const { return this->template get<" << index << ">(); }\n";
+        return os;
+    }
+};
+
 struct GenString : public GenT<GenString> {
     std::string string;
     explicit GenString(std::string&& string) : string(std::move(string)) {}
@@ -333,13 +382,15 @@ class Generator {
     };
 
 SIMPLE_GEN_TYPE(StaticMethodDeserializeBegin,
-                "static void deserialize(Deserializer& de, T& val) {\n");
+                "template<typename D>\nstatic void deserialize(D& de, T& val) {\n");
 SIMPLE_GEN_TYPE(StaticMethodSerializeBegin,
-                "static void serialize(Serializer& ser, const T& val) {\n");
+                "template<typename S>\nstatic void serialize(S& ser, const T& val) {\n");
 SIMPLE_GEN_TYPE(ApiSerializeStructBegin, "ser.serialize_struct_begin();\n");
 SIMPLE_GEN_TYPE(ApiSerializeStructEnd, "ser.serialize_struct_end();\n");
 SIMPLE_GEN_TYPE(ApiDeserializeStructBegin, "de.deserialize_struct_begin();\n");
 SIMPLE_GEN_TYPE(ApiDeserializeStructEnd, "de.deserialize_struct_end();\n");
+SIMPLE_GEN_TYPE(StructFlatTableEnd, "};\n");
+SIMPLE_GEN_TYPE(StructFlatViewEnd, "};\n");
 
 struct StaticMethodSerializeEnd : public GenT<StaticMethodSerializeEnd> {
     std::ostream& write(std::ostream& os, IoCtl& ctl) const override
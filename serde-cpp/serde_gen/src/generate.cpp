@@ -18,7 +18,7 @@
 
 namespace serde_gen {
 
-void generate_serde_for_file(std::ostream& output, const cppast::cpp_file& file)
+void generate_serde_for_file(std::ostream& output, const cppast::cpp_file& file, bool flat)
 {
     using namespace gen;
 
@@ -26,20 +26,22 @@ void generate_serde_for_file(std::ostream& output, const cppast::cpp_file& file)
     gen.add_header(FileHeader());
     gen.add_include_local("serde/serde.h");
     gen.add_include_local("serde/std/string.h");
+    if (flat)
+        gen.add_include_local("serde_flat/view_flat.h");
 
     cppast::visit(file, Filter::cpp_entities_with_serde_attr, [&](const auto& e, const auto& info) {
-        generate_serde_for_entity(gen, e, info);
+        generate_serde_for_entity(gen, e, info, flat);
     });
 
     gen.write(output);
 }
 
 void generate_serde_for_entity(gen::Generator& gen, const cppast::cpp_entity& e,
-                               const cppast::visitor_info& info)
+                               const cppast::visitor_info& info, bool flat)
 {
     if (e.kind() == cppast::cpp_entity_kind::class_t) {
         if (!info.is_old_entity()) {  // meaning: not visited yet
-            generate_serde_for_class(gen, e, info);
+            generate_serde_for_class(gen, e, info, flat);
         }
     }
     else {
@@ -49,7 +51,7 @@ void generate_serde_for_entity(gen::Generator& gen, const cppast::cpp_entity& e,
 }
 
 void generate_serde_for_class(gen::Generator& gen, const cppast::cpp_entity& e,
-                              const cppast::visitor_info& info)
+                              const cppast::visitor_info& info, bool flat)
 {
     using namespace gen;
 
@@ -65,6 +67,17 @@ void generate_serde_for_class(gen::Generator& gen, const cppast::cpp_entity& e,
 
     gen.add(NamespaceEnd("serde"));
     gen.add(LineBreak());
+
+    if (flat) {
+        gen.add(NamespaceBegin("serde_flat"));
+        gen.add(LineBreak());
+
+        generate_struct_flat_table(gen, e, info);
+        generate_struct_flat_view(gen, e, info);
+
+        gen.add(NamespaceEnd("serde_flat"));
+        gen.add(LineBreak());
+    }
 }
 
 void generate_struct_serialize(gen::Generator& gen, const cppast::cpp_entity& e,
@@ -115,4 +128,44 @@ void generate_struct_deserialize(gen::Generator& gen, const cppast::cpp_entity&
     gen.add(LineBreak());
 }
 
+void generate_struct_flat_table(gen::Generator& gen, const cppast::cpp_entity& e,
+                                const cppast::visitor_info& info)
+{
+    using namespace gen;
+
+    const auto& cpp_class = static_cast<const cppast::cpp_class&>(e);
+
+    std::vector<std::string> fields;
+    for (const auto& member : cpp_class) {
+        if (member.kind() == cppast::cpp_entity_kind::member_variable_t)
+            fields.emplace_back(member.name());
+    }
+
+    gen.add(StructFlatTableBegin(std::string(e.name())));
+    gen.add(FlatTableFields(std::move(fields)));
+    gen.add(StructFlatTableEnd());
+    gen.add(LineBreak());
+}
+
+void generate_struct_flat_view(gen::Generator& gen, const cppast::cpp_entity& e,
+                               const cppast::visitor_info& info)
+{
+    using namespace gen;
+
+    const auto& cpp_class = static_cast<const cppast::cpp_class&>(e);
+
+    gen.add(StructFlatViewBegin(std::string(e.name())));
+
+    size_t index = 0;
+    for (const auto& member : cpp_class) {
+        if (member.kind() == cppast::cpp_entity_kind::member_variable_t) {
+            const auto& member_var = static_cast<const cppast::cpp_member_variable&>(member);
+            gen.add(ApiFlatViewField(member_var.name(), index++));
+        }
+    }
+
+    gen.add(StructFlatViewEnd());
+    gen.add(LineBreak());
+}
+
 }  // namespace serde_gen
@@ -8,16 +8,17 @@
 
 namespace serde_gen {
 
-/// Generate serde for an entire parsed file
-void generate_serde_for_file(std::ostream& outfile, const cppast::cpp_file& file);
+/// Generate serde for an entire parsed file,
+/// with serde_flat tables and views if flat is set
+void generate_serde_for_file(std::ostream& outfile, const cppast::cpp_file& file, bool flat);
 
 /// Generate serde for a cpp_entity
 void generate_serde_for_entity(gen::Generator& gen, const cppast::cpp_entity& e,
-                               const cppast::visitor_info& info);
+                               const cppast::visitor_info& info, bool flat);
 
 /// Generate serde for a class/struct with serde attribute
 void generate_serde_for_class(gen::Generator& gen, const cppast::cpp_entity& e,
-                              const cppast::visitor_info& info);
+                              const cppast::visitor_info& info, bool flat);
 
 /// Generate struct Serialize for a given type
 void generate_struct_serialize(gen::Generator& gen, const cppast::cpp_entity& e,
@@ -27,4 +28,12 @@ void generate_struct_serialize(gen::Generator& gen, const cppast::cpp_entity& e,
 void generate_struct_deserialize(gen::Generator& gen, const cppast::cpp_entity& e,
                                  const cppast::visitor_info& info);
 
+/// Generate serde_flat struct Table for a given type
+void generate_struct_flat_table(gen::Generator& gen, const cppast::cpp_entity& e,
+                                const cppast::visitor_info& info);
+
+/// Generate serde_flat class View for a given type, with an accessor per field
+void generate_struct_flat_view(gen::Generator& gen, const cppast::cpp_entity& e,
+                               const cppast::visitor_info& info);
+
 }  // namespace serde_gen
@@ -21,7 +21,8 @@ auto create_option_list() -> cxxopts::Options
             ("h,help", "display this help and exit")
             ("V,version", "display version information and exit")
             ("v,verbose", "be verbose when parsing")
-            ("F,fatal_errors", "abort program when a parser error occurs, instead of doing error correction");
+            ("F,fatal_errors", "abort program when a parser error occurs, instead of doing error correction")
+            ("f,flat", "also generate serde_flat tables and zero-copy views for the serde types");
     option_list.add_options("compilation")
             ("s,source", "the file that is being parsed", cxxopts::value<std::string>())
             ("o,output", "the output file that will be generated", cxxopts::value<std::string>())
@@ -151,7 +152,7 @@ auto run_serde_generator(const cxxopts::ParseResult& options) -> int
         print_ast(std::cout, *src_ast);
 
     std::ofstream outfile(output_filename);
-    generate_serde_for_file(outfile, *src_ast);
+    generate_serde_for_file(outfile, *src_ast, options.count("flat"));
 
     return 0;
 }
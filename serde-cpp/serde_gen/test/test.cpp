@@ -2,6 +2,7 @@
 #include <iostream>
 
 #include <serde_yaml/serde_yaml.h>
+#include <serde_flat/serde_flat.h>
 #include "test_serde.h"
 #include "mytypes.h"
 
@@ -18,6 +19,9 @@ int main()
   Options opts{true, 856, "main"};
   auto str = serde_yaml::to_string(opts).value();
   std::cout << str << std::endl;
+  auto bytes = serde_flat::to_bytes(opts).value();
+  auto view = serde_flat::from_bytes<Options>(bytes).value();
+  std::cout << view.func() << ':' << view.line() << std::endl;
   return 0;
 }
 
@@ -0,0 +1,215 @@
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "serde/std.h"
+#include "serde/serde.h"
+#include "serde_json/serde_json.h"
+#include "serde_json/serializer_json.h"
+#include "serde_json/deserializer_json.h"
+#include "serde_yaml/serde_yaml.h"
+#include "serde_yaml/deserializer_yaml.h"
+
+#include "bench.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// Typical REST API response (users with their orders), serde_json vs serde_yaml
+// on the same types
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+struct Item {
+  std::string sku;
+  int32_t quantity;
+  double price;
+};
+
+struct Order {
+  uint64_t id;
+  std::string status;
+  std::vector<Item> items;
+  std::optional<std::string> coupon;
+};
+
+struct User {
+  uint64_t id;
+  std::string name;
+  std::string email;
+  bool active;
+  double balance;
+  std::vector<std::string> roles;
+  std::vector<Order> orders;
+};
+
+struct Page {
+  uint32_t page;
+  uint32_t total;
+  std::vector<User> users;
+};
+} // namespace
+
+namespace serde {
+// same shape as serde_gen output
+template<typename T>
+struct Serialize<T, std::enable_if_t<std::is_same_v<T, Item>>> {
+template<typename S>
+static void serialize(S& ser, const T& val) {
+ser.serialize_struct_begin();
+ser.serialize_struct_field("sku", val.sku);
+ser.serialize_struct_field("quantity", val.quantity);
+ser.serialize_struct_field("price", val.price);
+ser.serialize_struct_end();
+}
+};
+template<typename T>
+struct Deserialize<T, std::enable_if_t<std::is_same_v<T, Item>>> {
+template<typename D>
+static void deserialize(D& de, T& val) {
+de.deserialize_struct_begin();
+de.deserialize_struct_field("sku", val.sku);
+de.deserialize_struct_field("quantity", val.quantity);
+de.deserialize_struct_field("price", val.price);
+de.deserialize_struct_end();
+}
+};
+template<typename T>
+struct Serialize<T, std::enable_if_t<std::is_same_v<T, Order>>> {
+template<typename S>
+static void serialize(S& ser, const T& val) {
+ser.serialize_struct_begin();
+ser.serialize_struct_field("id", val.id);
+ser.serialize_struct_field("status", val.status);
+ser.serialize_struct_field("items", val.items);
+ser.serialize_struct_field("coupon", val.coupon);
+ser.serialize_struct_end();
+}
+};
+template<typename T>
+struct Deserialize<T, std::enable_if_t<std::is_same_v<T, Order>>> {
+template<typename D>
+static void deserialize(D& de, T& val) {
+de.deserialize_struct_begin();
+de.deserialize_struct_field("id", val.id);
+de.deserialize_struct_field("status", val.status);
+de.deserialize_struct_field("items", val.items);
+de.deserialize_struct_field("coupon", val.coupon);
+de.deserialize_struct_end();
+}
+};
+template<typename T>
+struct Serialize<T, std::enable_if_t<std::is_same_v<T, User>>> {
+template<typename S>
+static void serialize(S& ser, const T& val) {
+ser.serialize_struct_begin();
+ser.serialize_struct_field("id", val.id);
+ser.serialize_struct_field("name", val.name);
+ser.serialize_struct_field("email", val.email);
+ser.serialize_struct_field("active", val.active);
+ser.serialize_struct_field("balance", val.balance);
+ser.serialize_struct_field("roles", val.roles);
+ser.serialize_struct_field("orders", val.orders);
+ser.serialize_struct_end();
+}
+};
+template<typename T>
+struct Deserialize<T, std::enable_if_t<std::is_same_v<T, User>>> {
+template<typename D>
+static void deserialize(D& de, T& val) {
+de.deserialize_struct_begin();
+de.deserialize_struct_field("id", val.id);
+de.deserialize_struct_field("name", val.name);
+de.deserialize_struct_field("email", val.email);
+de.deserialize_struct_field("active", val.active);
+de.deserialize_struct_field("balance", val.balance);
+de.deserialize_struct_field("roles", val.roles);
+de.deserialize_struct_field("orders", val.orders);
+de.deserialize_struct_end();
+}
+};
+template<typename T>
+struct Serialize<T, std::enable_if_t<std::is_same_v<T, Page>>> {
+template<typename S>
+static void serialize(S& ser, const T& val) {
+ser.serialize_struct_begin();
+ser.serialize_struct_field("page", val.page);
+ser.serialize_struct_field("total", val.total);
+ser.serialize_struct_field("users", val.users);
+ser.serialize_struct_end();
+}
+};
+template<typename T>
+struct Deserialize<T, std::enable_if_t<std::is_same_v<T, Page>>> {
+template<typename D>
+static void deserialize(D& de, T& val) {
+de.deserialize_struct_begin();
+de.deserialize_struct_field("page", val.page);
+de.deserialize_struct_field("total", val.total);
+de.deserialize_struct_field("users", val.users);
+de.deserialize_struct_end();
+}
+};
+} // namespace serde
+
+namespace {
+Page make_page(uint32_t num_users) {
+  Page page{1, num_users, {}};
+  for (uint32_t i = 0; i < num_users; i++) {
+    User user{i, "User Name " + std::to_string(i), "user" + std::to_string(i) + "@example.com",
+              i % 3 != 0, i * 10.25, {"reader", i % 5 ? "writer" : "admin"}, {}};
+    for (uint32_t o = 0; o < 3; o++) {
+      Order order{i * 100ull + o, o % 2 ? "shipped" : "pending \"priority\"", {}, std::nullopt};
+      if (o == 1)
+        order.coupon = "SAVE10";
+      for (int32_t n = 0; n < 2; n++)
+        order.items.push_back(Item{"SKU-" + std::to_string(i * 7 + o), n + 1, 19.99 + n});
+      user.orders.push_back(std::move(order));
+    }
+    page.users.push_back(std::move(user));
+  }
+  return page;
+}
+
+template<typename Fn>
+void measure_throughput(const char* name, size_t iterations, size_t bytes, Fn&& fn) {
+  const double us = bench::measure(name, iterations, std::forward<Fn>(fn));
+  std::printf("%-40s %12.1f MB/s\n", "", double(bytes) / us);
+}
+} // namespace
+
+void bench_api_payload()
+{
+  const Page page = make_page(2000);
+  const std::string json = serde_json::to_string(page).value();
+  const std::string yaml = serde_yaml::to_string(page).value();
+  std::printf("json %zu bytes, yaml %zu bytes\n", json.size(), yaml.size());
+
+  measure_throughput("json serialize (to_string)", 20, json.size(), [&] {
+    auto str = serde_json::to_string(page);
+    bench::do_not_optimize(str);
+  });
+  measure_throughput("json serialize (to_string_static)", 20, json.size(), [&] {
+    auto str = serde_json::to_string_static(page);
+    bench::do_not_optimize(str);
+  });
+  measure_throughput("yaml serialize (to_string)", 5, yaml.size(), [&] {
+    auto str = serde_yaml::to_string(page);
+    bench::do_not_optimize(str);
+  });
+
+  measure_throughput("json deserialize (from_str)", 20, json.size(), [&] {
+    auto val = serde_json::from_str<Page>(std::string(json));
+    bench::do_not_optimize(val);
+  });
+  measure_throughput("json deserialize (from_str_static)", 20, json.size(), [&] {
+    auto val = serde_json::from_str_static<Page>(std::string(json));
+    bench::do_not_optimize(val);
+  });
+  measure_throughput("json deserialize (borrowed input)", 20, json.size(), [&] {
+    auto val = serde_json::from_str<Page>(std::string_view(json));
+    bench::do_not_optimize(val);
+  });
+  measure_throughput("yaml deserialize (from_str)", 5, yaml.size(), [&] {
+    auto val = serde_yaml::from_str<Page>(std::string(yaml));
+    bench::do_not_optimize(val);
+  });
+}
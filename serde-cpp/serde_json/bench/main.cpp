@@ -0,0 +1,17 @@
+#include <cstdio>
+
+///////////////////////////////////////////////////////////////////////////////
+// serde_json benchmarks, build with -DCMAKE_BUILD_TYPE=Release for meaningful numbers
+///////////////////////////////////////////////////////////////////////////////
+
+void bench_api_payload();
+void bench_structural();
+
+int main()
+{
+  std::printf("== api payload, json vs yaml\n");
+  bench_api_payload();
+  std::printf("== structural scanner\n");
+  bench_structural();
+  return 0;
+}
@@ -0,0 +1,37 @@
+#include <string>
+#include <vector>
+
+#include "serde_json/detail/structural.h"
+
+#include "bench.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// First pass structural index, per block loop instruction set
+///////////////////////////////////////////////////////////////////////////////
+
+void bench_structural()
+{
+  using serde_json::detail::ScanIsa;
+  std::string json = "[";
+  for (int i = 0; i < 20000; i++) {
+    json += i ? "," : "";
+    json += R"({"id": )" + std::to_string(i) + R"(, "name": "item \")" + std::to_string(i) +
+            R"(\"", "tags": ["a", "b\\c"], "price": 12.5, "active": true})";
+  }
+  json += "]";
+  std::vector<uint32_t> index(json.size());
+
+  const struct { ScanIsa isa; const char* name; } isas[] = {
+    {ScanIsa::Scalar, "scalar"}, {ScanIsa::SSE2, "sse2"}, {ScanIsa::AVX2, "avx2"},
+  };
+  for (const auto& isa : isas) {
+    if (isa.isa > serde_json::detail::scan_isa())
+      continue;
+    const double us = bench::measure(isa.name, 50, [&] {
+      size_t count = 0;
+      serde_json::detail::find_structurals(isa.isa, json.data(), json.size(), index.data(), count);
+      bench::do_not_optimize(count);
+    });
+    std::printf("%-40s %12.1f MB/s\n", "", double(json.size()) / us);
+  }
+}
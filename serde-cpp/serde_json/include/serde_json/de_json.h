@@ -0,0 +1,94 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <serde/de.h>
+#include <serde/error.h>
+#include <serde/result.hpp>
+#include "detail/de_detail.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// Serde JSON
+///////////////////////////////////////////////////////////////////////////////
+namespace serde_json {
+
+/// JSON Deserializer function from json string to T
+template<typename T>
+auto from_str(std::string&& str) -> cpp::result<T, serde::Error>
+{
+  auto de = detail::DeserializerNew(std::move(str));
+  if (auto parsed = detail::DeserializerParse(de.get()); !parsed)
+    return cpp::fail(std::move(parsed).error());
+  T obj{};
+  de->deserialize(obj);
+  if (de->has_error())
+    return cpp::fail(de->error());
+  return std::move(obj);
+}
+
+/// JSON Deserializer function from a read-only json buffer to T.
+/// The json is parsed where it is, without copying it.
+/// Strings with escapes are unescaped into the deserializer, which is released on return,
+/// so T must not borrow strings (e.g. std::string_view fields), use from_str_borrowed() for those.
+/// To parse many buffers without allocating once warmed up, reuse a JsonDeserializer with reset().
+template<typename T>
+auto from_str(std::string_view str) -> cpp::result<T, serde::Error>
+{
+  auto de = detail::DeserializerNew(str);
+  if (auto parsed = detail::DeserializerParse(de.get()); !parsed)
+    return cpp::fail(std::move(parsed).error());
+  T obj{};
+  de->deserialize(obj);
+  if (de->has_error())
+    return cpp::fail(de->error());
+  return std::move(obj);
+}
+
+/// JSON Deserializer function from a null-terminated json string to T, see from_str(std::string_view)
+template<typename T>
+auto from_str(const char* str) -> cpp::result<T, serde::Error>
+{
+  return from_str<T>(std::string_view(str));
+}
+
+/// JSON Document, a deserialized T together with the json string it was deserialized from.
+/// Borrowed strings in T (std::string_view) point into the document's json string,
+/// so they are valid as long as the Document is alive, moving the Document keeps them valid.
+template<typename T>
+class Document {
+public:
+  const T& value() const { return obj; }
+  T& value() { return obj; }
+  const T& operator*() const { return obj; }
+  T& operator*() { return obj; }
+  const T* operator->() const { return &obj; }
+  T* operator->() { return &obj; }
+
+private:
+  template<typename U>
+  friend auto from_str_borrowed(std::string&& str) -> cpp::result<Document<U>, serde::Error>;
+
+  Document(std::unique_ptr<serde::Deserializer> de) : de(std::move(de)), obj{} {}
+
+  // de owns the json string, declared first to be destroyed after obj
+  std::unique_ptr<serde::Deserializer> de;
+  T obj;
+};
+
+/// JSON Deserializer function from json string to a Document of T.
+/// Same as from_str(), but T may borrow strings from the json string without copying them,
+/// e.g. std::string_view fields, as the Document keeps the json string alive.
+template<typename T>
+auto from_str_borrowed(std::string&& str) -> cpp::result<Document<T>, serde::Error>
+{
+  Document<T> doc(detail::DeserializerNew(std::move(str)));
+  if (auto parsed = detail::DeserializerParse(doc.de.get()); !parsed)
+    return cpp::fail(std::move(parsed).error());
+  doc.de->deserialize(doc.obj);
+  if (doc.de->has_error())
+    return cpp::fail(doc.de->error());
+  return std::move(doc);
+}
+
+} // namespace serde_json
@@ -0,0 +1,508 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <serde/de.h>
+#include <serde/error.h>
+#include <serde/result.hpp>
+#include <serde/fmt/base64.h>
+#include <serde/fmt/parse.h>
+
+#include "detail/structural.h"
+#include "detail/string_json.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Serde JSON
+////////////////////////////////////////////////////////////////////////////////
+namespace serde_json {
+
+/// JSON Deserializer
+///
+/// Parses in two passes, without building a tree of the document:
+/// detail::find_structurals() indexes the structural characters of the whole input
+/// with SIMD, then a pass over that index checks the grammar and records, for every
+/// array and object, its matching closing token and number of elements.
+/// The Deserializer calls then walk the index directly: sizes are known up front,
+/// skipping a nested value is a single jump, and scalars are only converted when
+/// they are deserialized.
+///
+/// Object keys are looked up in the order they are in the input first (the usual struct
+/// field order), then searched in the whole object.
+///
+/// A JsonDeserializer can be kept around and reused with reset(json), which keeps
+/// the index capacity, so once warmed up parsing another document does not allocate.
+class JsonDeserializer final : public serde::StaticDeserializer<JsonDeserializer> {
+public:
+  JsonDeserializer() = default;
+
+  explicit JsonDeserializer(std::string json) : owned(std::move(json)), input(owned) {}
+
+  /// Drop the parsed document and error to deserialize again, keeping the allocated capacity
+  void reset() {
+    owned.clear();
+    input = {};
+    num_tokens = 0;
+    frames.clear();
+    tok = 0;
+    expect_key = false;
+    scratch_tok = npos;
+    num_unescaped = 0;
+    clear_error();
+  }
+
+  /// Reset and take json to be parsed next
+  void reset(std::string&& json) {
+    reset();
+    owned = std::move(json);
+    input = owned;
+  }
+
+  /// Reset and borrow json to be parsed next, it is not copied and must outlive the deserialization
+  void reset(std::string_view json) {
+    reset();
+    input = json;
+  }
+
+  void parse() {
+    if (input.size() > std::numeric_limits<uint32_t>::max())
+      return fail_at(0, "input too large");
+    if (index.size() < input.size())
+      index.resize(input.size());
+    if (!detail::find_structurals(input.data(), input.size(), index.data(), num_tokens))
+      return fail_at(input.size(), "unclosed string");
+    if (aux.size() < num_tokens)
+      aux.resize(num_tokens);
+    validate();
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Deserializer interface
+  //////////////////////////////////////////////////////////////////////////////
+
+  // Scalars ///////////////////////////////////////////////////////////////////
+  void deserialize_bool(bool& val) final { deserialize_scalar(val); }
+  void deserialize_i8(int8_t& val) final { deserialize_scalar(val); }
+  void deserialize_u8(uint8_t& val) final { deserialize_scalar(val); }
+  void deserialize_i16(int16_t& val) final { deserialize_scalar(val); }
+  void deserialize_u16(uint16_t& val) final { deserialize_scalar(val); }
+  void deserialize_i32(int32_t& val) final { deserialize_scalar(val); }
+  void deserialize_u32(uint32_t& val) final { deserialize_scalar(val); }
+  void deserialize_i64(int64_t& val) final { deserialize_scalar(val); }
+  void deserialize_u64(uint64_t& val) final { deserialize_scalar(val); }
+  void deserialize_float(float& val) final { deserialize_scalar(val); }
+  void deserialize_double(double& val) final { deserialize_scalar(val); }
+  void deserialize_uchar(unsigned char& val) final { deserialize_scalar(val); }
+
+  // chars are strings of one char
+  void deserialize_char(char& val) final {
+    size_t t;
+    std::string_view text;
+    if (!next_value(t) || !string_text(t, text)) return;
+    if (text.size() != 1)
+      return fail_at_token(t, "invalid scalar value");
+    val = text[0];
+    tok = t + 1;
+  }
+
+  void deserialize_cstr(char* val, size_t len) final {
+    size_t t;
+    std::string_view text;
+    if (!next_value(t) || !string_text(t, text)) return;
+    len = std::min(text.size() + 1, len);
+    if (len) {
+      std::memcpy(val, text.data(), len - 1);
+      val[len - 1] = '\0';
+    }
+    tok = t + 1;
+  }
+
+  // Strings without escapes point into the input, the others into a buffer kept by the deserializer
+  void deserialize_str(const char*& val, size_t& len) final {
+    size_t t;
+    std::string_view text;
+    if (!next_value(t) || !string_text(t, text)) return;
+    if (scratch_tok == t) {
+      if (num_unescaped == unescaped.size())
+        unescaped.emplace_back();
+      std::string& kept = unescaped[num_unescaped++];
+      kept.assign(text.data(), text.size());
+      text = kept;
+    }
+    val = text.data();
+    len = text.size();
+    tok = t + 1;
+  }
+
+  void deserialize_bytes(void* val, size_t len) final {
+    size_t t;
+    if (!next_value(t)) return;
+    if (!is_string(t))
+      return fail_at_token(t, expect_key ? "invalid base64 key" : "invalid base64 value");
+    const std::string_view raw = string_raw(t);
+    auto* out = static_cast<uint8_t*>(val);
+    if (len && !serde::fmt::base64_decode(raw.data(), raw.data() + raw.size(), out, out + len))
+      return fail_at_token(t, expect_key ? "invalid base64 key" : "invalid base64 value");
+    tok = t + 1;
+  }
+
+  // The unescaped string is kept for the deserialize_cstr() that follows
+  void deserialize_length(size_t& len) final {
+    size_t t;
+    std::string_view text;
+    if (!next_value(t) || !string_text(t, text)) return;
+    len = text.size();
+  }
+
+  // Optional //////////////////////////////////////////////////////////////////
+  void deserialize_is_some(bool& val) final {
+    size_t t;
+    if (!next_value(t)) return;
+    val = !is_null(t);
+  }
+
+  void deserialize_none() final {
+    size_t t;
+    if (!next_value(t)) return;
+    tok = t + 1;
+  }
+
+  // Sequence //////////////////////////////////////////////////////////////////
+  void deserialize_seq_begin() final { container_begin('[', "no sequence to begin"); }
+  void deserialize_seq_end() final { container_end(); }
+  void deserialize_seq_size(size_t& size) final { container_size('[', "no sequence to count", size); }
+
+  // Sequence of scalars ///////////////////////////////////////////////////////
+  // The elements are the tokens after the '[', every other one, converted in one loop
+  template<typename T>
+  void deserialize_seq_scalars(T* vals, size_t len) {
+    size_t t;
+    if (!next_value(t)) return;
+    if (input[index[t]] != '[')
+      return fail_at_token(t, "no sequence to deserialize");
+    if (aux[t].count != len)
+      return fail_at_token(t, "sequence length mismatch");
+    for (size_t i = 0; i < len; i++) {
+      if (!parse_scalar(t + 1 + 2 * i, vals[i]))
+        return;
+    }
+    tok = aux[t].match + 1;
+  }
+
+  void deserialize_seq_bool(bool* vals, size_t len) final { deserialize_seq_scalars(vals, len); }
+  void deserialize_seq_i8(int8_t* vals, size_t len) final { deserialize_seq_scalars(vals, len); }
+  void deserialize_seq_u8(uint8_t* vals, size_t len) final { deserialize_seq_scalars(vals, len); }
+  void deserialize_seq_i16(int16_t* vals, size_t len) final { deserialize_seq_scalars(vals, len); }
+  void deserialize_seq_u16(uint16_t* vals, size_t len) final { deserialize_seq_scalars(vals, len); }
+  void deserialize_seq_i32(int32_t* vals, size_t len) final { deserialize_seq_scalars(vals, len); }
+  void deserialize_seq_u32(uint32_t* vals, size_t len) final { deserialize_seq_scalars(vals, len); }
+  void deserialize_seq_i64(int64_t* vals, size_t len) final { deserialize_seq_scalars(vals, len); }
+  void deserialize_seq_u64(uint64_t* vals, size_t len) final { deserialize_seq_scalars(vals, len); }
+  void deserialize_seq_float(float* vals, size_t len) final { deserialize_seq_scalars(vals, len); }
+  void deserialize_seq_double(double* vals, size_t len) final { deserialize_seq_scalars(vals, len); }
+  void deserialize_seq_uchar(unsigned char* vals, size_t len) final { deserialize_seq_scalars(vals, len); }
+  void deserialize_seq_char(char* vals, size_t len) final {
+    // chars are strings, element by element
+    deserialize_seq_begin();
+    for (size_t i = 0; i < len && !has_error(); i++)
+      deserialize_char(vals[i]);
+    deserialize_seq_end();
+  }
+
+  // Map ///////////////////////////////////////////////////////////////////////
+  void deserialize_map_begin() final { container_begin('{', "no map to begin"); }
+  void deserialize_map_end() final { container_end(); }
+  void deserialize_map_size(size_t& size) final { container_size('{', "no map to count", size); }
+
+  void deserialize_map_key_begin() final { expect_key = true; }
+  void deserialize_map_key_end() final { expect_key = false; }
+
+  void deserialize_map_key_find(const char* key) final {
+    if (has_error()) return;
+    if (frames.empty() || input[index[frames.back()]] != '{')
+      return fail_at_token(tok, "no map to find key");
+    const size_t map = frames.back();
+    const size_t close = aux[map].match;
+    const std::string_view name(key);
+    // keys are usually in the same order as they are looked up (struct field order),
+    // so try the entry at the cursor before searching the whole object
+    size_t k = tok < close && input[index[tok]] == ',' ? tok + 1 : tok;
+    if (k >= close || !key_equals(k, name)) {
+      for (k = map + 1; k < close; k = skip_value(k + 2) + 1) {
+        if (key_equals(k, name))
+          break;
+      }
+      if (k >= close)
+        return fail_at_token(map, "key not found in map");
+    }
+    tok = k + 2;
+  }
+
+  void deserialize_map_value_begin() final {}
+  void deserialize_map_value_end() final {}
+
+  // Struct ////////////////////////////////////////////////////////////////////
+  void deserialize_struct_begin() final { deserialize_map_begin(); }
+  void deserialize_struct_end() final { deserialize_map_end(); }
+  void deserialize_struct_field_begin(const char* name) final { deserialize_map_key_find(name); }
+  void deserialize_struct_field_end() final {}
+
+private:
+  static constexpr size_t npos = size_t(-1);
+
+  // Per token, set for the '[' and '{' tokens only
+  struct Aux {
+    uint32_t match; // token of the matching ']' or '}'
+    uint32_t count; // number of elements, or entries for objects
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Parsing
+  //////////////////////////////////////////////////////////////////////////////
+
+  // Check the structure of the document in one pass over the tokens,
+  // matching the brackets and counting the elements of the containers
+  void validate() {
+    enum class Expect { Value, ValueOrClose, Key, KeyOrClose, Colon, CommaOrClose, End };
+    Expect expect = Expect::Value;
+    frames.clear(); // the open containers while validating
+    for (size_t t = 0; t < num_tokens; t++) {
+      const char c = input[index[t]];
+      const bool in_object = !frames.empty() && input[index[frames.back()]] == '{';
+      switch (c) {
+        case ':':
+          if (expect != Expect::Colon)
+            return fail_at_token(t, "unexpected ':'");
+          expect = Expect::Value;
+          break;
+        case ',':
+          if (expect != Expect::CommaOrClose)
+            return fail_at_token(t, "unexpected ','");
+          expect = in_object ? Expect::Key : Expect::Value;
+          break;
+        case ']':
+        case '}':
+          if (frames.empty() || in_object != (c == '}') ||
+              (expect != Expect::CommaOrClose && expect != (in_object ? Expect::KeyOrClose : Expect::ValueOrClose)))
+            return fail_at_token(t, c == '}' ? "unexpected '}'" : "unexpected ']'");
+          aux[frames.back()].match = uint32_t(t);
+          frames.pop_back();
+          expect = frames.empty() ? Expect::End : Expect::CommaOrClose;
+          break;
+        default:
+          if (c == '"' && (expect == Expect::Key || expect == Expect::KeyOrClose)) {
+            aux[frames.back()].count++;
+            expect = Expect::Colon;
+            break;
+          }
+          if (expect != Expect::Value && expect != Expect::ValueOrClose)
+            return fail_at_token(t, expect == Expect::End ? "unexpected content after the document"
+                                                          : "unexpected value");
+          if (!frames.empty() && !in_object)
+            aux[frames.back()].count++;
+          if (c == '[' || c == '{') {
+            aux[t] = {0, 0};
+            frames.push_back(t);
+            expect = c == '{' ? Expect::KeyOrClose : Expect::ValueOrClose;
+          }
+          else {
+            expect = frames.empty() ? Expect::End : Expect::CommaOrClose;
+          }
+          break;
+      }
+    }
+    if (expect != Expect::End)
+      return fail_at(input.size(), "unexpected end of input");
+    frames.clear();
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Deserialization Utils
+  //////////////////////////////////////////////////////////////////////////////
+
+  // Token of the next value, stepping over the ',' or ':' before it
+  bool next_value(size_t& t) {
+    if (has_error()) return false;
+    if (tok < num_tokens && (input[index[tok]] == ',' || input[index[tok]] == ':'))
+      tok++;
+    if (tok >= num_tokens || input[index[tok]] == ']' || input[index[tok]] == '}') {
+      fail_at_token(tok, "no value to extract");
+      return false;
+    }
+    t = tok;
+    return true;
+  }
+
+  // The token after the value at token t, jumping over nested containers
+  size_t skip_value(size_t t) const {
+    const char c = input[index[t]];
+    return (c == '[' || c == '{') ? aux[t].match + 1 : t + 1;
+  }
+
+  void container_begin(char open, const char* error) {
+    size_t t;
+    if (!next_value(t)) return;
+    if (input[index[t]] != open)
+      return fail_at_token(t, error);
+    frames.push_back(t);
+    tok = t + 1;
+  }
+
+  void container_end() {
+    if (has_error()) return;
+    tok = aux[frames.back()].match + 1;
+    frames.pop_back();
+  }
+
+  void container_size(char open, const char* error, size_t& size) {
+    size_t t;
+    if (!next_value(t)) return;
+    if (input[index[t]] != open)
+      return fail_at_token(t, error);
+    size = aux[t].count;
+  }
+
+  // End of the token t, the whitespace before the next token trimmed off
+  size_t token_end(size_t t) const {
+    size_t end = t + 1 < num_tokens ? index[t + 1] : input.size();
+    while (end > index[t] && detail::is_whitespace(input[end - 1]))
+      end--;
+    return end;
+  }
+
+  bool is_string(size_t t) const { return input[index[t]] == '"'; }
+
+  bool is_null(size_t t) const { return input.substr(index[t], token_end(t) - index[t]) == "null"; }
+
+  // Contents of the string at token t, escapes untouched. The grammar check
+  // guarantees the token is followed by an op or the end, so it ends on its closing quote.
+  std::string_view string_raw(size_t t) const {
+    const size_t begin = index[t] + 1;
+    return input.substr(begin, token_end(t) - 1 - begin);
+  }
+
+  // Contents of the string at token t, unescaped into scratch if it has escapes
+  bool string_text(size_t t, std::string_view& text) {
+    if (!is_string(t)) {
+      fail_at_token(t, expect_key ? "no string key to extract" : "no string to extract");
+      return false;
+    }
+    const std::string_view raw = string_raw(t);
+    if (raw.find('\\') == std::string_view::npos) {
+      text = raw;
+      return true;
+    }
+    if (scratch_tok != t) {
+      if (!detail::unescape(raw, scratch)) {
+        fail_at_token(t, "invalid string escape");
+        return false;
+      }
+      scratch_tok = t;
+    }
+    text = scratch;
+    return true;
+  }
+
+  bool key_equals(size_t t, std::string_view name) {
+    if (!is_string(t))
+      return false;
+    const std::string_view raw = string_raw(t);
+    if (raw.find('\\') == std::string_view::npos)
+      return raw == name;
+    std::string_view text;
+    return string_text(t, text) && text == name;
+  }
+
+  template<typename T>
+  void deserialize_scalar(T& val) {
+    size_t t;
+    if (!next_value(t)) return;
+    if (parse_scalar(t, val))
+      tok = t + 1;
+  }
+
+  // Convert the scalar at token t, numbers and bools in keys are quoted
+  template<typename T>
+  bool parse_scalar(size_t t, T& val) {
+    const bool quoted = is_string(t);
+    if (quoted != expect_key) {
+      fail_at_token(t, expect_key ? "invalid scalar key" : "invalid scalar value");
+      return false;
+    }
+    const std::string_view text = quoted ? string_raw(t) : input.substr(index[t], token_end(t) - index[t]);
+    serde::fmt::ParseStatus status;
+    if constexpr (std::is_same_v<T, bool>) {
+      status = serde::fmt::ParseStatus::Ok;
+      if (text == "true") val = true;
+      else if (text == "false") val = false;
+      else status = serde::fmt::ParseStatus::Invalid;
+    }
+    else if constexpr (std::is_floating_point_v<T>) {
+      // non finite numbers are serialized as null
+      if (text == "null") {
+        val = std::numeric_limits<T>::quiet_NaN();
+        return true;
+      }
+      status = serde::fmt::parse_float(text.data(), text.data() + text.size(), val);
+    }
+    else {
+      status = serde::fmt::parse_int(text.data(), text.data() + text.size(), val);
+    }
+    if (status != serde::fmt::ParseStatus::Ok) {
+      fail_at_token(t, status == serde::fmt::ParseStatus::OutOfRange ? "number out of range"
+                                                                      : expect_key ? "invalid scalar key"
+                                                                                   : "invalid scalar value");
+      return false;
+    }
+    return true;
+  }
+
+  void fail_at_token(size_t t, const char* text) {
+    fail_at(t < num_tokens ? index[t] : input.size(), text);
+  }
+
+  // Set the error at the line and column (1-based) of the byte offset in the input
+  void fail_at(size_t offset, const char* text) {
+    const std::string_view before = input.substr(0, offset);
+    const size_t line_start = before.rfind('\n') + 1; // npos + 1 == 0
+    const size_t line = 1 + size_t(std::count(before.begin(), before.end(), '\n'));
+    set_error({serde::Error::Kind::Invalid, line, offset - line_start + 1, text});
+  }
+
+  std::string owned;             // input, when owned
+  std::string_view input;
+  std::vector<uint32_t> index;   // input offsets of the structural tokens, capacity kept
+  size_t num_tokens = 0;
+  std::vector<Aux> aux;          // per token, capacity kept
+  std::vector<size_t> frames;    // tokens of the open containers
+  size_t tok = 0;                // next token to deserialize
+  bool expect_key = false;
+  std::string scratch;           // unescaped string of token scratch_tok
+  size_t scratch_tok = npos;
+  std::deque<std::string> unescaped; // borrowed strings which had escapes, reused
+  size_t num_unescaped = 0;
+};
+
+/// JSON Deserializer function from json string to T, statically dispatched.
+/// Same result as from_str(), but the JsonDeserializer calls are inlined into
+/// the deserialization of T instead of going through the Deserializer vtable.
+template<typename T>
+auto from_str_static(std::string&& str) -> cpp::result<T, serde::Error>
+{
+  JsonDeserializer de(std::move(str));
+  de.parse();
+  T obj{};
+  de.deserialize(obj);
+  if (de.has_error())
+    return cpp::fail(de.error());
+  return std::move(obj);
+}
+
+} // namespace serde_json
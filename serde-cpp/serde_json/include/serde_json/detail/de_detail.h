@@ -0,0 +1,20 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <serde/error.h>
+#include <serde/result.hpp>
+#include <serde/de/deserializer.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// Serde JSON detail
+///////////////////////////////////////////////////////////////////////////////
+namespace serde_json::detail {
+
+auto DeserializerNew(std::string&& str) -> std::unique_ptr<serde::Deserializer>;
+// Deserializer borrowing str
+auto DeserializerNew(std::string_view str) -> std::unique_ptr<serde::Deserializer>;
+auto DeserializerParse(serde::Deserializer* de) -> cpp::result<void, serde::Error>;
+
+} // namespace serde_json::detail
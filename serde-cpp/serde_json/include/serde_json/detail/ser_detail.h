@@ -0,0 +1,15 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <serde/ser/serializer.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// Serde JSON detail
+///////////////////////////////////////////////////////////////////////////////
+namespace serde_json::detail {
+
+// Serializer appending to out
+auto SerializerNew(std::string& out) -> std::unique_ptr<serde::Serializer>;
+
+} // namespace serde_json::detail
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+///////////////////////////////////////////////////////////////////////////////
+// Serde JSON detail
+///////////////////////////////////////////////////////////////////////////////
+namespace serde_json::detail {
+
+inline bool is_whitespace(char c) {
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+// Escape of each char in strings, 0 if written as is, 'u' for \u00XX
+struct EscapeTable {
+  char escape[256];
+};
+
+constexpr EscapeTable make_escape_table() {
+  EscapeTable table{};
+  for (int c = 0; c < 0x20; c++)
+    table.escape[c] = 'u';
+  table.escape[uint8_t('"')] = '"';
+  table.escape[uint8_t('\\')] = '\\';
+  table.escape[uint8_t('\b')] = 'b';
+  table.escape[uint8_t('\f')] = 'f';
+  table.escape[uint8_t('\n')] = 'n';
+  table.escape[uint8_t('\r')] = 'r';
+  table.escape[uint8_t('\t')] = 't';
+  return table;
+}
+
+inline constexpr EscapeTable escape_table = make_escape_table();
+
+/// Append str to out as a quoted JSON string, escaping quotes, backslashes and control chars.
+/// Other chars, UTF-8 sequences included, are copied as they are, in runs between escapes.
+inline void append_quoted(std::string& out, const char* str, size_t len) {
+  static constexpr char hex[] = "0123456789abcdef";
+  out.push_back('"');
+  size_t run = 0;
+  for (size_t i = 0; i < len; i++) {
+    const char esc = escape_table.escape[uint8_t(str[i])];
+    if (!esc)
+      continue;
+    out.append(str + run, i - run);
+    run = i + 1;
+    if (esc == 'u') {
+      const char code[] = {'\\', 'u', '0', '0', hex[uint8_t(str[i]) >> 4], hex[uint8_t(str[i]) & 0xF]};
+      out.append(code, sizeof(code));
+    }
+    else {
+      const char code[] = {'\\', esc};
+      out.append(code, sizeof(code));
+    }
+  }
+  out.append(str + run, len - run);
+  out.push_back('"');
+}
+
+inline int hex_value(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+inline bool parse_hex4(const char* p, uint32_t& code) {
+  code = 0;
+  for (int i = 0; i < 4; i++) {
+    const int v = hex_value(p[i]);
+    if (v < 0)
+      return false;
+    code = code << 4 | uint32_t(v);
+  }
+  return true;
+}
+
+inline void append_utf8(std::string& out, uint32_t code) {
+  if (code < 0x80) {
+    out.push_back(char(code));
+  }
+  else if (code < 0x800) {
+    out.push_back(char(0xC0 | code >> 6));
+    out.push_back(char(0x80 | (code & 0x3F)));
+  }
+  else if (code < 0x10000) {
+    out.push_back(char(0xE0 | code >> 12));
+    out.push_back(char(0x80 | (code >> 6 & 0x3F)));
+    out.push_back(char(0x80 | (code & 0x3F)));
+  }
+  else {
+    out.push_back(char(0xF0 | code >> 18));
+    out.push_back(char(0x80 | (code >> 12 & 0x3F)));
+    out.push_back(char(0x80 | (code >> 6 & 0x3F)));
+    out.push_back(char(0x80 | (code & 0x3F)));
+  }
+}
+
+/// Unescape the contents of a JSON string (between the quotes) into out, replacing it.
+/// \uXXXX escapes are converted to UTF-8, surrogate pairs included.
+/// Returns false on an invalid escape.
+inline bool unescape(std::string_view raw, std::string& out) {
+  out.clear();
+  size_t i = 0;
+  while (i < raw.size()) {
+    const size_t backslash = raw.find('\\', i);
+    if (backslash == std::string_view::npos) {
+      out.append(raw.data() + i, raw.size() - i);
+      break;
+    }
+    out.append(raw.data() + i, backslash - i);
+    i = backslash + 1;
+    if (i == raw.size())
+      return false;
+    switch (raw[i++]) {
+      case '"': out.push_back('"'); break;
+      case '\\': out.push_back('\\'); break;
+      case '/': out.push_back('/'); break;
+      case 'b': out.push_back('\b'); break;
+      case 'f': out.push_back('\f'); break;
+      case 'n': out.push_back('\n'); break;
+      case 'r': out.push_back('\r'); break;
+      case 't': out.push_back('\t'); break;
+      case 'u': {
+        uint32_t code;
+        if (raw.size() - i < 4 || !parse_hex4(raw.data() + i, code))
+          return false;
+        i += 4;
+        if (code >= 0xD800 && code < 0xDC00) {
+          // high surrogate, must be followed by the \u escape of a low one
+          uint32_t low;
+          if (raw.size() - i < 6 || raw[i] != '\\' || raw[i + 1] != 'u' || !parse_hex4(raw.data() + i + 2, low) ||
+              low < 0xDC00 || low >= 0xE000)
+            return false;
+          i += 6;
+          code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+        }
+        else if (code >= 0xDC00 && code < 0xE000) {
+          return false;
+        }
+        append_utf8(out, code);
+        break;
+      }
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+} // namespace serde_json::detail
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+///////////////////////////////////////////////////////////////////////////////
+// Serde JSON detail
+///////////////////////////////////////////////////////////////////////////////
+namespace serde_json::detail {
+
+/// Instruction sets of the structural scanner block loop, chosen at runtime
+enum class ScanIsa { Scalar, SSE2, AVX2 };
+
+ScanIsa scan_isa();
+
+/// First pass of the JSON parser: index the structural characters of [json, json + len).
+///
+/// Writes to index the position of every { } [ ] : , outside of strings, the opening
+/// quote of every string and the first character of every other scalar (number, true,
+/// false, null), in order. The input is classified 64 bytes at a time into bitmasks,
+/// with SIMD compares where available, and the bits inside strings are masked out
+/// with a prefix xor of the unescaped quotes, so there is no per-character branching.
+///
+/// index must have room for len positions (there is at most one per input character),
+/// count is set to the number written. Returns false if the input ends inside a string.
+/// Positions are 32-bit, the input must be shorter than 4 GiB.
+bool find_structurals(const char* json, size_t len, uint32_t* index, size_t& count);
+
+/// Same as find_structurals(), with the given instruction set (for tests and benchmarks)
+bool find_structurals(ScanIsa isa, const char* json, size_t len, uint32_t* index, size_t& count);
+
+} // namespace serde_json::detail
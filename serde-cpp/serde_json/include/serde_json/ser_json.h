@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+#include <serde/ser.h>
+#include <serde/error.h>
+#include <serde/result.hpp>
+
+#include "detail/ser_detail.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// Serde JSON
+///////////////////////////////////////////////////////////////////////////////
+namespace serde_json {
+
+/// JSON Serializer function from T to json string
+template<typename T>
+auto to_string(T&& obj) -> cpp::result<std::string, serde::Error>
+{
+  std::string out;
+  auto ser = detail::SerializerNew(out);
+  ser->serialize(std::forward<T>(obj));
+  return out;
+}
+
+/// JSON Serializer function from T to json string, appended to out
+template<typename T>
+auto to_string(T&& obj, std::string& out) -> cpp::result<void, serde::Error>
+{
+  auto ser = detail::SerializerNew(out);
+  ser->serialize(std::forward<T>(obj));
+  return {};
+}
+
+} // namespace serde_json
@@ -0,0 +1,5 @@
+#pragma once
+
+// include serialization and deserialization
+#include "ser_json.h"
+#include "de_json.h"
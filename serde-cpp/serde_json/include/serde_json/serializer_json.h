@@ -0,0 +1,243 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <serde/ser.h>
+#include <serde/error.h>
+#include <serde/result.hpp>
+#include <serde/fmt/base64.h>
+#include <serde/fmt/number.h>
+
+#include "detail/string_json.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Serde JSON
+////////////////////////////////////////////////////////////////////////////////
+namespace serde_json {
+
+/// JSON Serializer
+///
+/// Writes compact JSON text straight to the output string as the values are serialized,
+/// there is no intermediate document tree. The output string is owned by the caller and
+/// is appended to, so it can be reused (cleared) across documents.
+///
+/// Structs and maps are objects, sequences are arrays. JSON keys are strings, so map keys
+/// which are numbers or bools are written quoted, e.g. {"1":"one"}. chars are strings of
+/// one char, bytes are base64 strings, and non finite floats are written as null.
+class JsonSerializer final : public serde::StaticSerializer<JsonSerializer> {
+public:
+  explicit JsonSerializer(std::string& out) : out(&out) {}
+
+  /// Serialize a new document, keeping the allocated capacity.
+  /// Anything already written to the output string is left there.
+  void reset() {
+    frames.clear();
+    expect_key = false;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Serializer interface
+  //////////////////////////////////////////////////////////////////////////////
+
+  // Scalars ///////////////////////////////////////////////////////////////////
+  void serialize_bool(bool v) final { value_begin(); write_key_scalar(v ? "true" : "false", v ? 4 : 5); }
+  void serialize_i8(int8_t v) final { value_begin(); write_number(v); }
+  void serialize_u8(uint8_t v) final { value_begin(); write_number(v); }
+  void serialize_i16(int16_t v) final { value_begin(); write_number(v); }
+  void serialize_u16(uint16_t v) final { value_begin(); write_number(v); }
+  void serialize_i32(int32_t v) final { value_begin(); write_number(v); }
+  void serialize_u32(uint32_t v) final { value_begin(); write_number(v); }
+  void serialize_i64(int64_t v) final { value_begin(); write_number(v); }
+  void serialize_u64(uint64_t v) final { value_begin(); write_number(v); }
+  void serialize_float(float v) final { value_begin(); write_number(v); }
+  void serialize_double(double v) final { value_begin(); write_number(v); }
+  void serialize_char(char v) final { value_begin(); detail::append_quoted(*out, &v, 1); }
+  void serialize_uchar(unsigned char v) final { value_begin(); write_number(v); }
+  void serialize_str(const char* v, size_t len) final { value_begin(); detail::append_quoted(*out, v, len); }
+  void serialize_bytes(const void* val, size_t len) final {
+    value_begin();
+    out->push_back('"');
+    serde::fmt::base64_encode(val, len, *out);
+    out->push_back('"');
+  }
+
+  // Optional //////////////////////////////////////////////////////////////////
+  void serialize_none() final { value_begin(); out->append("null", 4); }
+
+  // Sequence //////////////////////////////////////////////////////////////////
+  void serialize_seq_begin() final { container_begin('[', false); }
+  void serialize_seq_end() final { container_end(']'); }
+
+  // Sequence of scalars ///////////////////////////////////////////////////////
+  void serialize_seq_bool(const bool* vals, size_t len) final {
+    value_begin();
+    out->push_back('[');
+    for (size_t i = 0; i < len; i++) {
+      if (i) out->push_back(',');
+      vals[i] ? out->append("true", 4) : out->append("false", 5);
+    }
+    out->push_back(']');
+  }
+  void serialize_seq_i8(const int8_t* vals, size_t len) final { serialize_seq_numbers(vals, len); }
+  void serialize_seq_u8(const uint8_t* vals, size_t len) final { serialize_seq_numbers(vals, len); }
+  void serialize_seq_i16(const int16_t* vals, size_t len) final { serialize_seq_numbers(vals, len); }
+  void serialize_seq_u16(const uint16_t* vals, size_t len) final { serialize_seq_numbers(vals, len); }
+  void serialize_seq_i32(const int32_t* vals, size_t len) final { serialize_seq_numbers(vals, len); }
+  void serialize_seq_u32(const uint32_t* vals, size_t len) final { serialize_seq_numbers(vals, len); }
+  void serialize_seq_i64(const int64_t* vals, size_t len) final { serialize_seq_numbers(vals, len); }
+  void serialize_seq_u64(const uint64_t* vals, size_t len) final { serialize_seq_numbers(vals, len); }
+  void serialize_seq_float(const float* vals, size_t len) final { serialize_seq_numbers(vals, len); }
+  void serialize_seq_double(const double* vals, size_t len) final { serialize_seq_numbers(vals, len); }
+  void serialize_seq_uchar(const unsigned char* vals, size_t len) final { serialize_seq_numbers(vals, len); }
+  void serialize_seq_char(const char* vals, size_t len) final {
+    value_begin();
+    out->push_back('[');
+    for (size_t i = 0; i < len; i++) {
+      if (i) out->push_back(',');
+      detail::append_quoted(*out, vals + i, 1);
+    }
+    out->push_back(']');
+  }
+
+  // Map ///////////////////////////////////////////////////////////////////////
+  void serialize_map_begin() final { container_begin('{', true); }
+  void serialize_map_end() final { container_end('}'); }
+
+  void serialize_map_key_begin() final {
+    entry_begin();
+    expect_key = true;
+  }
+  void serialize_map_key_end() final {
+    expect_key = false;
+    out->push_back(':');
+  }
+  void serialize_map_value_begin() final {}
+  void serialize_map_value_end() final {}
+
+  // Struct ////////////////////////////////////////////////////////////////////
+  void serialize_struct_begin() final { container_begin('{', true); }
+  void serialize_struct_end() final { container_end('}'); }
+
+  void serialize_struct_field_begin(const char* name) final {
+    entry_begin();
+    detail::append_quoted(*out, name, std::char_traits<char>::length(name));
+    out->push_back(':');
+  }
+  void serialize_struct_field_end() final {}
+
+private:
+  struct Frame {
+    bool object;
+    bool first; // no element written yet
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Serialization Utils
+  //////////////////////////////////////////////////////////////////////////////
+
+  // Separate array elements, object values follow their key and its ':'
+  void value_begin() {
+    if (frames.empty() || frames.back().object)
+      return;
+    if (!frames.back().first)
+      out->push_back(',');
+    frames.back().first = false;
+  }
+
+  void entry_begin() {
+    if (frames.empty())
+      return;
+    if (!frames.back().first)
+      out->push_back(',');
+    frames.back().first = false;
+  }
+
+  void container_begin(char open, bool object) {
+    value_begin();
+    frames.push_back(Frame{object, true});
+    out->push_back(open);
+  }
+
+  void container_end(char close) {
+    if (!frames.empty())
+      frames.pop_back();
+    out->push_back(close);
+  }
+
+  // Scalars other than strings are quoted in keys
+  void write_key_scalar(const char* text, size_t len) {
+    if (expect_key) out->push_back('"');
+    out->append(text, len);
+    if (expect_key) out->push_back('"');
+  }
+
+  template<typename T>
+  static char* format_number(char* first, char* last, T v) {
+    if constexpr (std::is_floating_point_v<T>) {
+      if (!std::isfinite(v)) {
+        std::char_traits<char>::copy(first, "null", 4);
+        return first + 4;
+      }
+      return serde::fmt::format_float(first, last, v);
+    }
+    else {
+      return serde::fmt::format_int(first, last, v);
+    }
+  }
+
+  template<typename T>
+  void write_number(T v) {
+    char buf[serde::fmt::number_max_chars];
+    char* end = format_number(buf, buf + sizeof(buf), v);
+    write_key_scalar(buf, size_t(end - buf));
+  }
+
+  template<typename T>
+  void serialize_seq_numbers(const T* vals, size_t len) {
+    value_begin();
+    // format the elements into the output directly, growing it for the worst case once
+    const size_t pos = out->size();
+    out->resize(pos + 2 + len * (serde::fmt::number_max_chars + 1));
+    char* first = out->data() + pos;
+    char* last = out->data() + out->size();
+    char* p = first;
+    *p++ = '[';
+    for (size_t i = 0; i < len; i++) {
+      if (i) *p++ = ',';
+      p = format_number(p, last, vals[i]);
+    }
+    *p++ = ']';
+    out->resize(pos + size_t(p - first));
+  }
+
+  std::string* out;
+  std::vector<Frame> frames;
+  bool expect_key = false;
+};
+
+/// JSON Serializer function from T to json string, statically dispatched.
+/// Same output as to_string(), with the serializer calls resolved at compile time.
+template<typename T>
+auto to_string_static(T&& obj) -> cpp::result<std::string, serde::Error>
+{
+  std::string out;
+  JsonSerializer ser(out);
+  ser.serialize(std::forward<T>(obj));
+  return out;
+}
+
+/// JSON Serializer function from T to json string appended to out, statically dispatched
+template<typename T>
+auto to_string_static(T&& obj, std::string& out) -> cpp::result<void, serde::Error>
+{
+  JsonSerializer ser(out);
+  ser.serialize(std::forward<T>(obj));
+  return {};
+}
+
+} // namespace serde_json
@@ -0,0 +1,34 @@
+#include "serde_json/de_json.h"
+#include "serde_json/deserializer_json.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Serde JSON
+////////////////////////////////////////////////////////////////////////////////
+namespace serde_json {
+
+namespace detail {
+
+auto DeserializerNew(std::string&& str) -> std::unique_ptr<serde::Deserializer>
+{
+  return std::make_unique<JsonDeserializer>(std::move(str));
+}
+
+auto DeserializerNew(std::string_view str) -> std::unique_ptr<serde::Deserializer>
+{
+  auto de = std::make_unique<JsonDeserializer>();
+  de->reset(str);
+  return de;
+}
+
+auto DeserializerParse(serde::Deserializer* de) -> cpp::result<void, serde::Error>
+{
+  auto jsonde = static_cast<JsonDeserializer*>(de);
+  jsonde->parse();
+  if (jsonde->has_error())
+    return cpp::fail(jsonde->error());
+  return {};
+}
+
+} // namespace detail
+
+} // namespace serde_json
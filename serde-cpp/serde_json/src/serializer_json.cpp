@@ -0,0 +1,18 @@
+#include "serde_json/ser_json.h"
+#include "serde_json/serializer_json.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Serde JSON
+////////////////////////////////////////////////////////////////////////////////
+namespace serde_json {
+
+namespace detail {
+
+auto SerializerNew(std::string& out) -> std::unique_ptr<serde::Serializer>
+{
+  return std::make_unique<JsonSerializer>(out);
+}
+
+} // namespace detail
+
+} // namespace serde_json
@@ -0,0 +1,220 @@
+#include "serde_json/detail/structural.h"
+
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SERDE_JSON_X86 1
+#include <immintrin.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// Serde JSON
+////////////////////////////////////////////////////////////////////////////////
+namespace serde_json {
+
+namespace detail {
+
+// The block loop follows Geoff Langdale and Daniel Lemire,
+// "Parsing Gigabytes of JSON per Second" (2019), stage 1 of simdjson.
+
+namespace {
+
+// Character classes of a 64-byte block, one bit per byte
+struct BlockMasks {
+  uint64_t quote;
+  uint64_t backslash;
+  uint64_t op;         // { } [ ] : ,
+  uint64_t whitespace; // space \t \n \r
+};
+
+// Carried from one block to the next
+struct ScanState {
+  uint64_t prev_escaped = 0;   // the first char of the next block is escaped
+  uint64_t prev_in_string = 0; // all ones if the block ended inside a string
+  uint64_t prev_scalar = 0;    // the block ended with a scalar char
+};
+
+enum CharClass : uint8_t { Quote = 1, Backslash = 2, Op = 4, Whitespace = 8 };
+
+struct ClassTable {
+  uint8_t cls[256];
+};
+
+constexpr ClassTable make_class_table() {
+  ClassTable table{};
+  table.cls[uint8_t('"')] = Quote;
+  table.cls[uint8_t('\\')] = Backslash;
+  for (const char* c = "{}[]:,"; *c; c++)
+    table.cls[uint8_t(*c)] = Op;
+  for (const char* c = " \t\n\r"; *c; c++)
+    table.cls[uint8_t(*c)] = Whitespace;
+  return table;
+}
+
+constexpr ClassTable class_table = make_class_table();
+
+BlockMasks classify_scalar(const uint8_t* in) {
+  BlockMasks m{};
+  for (size_t i = 0; i < 64; i++) {
+    const uint8_t cls = class_table.cls[in[i]];
+    m.quote |= uint64_t(cls == Quote) << i;
+    m.backslash |= uint64_t(cls == Backslash) << i;
+    m.op |= uint64_t(cls == Op) << i;
+    m.whitespace |= uint64_t(cls == Whitespace) << i;
+  }
+  return m;
+}
+
+#if defined(SERDE_JSON_X86)
+// '[' | 0x20 == '{' and ']' | 0x20 == '}', no other byte maps to those
+__attribute__((target("sse2")))
+void classify16_sse2(__m128i v, BlockMasks& m, unsigned shift) {
+  const __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+  const __m128i op = _mm_or_si128(
+      _mm_or_si128(_mm_cmpeq_epi8(lower, _mm_set1_epi8('{')), _mm_cmpeq_epi8(lower, _mm_set1_epi8('}'))),
+      _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(':')), _mm_cmpeq_epi8(v, _mm_set1_epi8(','))));
+  const __m128i ws = _mm_or_si128(
+      _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+      _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))));
+  m.quote |= uint64_t(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('"'))))) << shift;
+  m.backslash |= uint64_t(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))))) << shift;
+  m.op |= uint64_t(uint32_t(_mm_movemask_epi8(op))) << shift;
+  m.whitespace |= uint64_t(uint32_t(_mm_movemask_epi8(ws))) << shift;
+}
+
+__attribute__((target("sse2")))
+BlockMasks classify_sse2(const uint8_t* in) {
+  BlockMasks m{};
+  for (unsigned i = 0; i < 4; i++)
+    classify16_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 16 * i)), m, 16 * i);
+  return m;
+}
+
+__attribute__((target("avx2")))
+void classify32_avx2(__m256i v, BlockMasks& m, unsigned shift) {
+  const __m256i lower = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+  const __m256i op = _mm256_or_si256(
+      _mm256_or_si256(_mm256_cmpeq_epi8(lower, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(lower, _mm256_set1_epi8('}'))),
+      _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(':')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8(','))));
+  const __m256i ws = _mm256_or_si256(
+      _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t'))),
+      _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r'))));
+  m.quote |= uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"'))))) << shift;
+  m.backslash |= uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'))))) << shift;
+  m.op |= uint64_t(uint32_t(_mm256_movemask_epi8(op))) << shift;
+  m.whitespace |= uint64_t(uint32_t(_mm256_movemask_epi8(ws))) << shift;
+}
+
+__attribute__((target("avx2")))
+BlockMasks classify_avx2(const uint8_t* in) {
+  BlockMasks m{};
+  classify32_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in)), m, 0);
+  classify32_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 32)), m, 32);
+  return m;
+}
+#endif
+
+// Each bit set to the xor of itself and all the bits below it:
+// from the quote bits, the bits from an opening quote up to (not including) its closing quote
+inline uint64_t prefix_xor(uint64_t x) {
+  x ^= x << 1;
+  x ^= x << 2;
+  x ^= x << 4;
+  x ^= x << 8;
+  x ^= x << 16;
+  x ^= x << 32;
+  return x;
+}
+
+// Characters escaped by a backslash, an odd number of backslashes escapes the char after them
+inline uint64_t find_escaped(uint64_t backslash, ScanState& state) {
+  backslash &= ~state.prev_escaped;
+  const uint64_t follows_escape = backslash << 1 | state.prev_escaped;
+  // sequences of backslashes starting on odd bits carry into the bit after them when added
+  const uint64_t even_bits = 0x5555555555555555ULL;
+  const uint64_t odd_sequence_starts = backslash & ~even_bits & ~follows_escape;
+  uint64_t sequences_starting_on_even_bits;
+  state.prev_escaped = __builtin_add_overflow(odd_sequence_starts, backslash, &sequences_starting_on_even_bits);
+  const uint64_t invert_mask = sequences_starting_on_even_bits << 1;
+  return (even_bits ^ invert_mask) & follows_escape;
+}
+
+inline uint64_t block_structurals(const BlockMasks& m, ScanState& state) {
+  const uint64_t quote = m.quote & ~find_escaped(m.backslash, state);
+  const uint64_t in_string = prefix_xor(quote) ^ state.prev_in_string;
+  state.prev_in_string = uint64_t(int64_t(in_string) >> 63);
+
+  // scalars start on a char that is not an op, whitespace nor quote, and doesn't follow one such char
+  const uint64_t scalar = ~(m.op | m.whitespace | quote);
+  const uint64_t scalar_start = scalar & ~(scalar << 1 | state.prev_scalar);
+  state.prev_scalar = scalar >> 63;
+
+  const uint64_t string_start = quote & in_string;
+  return ((m.op | scalar_start) & ~in_string) | string_start;
+}
+
+inline uint32_t* flatten(uint32_t* out, uint32_t base, uint64_t bits) {
+  while (bits) {
+    *out++ = base + uint32_t(__builtin_ctzll(bits));
+    bits &= bits - 1;
+  }
+  return out;
+}
+
+template<BlockMasks (*classify)(const uint8_t*)>
+bool scan(const char* json, size_t len, uint32_t* index, size_t& count) {
+  const auto* in = reinterpret_cast<const uint8_t*>(json);
+  uint32_t* out = index;
+  ScanState state;
+  size_t pos = 0;
+  for (; pos + 64 <= len; pos += 64)
+    out = flatten(out, uint32_t(pos), block_structurals(classify(in + pos), state));
+  if (pos < len) {
+    // the tail is padded with whitespace, which adds no structurals
+    uint8_t block[64];
+    std::memset(block, ' ', sizeof(block));
+    std::memcpy(block, in + pos, len - pos);
+    out = flatten(out, uint32_t(pos), block_structurals(classify(block), state));
+  }
+  count = size_t(out - index);
+  return !state.prev_in_string;
+}
+
+ScanIsa detect_scan_isa() {
+#if defined(SERDE_JSON_X86)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    return ScanIsa::AVX2;
+  if (__builtin_cpu_supports("sse2"))
+    return ScanIsa::SSE2;
+#endif
+  return ScanIsa::Scalar;
+}
+
+} // namespace
+
+ScanIsa scan_isa()
+{
+  static const ScanIsa isa = detect_scan_isa();
+  return isa;
+}
+
+bool find_structurals(ScanIsa isa, const char* json, size_t len, uint32_t* index, size_t& count)
+{
+  switch (isa) {
+#if defined(SERDE_JSON_X86)
+    case ScanIsa::AVX2: return scan<classify_avx2>(json, len, index, count);
+    case ScanIsa::SSE2: return scan<classify_sse2>(json, len, index, count);
+#endif
+    default: return scan<classify_scalar>(json, len, index, count);
+  }
+}
+
+bool find_structurals(const char* json, size_t len, uint32_t* index, size_t& count)
+{
+  return find_structurals(scan_isa(), json, len, index, count);
+}
+
+} // namespace detail
+
+} // namespace serde_json
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include <cfloat>
+#include <climits>
+#include <random>
+
+#include "serde/std.h"
+#include "serde/serde.h"
+#include "serde_json/serde_json.h"
+#include "serde_json/serializer_json.h"
+#include "serde_json/deserializer_json.h"
+#include "serde_json/detail/structural.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// Scalars
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+static void roundtrip(T val, const char* json)
+{
+  auto str = serde_json::to_string(val).value();
+  EXPECT_EQ(str, json);
+  auto de_val = serde_json::from_str<T>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Builtin, Int_Limits)
+{
+  roundtrip<int16_t>(INT16_MIN, "-32768");
+  roundtrip<uint16_t>(UINT16_MAX, "65535");
+  roundtrip<int32_t>(INT32_MIN, "-2147483648");
+  roundtrip<int64_t>(INT64_MIN, "-9223372036854775808");
+  roundtrip<uint64_t>(UINT64_MAX, "18446744073709551615");
+}
+
+TEST(Builtin, Float_Shortest)
+{
+  roundtrip<double>(0.1, "0.1");
+  roundtrip<double>(-DBL_MAX, "-1.7976931348623157e+308");
+  roundtrip<float>(3.14f, "3.14");
+}
+
+TEST(Builtin, Bool_Char)
+{
+  roundtrip<bool>(true, "true");
+  roundtrip<bool>(false, "false");
+  roundtrip<char>('"', "\"\\\"\"");
+  roundtrip<unsigned char>(200, "200");
+}
+
+TEST(Builtin, Bytes)
+{
+  struct Blob {
+    uint8_t data[3];
+    void serialize(serde::Serializer& ser) const { ser.serialize_bytes(data, sizeof(data)); }
+    void deserialize(serde::Deserializer& de) { de.deserialize_bytes(data, sizeof(data)); }
+  };
+  const Blob val{{'f', 'o', 'o'}};
+  auto str = serde_json::to_string(val).value();
+  EXPECT_EQ(str, "\"Zm9v\"");
+  auto de_val = serde_json::from_str<Blob>(std::move(str)).value();
+  EXPECT_EQ(std::memcmp(de_val.data, val.data, sizeof(val.data)), 0);
+}
+
+TEST(Builtin, Bytes_ShortContents)
+{
+  // 24 bytes (a whole AVX2 block) decoded into a larger buffer leave the rest of it untouched
+  struct Blob {
+    uint8_t data[100];
+    void deserialize(serde::Deserializer& de) { de.deserialize_bytes(data, sizeof(data)); }
+  };
+  uint8_t bytes[24];
+  for (size_t i = 0; i < sizeof(bytes); i++)
+    bytes[i] = static_cast<uint8_t>(i + 1);
+  std::string str = "\"";
+  serde::fmt::base64_encode(bytes, sizeof(bytes), str);
+  str += '"';
+  Blob blob;
+  std::memset(blob.data, 0xAA, sizeof(blob.data));
+  serde_json::JsonDeserializer de(str);
+  de.parse();
+  de.deserialize(blob);
+  ASSERT_FALSE(de.has_error());
+  EXPECT_EQ(std::memcmp(blob.data, bytes, sizeof(bytes)), 0);
+  for (size_t i = sizeof(bytes); i < sizeof(blob.data); i++)
+    ASSERT_EQ(blob.data[i], 0xAA) << i;
+}
+
+TEST(Builtin, MapKeys_Quoted)
+{
+  using Type = std::map<bool, std::map<double, char>>;
+  const Type val = {{false, {{0.5, 'a'}}}, {true, {}}};
+  auto str = serde_json::to_string(val).value();
+  EXPECT_EQ(str, R"({"false":{"0.5":"a"},"true":{}})");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Static dispatch and reuse
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Builtin, Static_SameText)
+{
+  using Type = std::map<std::string, std::vector<std::optional<double>>>;
+  const Type val = {{"a", {1.5, std::nullopt}}, {"b\"", {}}};
+  auto str = serde_json::to_string(val).value();
+  EXPECT_EQ(serde_json::to_string_static(val).value(), str);
+  auto de_val = serde_json::from_str_static<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Builtin, Reuse_Deserializer)
+{
+  serde_json::JsonDeserializer de;
+  for (int i = 0; i < 3; i++) {
+    const std::string json = "[" + std::to_string(i) + ", \"s\\n\"]";
+    de.reset(std::string_view(json));
+    de.parse();
+    std::tuple<int, std::string> val;
+    de.deserialize(val);
+    ASSERT_FALSE(de.has_error());
+    EXPECT_EQ(val, std::make_tuple(i, std::string("s\n")));
+  }
+}
+
+// Deserializes a json string field with a nested from_str() call
+struct Embedded {
+  std::vector<int> inner;
+  int after = 0;
+
+  void deserialize(serde::Deserializer& de) {
+    std::string text;
+    de.deserialize_struct_begin();
+    de.deserialize_struct_field("text", text);
+    inner = serde_json::from_str<std::vector<int>>(std::string_view(text)).value();
+    de.deserialize_struct_field("after", after);
+    de.deserialize_struct_end();
+  }
+};
+
+TEST(Builtin, FromStrView_Nested)
+{
+  // the nested call must not clobber the outer parse
+  const std::string_view json = R"({"text": "[1, 2]", "after": 3})";
+  auto val = serde_json::from_str<Embedded>(json).value();
+  EXPECT_EQ(val.inner, (std::vector<int>{1, 2}));
+  EXPECT_EQ(val.after, 3);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Structural scanner
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Builtin, Structurals_SameOnAllIsa)
+{
+  using serde_json::detail::ScanIsa;
+  std::mt19937 rng(42);
+  const char alphabet[] = "{}[]:, \n\"\\ab1";
+  for (int n = 0; n < 2000; n++) {
+    std::string json;
+    for (size_t i = rng() % 200; i > 0; i--)
+      json += alphabet[rng() % (sizeof(alphabet) - 1)];
+    std::vector<uint32_t> expected(json.size()), index(json.size());
+    size_t expected_count = 0, count = 0;
+    const bool expected_closed =
+        serde_json::detail::find_structurals(ScanIsa::Scalar, json.data(), json.size(), expected.data(), expected_count);
+    expected.resize(expected_count);
+    for (ScanIsa isa : {ScanIsa::SSE2, ScanIsa::AVX2}) {
+      if (isa != ScanIsa::Scalar && serde_json::detail::scan_isa() == ScanIsa::Scalar)
+        continue;
+      if (isa == ScanIsa::AVX2 && serde_json::detail::scan_isa() != ScanIsa::AVX2)
+        continue;
+      index.assign(json.size(), 0);
+      const bool closed = serde_json::detail::find_structurals(isa, json.data(), json.size(), index.data(), count);
+      index.resize(count);
+      ASSERT_EQ(closed, expected_closed) << json;
+      ASSERT_EQ(index, expected) << json;
+    }
+  }
+}
+
+TEST(Builtin, Structurals_Strings)
+{
+  // ops, escaped quotes and backslashes inside strings are not structural,
+  // blocks are 64 bytes so a long string crosses a block boundary
+  const std::string json = R"({"a\"]":[1,"x\\",true],"k":")" + std::string(70, '{') + R"("})";
+  std::vector<uint32_t> index(json.size());
+  size_t count = 0;
+  ASSERT_TRUE(serde_json::detail::find_structurals(json.data(), json.size(), index.data(), count));
+  std::string tokens;
+  for (size_t i = 0; i < count; i++)
+    tokens += json[index[i]];
+  EXPECT_EQ(tokens, R"({":[1,",t],":"})");
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include "serde/std.h"
+#include "serde/serde.h"
+#include "serde_json/serde_json.h"
+#include "serde_json/deserializer_json.h"
+
+namespace {
+struct Pos {
+  int x = 0;
+  int y = 0;
+  template<typename D>
+  void deserialize(D& de) {
+    de.deserialize_struct_begin();
+    de.deserialize_struct_field("x", x);
+    de.deserialize_struct_field("y", y);
+    de.deserialize_struct_end();
+  }
+};
+} // namespace
+
+TEST(Errors, ParseError)
+{
+  auto res = serde_json::from_str<std::vector<int>>("[1, 2,\n 3 4]");
+  ASSERT_TRUE(res.has_error());
+  EXPECT_EQ(res.error().text, "unexpected value");
+  EXPECT_EQ(res.error().line, 2u);
+  EXPECT_EQ(res.error().column, 4u);
+
+  EXPECT_EQ(serde_json::from_str<std::vector<int>>("[1, 2").error().text, "unexpected end of input");
+  EXPECT_EQ(serde_json::from_str<std::vector<int>>("[1, 2}").error().text, "unexpected '}'");
+  EXPECT_EQ(serde_json::from_str<std::vector<int>>("[1,]").error().text, "unexpected ']'");
+  EXPECT_EQ(serde_json::from_str<std::vector<int>>("[1] [2]").error().text, "unexpected content after the document");
+  EXPECT_EQ(serde_json::from_str<std::string>("\"abc").error().text, "unclosed string");
+  EXPECT_EQ(serde_json::from_str<Pos>(R"({"x" 1})").error().text, "unexpected value");
+  EXPECT_EQ(serde_json::from_str<Pos>(R"({"x": 1,})").error().text, "unexpected '}'");
+  EXPECT_EQ(serde_json::from_str<Pos>(R"({1: 1})").error().text, "unexpected value");
+  EXPECT_EQ(serde_json::from_str<int>("").error().text, "unexpected end of input");
+}
+
+TEST(Errors, InvalidScalar)
+{
+  EXPECT_EQ(serde_json::from_str<int>("1.5").error().text, "invalid scalar value");
+  EXPECT_EQ(serde_json::from_str<int>("\"1\"").error().text, "invalid scalar value");
+  EXPECT_EQ(serde_json::from_str<bool>("yes").error().text, "invalid scalar value");
+  EXPECT_EQ(serde_json::from_str<std::string>("12").error().text, "no string to extract");
+  EXPECT_EQ(serde_json::from_str<std::string>(R"("\x")").error().text, "invalid string escape");
+  EXPECT_EQ(serde_json::from_str<std::string>(R"("\ud800")").error().text, "invalid string escape");
+  using Map = std::map<int, int>;
+  EXPECT_EQ(serde_json::from_str<Map>(R"({"a": 1})").error().text, "invalid scalar key");
+}
+
+TEST(Errors, NumberOutOfRange)
+{
+  EXPECT_EQ(serde_json::from_str<int16_t>("32768").error().text, "number out of range");
+  EXPECT_EQ(serde_json::from_str<uint32_t>("-1").error().text, "number out of range");
+  EXPECT_EQ(serde_json::from_str<std::vector<uint8_t>>("[1, 256]").error().text, "number out of range");
+}
+
+TEST(Errors, InvalidBase64)
+{
+  struct Blob {
+    uint8_t val[6] = {};
+    void deserialize(serde::Deserializer& de) { de.deserialize_bytes(val, sizeof(val)); }
+  };
+  EXPECT_EQ(serde_json::from_str<Blob>("\"Zm9v!mFy\"").error().text, "invalid base64 value");
+  EXPECT_EQ(serde_json::from_str<Blob>("\"Zm9vYmFyYmF6\"").error().text, "invalid base64 value");
+}
+
+TEST(Errors, MissingField)
+{
+  auto res = serde_json::from_str<Pos>(R"({"x": 1, "z": 2})");
+  ASSERT_TRUE(res.has_error());
+  EXPECT_EQ(res.error().text, "key not found in map");
+  auto res_static = serde_json::from_str_static<Pos>(R"({"x": 1, "z": 2})");
+  ASSERT_TRUE(res_static.has_error());
+  EXPECT_EQ(res_static.error().text, res.error().text);
+}
+
+TEST(Errors, WrongShape)
+{
+  EXPECT_TRUE(serde_json::from_str<std::vector<int>>(R"({"a": 1})").has_error());
+  using Map = std::map<std::string, int>;
+  EXPECT_TRUE(serde_json::from_str<Map>("[1]").has_error());
+  EXPECT_TRUE(serde_json::from_str<Pos>("[1, 2]").has_error());
+  EXPECT_TRUE(serde_json::from_str<std::vector<int>>("[[1]]").has_error());
+}
+
+TEST(Errors, ArrayLengthMismatch)
+{
+  using Type = std::array<int, 3>;
+  EXPECT_EQ(serde_json::from_str<Type>("[1, 2]").error().text, "sequence length mismatch");
+  EXPECT_EQ(serde_json::from_str<Type>("[1, 2, 3, 4]").error().text, "sequence length mismatch");
+  EXPECT_EQ(serde_json::from_str<Type>("[1, 2, 3]").value(), (Type{1, 2, 3}));
+}
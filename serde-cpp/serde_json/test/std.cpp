@@ -0,0 +1,480 @@
+#include <gtest/gtest.h>
+#include <cmath>
+
+#include "serde/std.h"
+#include "serde/serde.h"
+#include "serde_json/serde_json.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// std::string
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, String_Value)
+{
+  using Type = std::string;
+  const Type val = "Hello World";
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), "\"Hello World\"");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, String_Empty)
+{
+  using Type = std::string;
+  const Type val = {};
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), "\"\"");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, String_Escapes)
+{
+  using Type = std::string;
+  const char raw[] = "quote\" backslash\\ newline\n tab\t nul\0 bell\x07 utf8 \xC3\xA9";
+  const Type val(raw, sizeof(raw) - 1);
+  auto str = serde_json::to_string(val).value();
+  EXPECT_EQ(str, "\"quote\\\" backslash\\\\ newline\\n tab\\t nul\\u0000 bell\\u0007 utf8 \xC3\xA9\"");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, String_Unicode)
+{
+  using Type = std::string;
+  auto de_val = serde_json::from_str<Type>(R"("é€😀\/")").value();
+  EXPECT_EQ(de_val, "\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80/");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::string_view
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, StringView_Value)
+{
+  using Type = std::string_view;
+  const Type val = "Hello World";
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), "\"Hello World\"");
+  auto de_doc = serde_json::from_str_borrowed<Type>(std::move(str)).value();
+  EXPECT_EQ(*de_doc, val);
+}
+
+TEST(Std, StringView_Borrowed)
+{
+  using Type = std::map<std::string_view, std::vector<std::string_view>>;
+  std::string json = R"({"first": ["a", "b\nb"], "second": ["ccc"]})";
+  auto de_doc = serde_json::from_str_borrowed<Type>(std::string(json)).value();
+  EXPECT_EQ(*de_doc, (Type{{"first", {"a", "b\nb"}}, {"second", {"ccc"}}}));
+  // the views stay valid after moving the document around
+  auto moved_doc = std::move(de_doc);
+  EXPECT_EQ(moved_doc->at("first").at(1), "b\nb");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::unique_ptr
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, UniquePtr_Value)
+{
+  using Type = std::unique_ptr<std::string>;
+  const Type val = std::make_unique<std::string>("Potatoes");
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), "\"Potatoes\"");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(*de_val, *val);
+}
+
+TEST(Std, UniquePtr_Empty)
+{
+  using Type = std::unique_ptr<std::string>;
+  const Type val = {};
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), "null");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::shared_ptr
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, SharedPtr_Value)
+{
+  using Type = std::shared_ptr<std::string>;
+  const Type val = std::make_shared<std::string>("Bananas");
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), "\"Bananas\"");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(*de_val, *val);
+}
+
+TEST(Std, SharedPtr_Empty)
+{
+  using Type = std::shared_ptr<std::string>;
+  const Type val = {};
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), "null");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::optional
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, Optional_Value)
+{
+  using Type = std::optional<int>;
+  const Type val = 10;
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), "10");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ((int)*val, (int)*de_val);
+}
+
+TEST(Std, Optional_Null)
+{
+  using Type = std::optional<int>;
+  const Type val = std::nullopt;
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), "null");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_FALSE(de_val.has_value());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::array
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, Array_Value)
+{
+  using Type = std::array<size_t, 6>;
+  const Type val = {56, 333, 1, 3, 49, 100};
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), "[56,333,1,3,49,100]");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Array_Empty)
+{
+  using Type = std::array<size_t, 0>;
+  const Type val = {};
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), "[]");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::vector
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, Vector_Value)
+{
+  using Type = std::vector<size_t>;
+  const Type val = {56, 333, 1, 3, 49, 100};
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), "[56,333,1,3,49,100]");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Vector_Empty)
+{
+  using Type = std::vector<size_t>;
+  const Type val = {};
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), "[]");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Vector_Double)
+{
+  using Type = std::vector<double>;
+  const Type val = {1.5, -2.25, 0.125, 0, 1e100};
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), "[1.5,-2.25,0.125,0,1e+100]");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Vector_NonFinite)
+{
+  using Type = std::vector<double>;
+  const Type val = {HUGE_VAL, std::nan("")};
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), "[null,null]");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_TRUE(std::isnan(de_val.at(0)));
+}
+
+TEST(Std, Vector_Nested)
+{
+  using Type = std::vector<std::vector<int>>;
+  const Type val = {{1, 2}, {3}, {}};
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), "[[1,2],[3],[]]");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Vector_Whitespace)
+{
+  using Type = std::vector<std::vector<int>>;
+  auto de_val = serde_json::from_str<Type>(" [ [ 1 ,\n2 ] ,\t[ 3 ] , [ ] ]\r\n").value();
+  EXPECT_EQ(de_val, (Type{{1, 2}, {3}, {}}));
+}
+
+TEST(Std, Vector_NestedInMap)
+{
+  using Type = std::map<std::string, std::vector<std::array<uint8_t, 2>>>;
+  const Type val = {{"a", {{1, 2}, {3, 4}}}, {"b", {}}};
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), R"({"a":[[1,2],[3,4]],"b":[]})");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::variant
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, Variant_Index0) {
+  using Type = std::variant<char, int, std::string>;
+  const Type val = 'c';
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), R"({"0":"c"})");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Variant_Index1) {
+  using Type = std::variant<char, int, std::string>;
+  const Type val = 431;
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), R"({"1":431})");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Variant_Index2) {
+  using Type = std::variant<char, int, std::string>;
+  const Type val = "Hello World";
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), R"({"2":"Hello World"})");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::tuple
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, Tuple_Value)
+{
+  using Type = std::tuple<char, int, std::string>;
+  const Type val = {'z', 3467, "MyTuple"};
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), R"(["z",3467,"MyTuple"])");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::pair
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, Pair_Value)
+{
+  using Type = std::pair<int, std::string>;
+  const Type val = {69, "sixty-nine"};
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), R"({"first":69,"second":"sixty-nine"})");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Pair_FieldsOutOfOrder)
+{
+  using Type = std::pair<int, std::string>;
+  auto de_val = serde_json::from_str<Type>(R"({"second": "two", "extra": [1, {"a": 2}], "first": 2})").value();
+  EXPECT_EQ(de_val, (Type{2, "two"}));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::initializer_list
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, InitializerList_Value)
+{
+  using Type = std::initializer_list<std::string>;
+  const Type val = {"apple", "banana", "orange", "avocado", "blueberry"};
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), R"(["apple","banana","orange","avocado","blueberry"])");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::list
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, List_Value)
+{
+  using Type = std::list<int>;
+  const Type val = {7, 9, 4, -1};
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), "[7,9,4,-1]");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, List_Empty)
+{
+  using Type = std::list<int>;
+  const Type val = {};
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), "[]");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::forward_list
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, ForwardList_Value)
+{
+  using Type = std::forward_list<int>;
+  const Type val = {7, 9, 4, -1};
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), "[7,9,4,-1]");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::set
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, Set_Value)
+{
+  using Type = std::set<char>;
+  const Type val = {'w', 'o', 'r', 'l', 'd'};
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), R"(["d","l","o","r","w"])");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, UnorderedSet_Value)
+{
+  using Type = std::unordered_set<char>;
+  const Type val = {'w', 'o', 'r', 'l', 'd'};
+  auto str = serde_json::to_string(val).value();
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, MultiSet_Value)
+{
+  using Type = std::multiset<char>;
+  const Type val = {'b', 'e', 'e', 'f'};
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), R"(["b","e","e","f"])");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::map
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, Map_Value)
+{
+  using Type = std::map<std::string, long int>;
+  const Type val = {{"foo", 10}, {"bar", 22}, {"egg", 67}};
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), R"({"bar":22,"egg":67,"foo":10})");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Map_Empty)
+{
+  using Type = std::map<std::string, long int>;
+  const Type val = {};
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), "{}");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, UnorderedMap_Value)
+{
+  using Type = std::unordered_map<std::string, long int>;
+  const Type val = {{"foo", 10}, {"bar", 22}, {"egg", 67}};
+  auto str = serde_json::to_string(val).value();
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, MultiMap_Value)
+{
+  using Type = std::multimap<short int, std::string>;
+  const Type val = {{1, "one"}, {1, "uno"}, {2, "two"}};
+  auto str = serde_json::to_string(val).value();
+  // keys are strings in JSON, numbers are quoted
+  EXPECT_STREQ(str.c_str(), R"({"1":"one","1":"uno","2":"two"})");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, UnorderedMultiMap_Value)
+{
+  using Type = std::unordered_multimap<short int, std::string>;
+  const Type val = {{1, "one"}, {1, "uno"}, {2, "two"}};
+  auto str = serde_json::to_string(val).value();
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::deque
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, Deque_Value)
+{
+  using Type = std::deque<std::string>;
+  const Type val = {"clubs", "queen", "king"};
+  auto str = serde_json::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), R"(["clubs","queen","king"])");
+  auto de_val = serde_json::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::queue
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, Queue_Value)
+{
+  using Type = std::queue<std::string>;
+  Type val; val.push("clubs"); val.push("queen"); val.push("king");
+  auto de_val = serde_json::from_str<Type>(R"(["clubs", "queen", "king"])").value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::stack
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, Stack_Value)
+{
+  using Type = std::stack<std::string>;
+  Type val; val.push("clubs"); val.push("queen"); val.push("king");
+  auto de_val = serde_json::from_str<Type>(R"(["clubs", "queen", "king"])").value();
+  EXPECT_EQ(de_val, val);
+}
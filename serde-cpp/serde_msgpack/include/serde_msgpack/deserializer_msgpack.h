@@ -0,0 +1,411 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <serde/de.h>
+#include <serde/error.h>
+#include <serde/result.hpp>
+
+#include "detail/format.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Serde MessagePack
+////////////////////////////////////////////////////////////////////////////////
+namespace serde_msgpack {
+
+/// MessagePack Deserializer
+///
+/// Reads MessagePack straight from the input bytes, there is no intermediate
+/// tree: every Deserializer call consumes the next value. Any int or uint format
+/// is accepted for integers as long as the value fits, and ints are accepted
+/// for floats, so messages from other languages' encoders read back as well.
+///
+/// Structs are read from maps by field name. Fields are looked up at the entry
+/// following the previous field first, so maps in field order are read in a
+/// single pass, otherwise the map is searched. Entries of unknown names are skipped.
+///
+/// The input is borrowed, not copied, it must outlive the deserializer and
+/// any str or bin borrowed from it (deserialize_str, deserialize_bytes_borrowed).
+///
+/// Errors have no line, their column is the byte offset in the input (1-based)
+/// where the offending value starts.
+class MsgpackDeserializer final : public serde::StaticDeserializer<MsgpackDeserializer> {
+public:
+  MsgpackDeserializer() = default;
+
+  MsgpackDeserializer(const void* data, size_t len) { reset(data, len); }
+
+  /// Deserialize another input, dropping the error
+  void reset(const void* data, size_t len) {
+    first = static_cast<const uint8_t*>(data);
+    pos = first;
+    last = first + len;
+    frames.clear();
+    clear_error();
+  }
+
+  /// Bytes not consumed yet
+  size_t remaining() const { return static_cast<size_t>(last - pos); }
+
+  /// Set an error if the deserialized value didn't consume the whole input
+  void expect_end() {
+    if (!has_error() && pos != last)
+      fail_at(pos, "trailing bytes after value");
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Deserializer interface
+  //////////////////////////////////////////////////////////////////////////////
+
+  // Scalars ///////////////////////////////////////////////////////////////////
+  void deserialize_bool(bool& val) final {
+    detail::Header h;
+    if (!read_header(h, detail::Type::Bool, "expected a bool")) return;
+    val = h.value;
+  }
+  void deserialize_i8(int8_t& val) final { read_int(val); }
+  void deserialize_u8(uint8_t& val) final { read_int(val); }
+  void deserialize_i16(int16_t& val) final { read_int(val); }
+  void deserialize_u16(uint16_t& val) final { read_int(val); }
+  void deserialize_i32(int32_t& val) final { read_int(val); }
+  void deserialize_u32(uint32_t& val) final { read_int(val); }
+  void deserialize_i64(int64_t& val) final { read_int(val); }
+  void deserialize_u64(uint64_t& val) final { read_int(val); }
+  void deserialize_float(float& val) final { read_float(val); }
+  void deserialize_double(double& val) final { read_float(val); }
+  void deserialize_char(char& val) final { read_int(val); }
+  void deserialize_uchar(unsigned char& val) final { read_int(val); }
+
+  void deserialize_cstr(char* val, size_t len) final {
+    const char* str = nullptr;
+    size_t n = 0;
+    deserialize_str(str, n);
+    if (has_error()) return;
+    const size_t copy = len ? std::min(n, len - 1) : 0;
+    if (copy)
+      std::memcpy(val, str, copy);
+    if (len)
+      val[copy] = '\0';
+  }
+
+  void deserialize_str(const char*& val, size_t& len) final {
+    detail::Header h;
+    if (!read_header(h, detail::Type::Str, "expected a string")) return;
+    val = reinterpret_cast<const char*>(pos);
+    len = static_cast<size_t>(h.value);
+    pos += len;
+  }
+
+  void deserialize_bytes(void* val, size_t len) final {
+    const uint8_t* start = pos;
+    const void* bytes = nullptr;
+    size_t n = 0;
+    deserialize_bytes_borrowed(bytes, n);
+    if (has_error()) return;
+    if (n > len)
+      return fail_at(start, "bytes exceed the destination");
+    if (n)
+      std::memcpy(val, bytes, n);
+  }
+
+  // bin, or str as written by encoders predating bin (raw)
+  void deserialize_bytes_borrowed(const void*& val, size_t& len) final {
+    const uint8_t* start = pos;
+    detail::Header h;
+    if (!read_header(h)) return;
+    if (h.type != detail::Type::Bin && h.type != detail::Type::Str)
+      return fail_at(start, "expected binary");
+    val = pos;
+    len = static_cast<size_t>(h.value);
+    pos += len;
+  }
+
+  // Length of the str that follows, it is not consumed
+  void deserialize_length(size_t& len) final { peek_length(len, detail::Type::Str, "expected a string"); }
+
+  // Optional //////////////////////////////////////////////////////////////////
+  // nil is none, anything else is the value. Not consumed, the value or none follows.
+  void deserialize_is_some(bool& val) final {
+    if (has_error()) return;
+    if (pos == last)
+      return fail_eof();
+    val = *pos != detail::code::nil;
+  }
+  void deserialize_none() final {
+    detail::Header h;
+    read_header(h, detail::Type::Nil, "expected nil");
+  }
+
+  // Sequence //////////////////////////////////////////////////////////////////
+  void deserialize_seq_begin() final {
+    detail::Header h;
+    read_header(h, detail::Type::Array, "expected an array");
+  }
+  // Number of elements of the array that follows, it is not consumed
+  void deserialize_seq_size(size_t& size) final { peek_length(size, detail::Type::Array, "expected an array"); }
+  void deserialize_seq_end() final {}
+
+  // Sequence of scalars ///////////////////////////////////////////////////////
+  void deserialize_seq_bool(bool* vals, size_t len) final { read_seq(vals, len); }
+  void deserialize_seq_i8(int8_t* vals, size_t len) final { read_seq(vals, len); }
+  void deserialize_seq_u8(uint8_t* vals, size_t len) final { read_seq(vals, len); }
+  void deserialize_seq_i16(int16_t* vals, size_t len) final { read_seq(vals, len); }
+  void deserialize_seq_u16(uint16_t* vals, size_t len) final { read_seq(vals, len); }
+  void deserialize_seq_i32(int32_t* vals, size_t len) final { read_seq(vals, len); }
+  void deserialize_seq_u32(uint32_t* vals, size_t len) final { read_seq(vals, len); }
+  void deserialize_seq_i64(int64_t* vals, size_t len) final { read_seq(vals, len); }
+  void deserialize_seq_u64(uint64_t* vals, size_t len) final { read_seq(vals, len); }
+  void deserialize_seq_float(float* vals, size_t len) final { read_seq(vals, len); }
+  void deserialize_seq_double(double* vals, size_t len) final { read_seq(vals, len); }
+  void deserialize_seq_char(char* vals, size_t len) final { read_seq(vals, len); }
+  void deserialize_seq_uchar(unsigned char* vals, size_t len) final { read_seq(vals, len); }
+
+  // Map ///////////////////////////////////////////////////////////////////////
+  void deserialize_map_begin() final { map_begin(); }
+  // Number of entries of the map that follows, it is not consumed
+  void deserialize_map_size(size_t& size) final { peek_length(size, detail::Type::Map, "expected a map"); }
+  void deserialize_map_end() final { map_end(); }
+  void deserialize_map_key_begin() final {
+    if (!frames.empty())
+      frames.back().current = frames.back().next;
+  }
+  void deserialize_map_key_end() final {}
+  // Position the input at the value of the entry with the given str key
+  void deserialize_map_key_find(const char* key) final {
+    if (has_error()) return;
+    if (frames.empty())
+      return fail_at(pos, "no map to find key");
+    Frame& top = frames.back();
+    const size_t key_len = std::strlen(key);
+    // keys are usually in the same order as they are looked up (struct field order),
+    // so try the entry at the cursor before searching the whole map
+    if (top.next < top.count) {
+      if (const uint8_t* value = match_key(top.cursor, key, key_len)) {
+        top.current = top.next;
+        pos = value;
+        return;
+      }
+    }
+    const uint8_t* entry = top.entries;
+    for (size_t i = 0; i < top.count; i++) {
+      const uint8_t* value = match_key(entry, key, key_len);
+      if (value) {
+        top.current = i;
+        pos = value;
+        return;
+      }
+      if (!(entry = detail::skip_value(entry, last)) || !(entry = detail::skip_value(entry, last)))
+        return fail_at(top.entries, "invalid map");
+    }
+    fail_at(top.start, std::string("key not found in map: ").append(key));
+  }
+  void deserialize_map_value_begin() final {}
+  void deserialize_map_value_end() final { entry_end(); }
+
+  // Struct ////////////////////////////////////////////////////////////////////
+  void deserialize_struct_begin() final { map_begin(); }
+  void deserialize_struct_end() final { map_end(); }
+  void deserialize_struct_field_begin(const char* name) final { deserialize_map_key_find(name); }
+  void deserialize_struct_field_end() final { entry_end(); }
+
+private:
+  // Open maps and structs
+  struct Frame {
+    const uint8_t* start;   // map header, for errors
+    const uint8_t* entries; // first entry
+    const uint8_t* cursor;  // entry after the last one read
+    size_t count;           // number of entries
+    size_t next;            // index of the entry at the cursor
+    size_t current;         // index of the entry being read
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Deserialization Utils
+  //////////////////////////////////////////////////////////////////////////////
+
+  void fail_at(const uint8_t* at, std::string text) {
+    const auto column = static_cast<size_t>(at - first) + 1;
+    set_error({serde::Error::Kind::Invalid, 0, column, std::move(text)});
+  }
+
+  void fail_eof() { fail_at(pos, "unexpected end of input"); }
+
+  // Read the header of the next value and check its payload (and for arrays and
+  // maps the minimum size of their elements) is within the input, so a corrupt
+  // length fails here instead of resizing a container to it
+  bool read_header(detail::Header& h) {
+    if (has_error()) return false;
+    const uint8_t* start = pos;
+    const uint8_t* payload = detail::read_header(pos, last, h);
+    if (!payload) {
+      fail_eof();
+      return false;
+    }
+    if (h.type == detail::Type::Invalid) {
+      fail_at(start, "invalid format byte");
+      return false;
+    }
+    const auto avail = static_cast<uint64_t>(last - payload);
+    const uint64_t min_size = h.type == detail::Type::Map ? 2 * h.value : h.type == detail::Type::Array ? h.value : detail::payload_size(h);
+    if (min_size > avail) {
+      fail_at(start, h.type == detail::Type::Array || h.type == detail::Type::Map ? "length exceeds input" : "unexpected end of input");
+      return false;
+    }
+    pos = payload;
+    return true;
+  }
+
+  bool read_header(detail::Header& h, detail::Type type, const char* mismatch) {
+    const uint8_t* start = pos;
+    if (!read_header(h)) return false;
+    if (h.type != type) {
+      pos = start;
+      fail_at(start, mismatch);
+      return false;
+    }
+    return true;
+  }
+
+  void peek_length(size_t& len, detail::Type type, const char* mismatch) {
+    const uint8_t* start = pos;
+    detail::Header h;
+    if (!read_header(h, type, mismatch)) return;
+    len = static_cast<size_t>(h.value);
+    pos = start;
+  }
+
+  template<typename T>
+  static bool decode_int(const detail::Header& h, T& val) {
+    if (h.type == detail::Type::UInt) {
+      if (h.value > static_cast<std::make_unsigned_t<T>>(std::numeric_limits<T>::max()))
+        return false;
+    }
+    else if (h.type == detail::Type::NegInt) {
+      if (!std::is_signed_v<T> || static_cast<int64_t>(h.value) < static_cast<int64_t>(std::numeric_limits<T>::min()))
+        return false;
+    }
+    val = static_cast<T>(h.value);
+    return true;
+  }
+
+  template<typename T>
+  void read_int(T& val) {
+    const uint8_t* start = pos;
+    detail::Header h;
+    if (!read_header(h)) return;
+    if (h.type != detail::Type::UInt && h.type != detail::Type::NegInt)
+      return fail_at(start, "expected an integer");
+    if (!decode_int(h, val))
+      fail_at(start, "number out of range");
+  }
+
+  template<typename T>
+  void read_float(T& val) {
+    const uint8_t* start = pos;
+    detail::Header h;
+    if (!read_header(h)) return;
+    switch (h.type) {
+      case detail::Type::Float32: val = static_cast<T>(detail::read_float<float>(pos)); break;
+      case detail::Type::Float64: val = static_cast<T>(detail::read_float<double>(pos)); break;
+      case detail::Type::UInt: val = static_cast<T>(h.value); break;
+      case detail::Type::NegInt: val = static_cast<T>(static_cast<int64_t>(h.value)); break;
+      default: return fail_at(start, "expected a float");
+    }
+    pos += detail::payload_size(h);
+  }
+
+  template<typename T>
+  void read_seq(T* vals, size_t len) {
+    const uint8_t* start = pos;
+    detail::Header h;
+    if (!read_header(h, detail::Type::Array, "expected an array")) return;
+    if (h.value != len)
+      return fail_at(start, "sequence length mismatch");
+    for (size_t i = 0; i < len && !has_error(); i++) {
+      if constexpr (std::is_same_v<T, bool>)
+        deserialize_bool(vals[i]);
+      else if constexpr (std::is_floating_point_v<T>)
+        read_float(vals[i]);
+      // inline positive fixint fast path, the common case for small values
+      else if (pos != last && *pos < 0x80 && static_cast<uint64_t>(*pos) <= static_cast<std::make_unsigned_t<T>>(std::numeric_limits<T>::max()))
+        vals[i] = static_cast<T>(*pos++);
+      else
+        read_int(vals[i]);
+    }
+  }
+
+  void map_begin() {
+    const uint8_t* start = pos;
+    detail::Header h;
+    if (!read_header(h, detail::Type::Map, "expected a map")) return;
+    const auto count = static_cast<size_t>(h.value);
+    frames.push_back(Frame{start, pos, pos, count, 0, 0});
+  }
+
+  void entry_end() {
+    if (has_error() || frames.empty()) return;
+    Frame& top = frames.back();
+    top.next = top.current + 1;
+    top.cursor = pos;
+  }
+
+  // Skip the entries which were not read, to the end of the map
+  void map_end() {
+    if (has_error() || frames.empty()) return;
+    const Frame top = frames.back();
+    frames.pop_back();
+    const uint8_t* p = top.cursor;
+    for (size_t i = top.next; i < top.count && p; i++) {
+      p = detail::skip_value(p, last);
+      p = p ? detail::skip_value(p, last) : nullptr;
+    }
+    if (!p)
+      return fail_at(top.cursor, "invalid map");
+    pos = p;
+  }
+
+  // The value after the entry at p if its key is the str key, nullptr otherwise
+  const uint8_t* match_key(const uint8_t* p, const char* key, size_t key_len) const {
+    detail::Header h;
+    const uint8_t* str = detail::read_header(p, last, h);
+    if (!str || h.type != detail::Type::Str || h.value != key_len || key_len > static_cast<size_t>(last - str))
+      return nullptr;
+    if (key_len && std::memcmp(str, key, key_len) != 0)
+      return nullptr;
+    return str + key_len;
+  }
+
+  const uint8_t* first = nullptr;
+  const uint8_t* pos = nullptr;
+  const uint8_t* last = nullptr;
+  std::vector<Frame> frames;
+};
+
+/// MessagePack Deserializer function from bytes to T, statically dispatched.
+/// Same as from_bytes(), with the deserializer calls resolved at compile time.
+template<typename T>
+auto from_bytes_static(const void* data, size_t len) -> cpp::result<T, serde::Error>
+{
+  MsgpackDeserializer de(data, len);
+  T obj{};
+  de.deserialize(obj);
+  de.expect_end();
+  if (de.has_error())
+    return cpp::fail(de.error());
+  return std::move(obj);
+}
+
+/// MessagePack Deserializer function from a byte vector to T, statically dispatched
+template<typename T>
+auto from_bytes_static(const std::vector<uint8_t>& bytes) -> cpp::result<T, serde::Error>
+{
+  return from_bytes_static<T>(bytes.data(), bytes.size());
+}
+
+} // namespace serde_msgpack
@@ -0,0 +1,257 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+///////////////////////////////////////////////////////////////////////////////
+// Serde MessagePack detail
+///////////////////////////////////////////////////////////////////////////////
+namespace serde_msgpack::detail {
+
+// MessagePack format bytes, see https://github.com/msgpack/msgpack/blob/master/spec.md
+namespace code {
+inline constexpr uint8_t positive_fixint = 0x00; // 0xxxxxxx
+inline constexpr uint8_t fixmap = 0x80;          // 1000xxxx
+inline constexpr uint8_t fixarray = 0x90;        // 1001xxxx
+inline constexpr uint8_t fixstr = 0xa0;          // 101xxxxx
+inline constexpr uint8_t nil = 0xc0;
+inline constexpr uint8_t false_ = 0xc2;
+inline constexpr uint8_t true_ = 0xc3;
+inline constexpr uint8_t bin8 = 0xc4;
+inline constexpr uint8_t bin16 = 0xc5;
+inline constexpr uint8_t bin32 = 0xc6;
+inline constexpr uint8_t ext8 = 0xc7;
+inline constexpr uint8_t ext16 = 0xc8;
+inline constexpr uint8_t ext32 = 0xc9;
+inline constexpr uint8_t float32 = 0xca;
+inline constexpr uint8_t float64 = 0xcb;
+inline constexpr uint8_t uint8 = 0xcc;
+inline constexpr uint8_t uint16 = 0xcd;
+inline constexpr uint8_t uint32 = 0xce;
+inline constexpr uint8_t uint64 = 0xcf;
+inline constexpr uint8_t int8 = 0xd0;
+inline constexpr uint8_t int16 = 0xd1;
+inline constexpr uint8_t int32 = 0xd2;
+inline constexpr uint8_t int64 = 0xd3;
+inline constexpr uint8_t fixext1 = 0xd4;
+inline constexpr uint8_t fixext16 = 0xd8;
+inline constexpr uint8_t str8 = 0xd9;
+inline constexpr uint8_t str16 = 0xda;
+inline constexpr uint8_t str32 = 0xdb;
+inline constexpr uint8_t array16 = 0xdc;
+inline constexpr uint8_t array32 = 0xdd;
+inline constexpr uint8_t map16 = 0xde;
+inline constexpr uint8_t map32 = 0xdf;
+inline constexpr uint8_t negative_fixint = 0xe0; // 111xxxxx
+} // namespace code
+
+/// Maximum number of bytes of an encoded integer or float (format byte + 8 bytes)
+inline constexpr size_t scalar_max_size = 9;
+
+/// Write the low n bytes of v, big-endian. Returns the end of the written bytes.
+inline uint8_t* write_be(uint8_t* out, uint64_t v, size_t n) {
+  for (size_t i = 0; i < n; i++)
+    out[i] = static_cast<uint8_t>(v >> (8 * (n - 1 - i)));
+  return out + n;
+}
+
+inline uint64_t read_be(const uint8_t* in, size_t n) {
+  uint64_t v = 0;
+  for (size_t i = 0; i < n; i++)
+    v = v << 8 | in[i];
+  return v;
+}
+
+/// Write v in the smallest of positive fixint, uint8, uint16, uint32 and uint64
+inline uint8_t* write_uint(uint8_t* out, uint64_t v) {
+  if (v < 0x80) {
+    *out++ = static_cast<uint8_t>(v);
+    return out;
+  }
+  if (v <= UINT8_MAX) { *out++ = code::uint8; return write_be(out, v, 1); }
+  if (v <= UINT16_MAX) { *out++ = code::uint16; return write_be(out, v, 2); }
+  if (v <= UINT32_MAX) { *out++ = code::uint32; return write_be(out, v, 4); }
+  *out++ = code::uint64;
+  return write_be(out, v, 8);
+}
+
+/// Write v in the smallest integer format, non negative values as unsigned ones
+inline uint8_t* write_int(uint8_t* out, int64_t v) {
+  if (v >= 0)
+    return write_uint(out, static_cast<uint64_t>(v));
+  if (v >= -32) {
+    *out++ = static_cast<uint8_t>(v);
+    return out;
+  }
+  const auto bits = static_cast<uint64_t>(v);
+  if (v >= INT8_MIN) { *out++ = code::int8; return write_be(out, bits, 1); }
+  if (v >= INT16_MIN) { *out++ = code::int16; return write_be(out, bits, 2); }
+  if (v >= INT32_MIN) { *out++ = code::int32; return write_be(out, bits, 4); }
+  *out++ = code::int64;
+  return write_be(out, bits, 8);
+}
+
+/// Write v as float32 or float64 (after its type, floats keep their width)
+template<typename T>
+inline uint8_t* write_float(uint8_t* out, T v) {
+  using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+  Bits bits;
+  std::memcpy(&bits, &v, sizeof(bits));
+  *out++ = sizeof(T) == 4 ? code::float32 : code::float64;
+  return write_be(out, bits, sizeof(bits));
+}
+
+/// Write the header of a str, bin, array or map of len elements (bytes for str and bin),
+/// in the smallest of its formats. fix is the fix format code, 0 if there is none (bin).
+/// Returns the end of the written bytes, the header takes at most 5 bytes.
+inline uint8_t* write_header(uint8_t* out, uint8_t fix, size_t fix_max, uint8_t code8, uint8_t code16, uint8_t code32, size_t len) {
+  if (fix && len <= fix_max) {
+    *out++ = static_cast<uint8_t>(fix | len);
+    return out;
+  }
+  if (code8 && len <= UINT8_MAX) { *out++ = code8; return write_be(out, len, 1); }
+  if (len <= UINT16_MAX) { *out++ = code16; return write_be(out, len, 2); }
+  *out++ = code32;
+  return write_be(out, len, 4);
+}
+
+inline uint8_t* write_str_header(uint8_t* out, size_t len) {
+  return write_header(out, code::fixstr, 31, code::str8, code::str16, code::str32, len);
+}
+inline uint8_t* write_bin_header(uint8_t* out, size_t len) {
+  return write_header(out, 0, 0, code::bin8, code::bin16, code::bin32, len);
+}
+inline uint8_t* write_array_header(uint8_t* out, size_t len) {
+  return write_header(out, code::fixarray, 15, 0, code::array16, code::array32, len);
+}
+inline uint8_t* write_map_header(uint8_t* out, size_t len) {
+  return write_header(out, code::fixmap, 15, 0, code::map16, code::map32, len);
+}
+
+/// Size of the array or map header write_array_header() / write_map_header() writes for len
+inline size_t container_header_size(size_t len) {
+  return len <= 15 ? 1 : len <= UINT16_MAX ? 3 : 5;
+}
+
+/// Family of a MessagePack value
+enum class Type : uint8_t { Nil, Bool, UInt, NegInt, Float32, Float64, Str, Bin, Array, Map, Ext, Invalid };
+
+/// Decoded format byte (and length or value bytes) of the value at the start of the input
+struct Header {
+  Type type = Type::Invalid;
+  uint64_t value = 0; // bool, uint and the bits of negative ints, or the number of bytes,
+                      // elements or entries of str, bin, ext, array and map
+};
+
+/// Read the header of the value at [first, last) into h.
+/// Returns the start of the value payload (the bytes of a str, the first element of an array...),
+/// or nullptr if the header is truncated. The payload itself is not checked against last.
+inline const uint8_t* read_header(const uint8_t* first, const uint8_t* last, Header& h) {
+  if (first == last)
+    return nullptr;
+  const uint8_t c = *first++;
+  const auto avail = static_cast<size_t>(last - first);
+  auto take = [&](Type type, size_t n) -> const uint8_t* {
+    if (avail < n)
+      return nullptr;
+    h.type = type;
+    h.value = read_be(first, n);
+    return first + n;
+  };
+  if (c < 0x80) { h = {Type::UInt, c}; return first; }
+  if (c >= code::negative_fixint) { h = {Type::NegInt, static_cast<uint64_t>(static_cast<int64_t>(static_cast<int8_t>(c)))}; return first; }
+  if (c < code::fixarray) { h = {Type::Map, uint64_t(c & 0x0F)}; return first; }
+  if (c < code::fixstr) { h = {Type::Array, uint64_t(c & 0x0F)}; return first; }
+  if (c < code::nil) { h = {Type::Str, uint64_t(c & 0x1F)}; return first; }
+  switch (c) {
+    case code::nil: h = {Type::Nil, 0}; return first;
+    case code::false_: h = {Type::Bool, 0}; return first;
+    case code::true_: h = {Type::Bool, 1}; return first;
+    case code::bin8: return take(Type::Bin, 1);
+    case code::bin16: return take(Type::Bin, 2);
+    case code::bin32: return take(Type::Bin, 4);
+    // ext lengths count the type byte, which is part of the payload here
+    case code::ext8: { auto p = take(Type::Ext, 1); h.value += 1; return p; }
+    case code::ext16: { auto p = take(Type::Ext, 2); h.value += 1; return p; }
+    case code::ext32: { auto p = take(Type::Ext, 4); h.value += 1; return p; }
+    case code::float32: h = {Type::Float32, 4}; return first;
+    case code::float64: h = {Type::Float64, 8}; return first;
+    case code::uint8: return take(Type::UInt, 1);
+    case code::uint16: return take(Type::UInt, 2);
+    case code::uint32: return take(Type::UInt, 4);
+    case code::uint64: return take(Type::UInt, 8);
+    case code::int8: case code::int16: case code::int32: case code::int64: {
+      const size_t n = size_t(1) << (c - code::int8);
+      if (avail < n)
+        return nullptr;
+      // sign extend
+      const uint64_t bits = read_be(first, n);
+      const unsigned shift = unsigned(64 - 8 * n);
+      const auto v = static_cast<int64_t>(bits << shift) >> shift;
+      h = {v < 0 ? Type::NegInt : Type::UInt, static_cast<uint64_t>(v)};
+      return first + n;
+    }
+    case code::str8: return take(Type::Str, 1);
+    case code::str16: return take(Type::Str, 2);
+    case code::str32: return take(Type::Str, 4);
+    case code::array16: return take(Type::Array, 2);
+    case code::array32: return take(Type::Array, 4);
+    case code::map16: return take(Type::Map, 2);
+    case code::map32: return take(Type::Map, 4);
+    default:
+      if (c >= code::fixext1 && c <= code::fixext16) {
+        h = {Type::Ext, (uint64_t(1) << (c - code::fixext1)) + 1};
+        return first;
+      }
+      h = {Type::Invalid, 0}; // 0xc1 is never used
+      return first;
+  }
+}
+
+/// Bytes of payload after the header, 0 for arrays and maps (their elements follow)
+inline uint64_t payload_size(const Header& h) {
+  switch (h.type) {
+    case Type::Float32: case Type::Float64: case Type::Str: case Type::Bin: case Type::Ext:
+      return h.value;
+    default:
+      return 0;
+  }
+}
+
+/// Skip the value at [first, last), arrays and maps with all their elements.
+/// Returns the end of the value, or nullptr if it is truncated or invalid.
+inline const uint8_t* skip_value(const uint8_t* first, const uint8_t* last) {
+  uint64_t pending = 1;
+  while (pending) {
+    Header h;
+    first = read_header(first, last, h);
+    if (!first || h.type == Type::Invalid)
+      return nullptr;
+    const uint64_t payload = payload_size(h);
+    if (payload > static_cast<uint64_t>(last - first))
+      return nullptr;
+    first += payload;
+    pending--;
+    if (h.type == Type::Array)
+      pending += h.value;
+    else if (h.type == Type::Map)
+      pending += 2 * h.value;
+    // every element takes at least a byte
+    if (pending > static_cast<uint64_t>(last - first))
+      return nullptr;
+  }
+  return first;
+}
+
+template<typename T>
+inline T read_float(const uint8_t* in) {
+  using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+  const auto bits = static_cast<Bits>(read_be(in, sizeof(Bits)));
+  T v;
+  std::memcpy(&v, &bits, sizeof(v));
+  return v;
+}
+
+} // namespace serde_msgpack::detail
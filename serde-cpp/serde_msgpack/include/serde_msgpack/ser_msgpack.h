@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <serde/ser.h>
+#include <serde/error.h>
+#include <serde/result.hpp>
+
+#include "detail/ser_detail.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// Serde MessagePack
+///////////////////////////////////////////////////////////////////////////////
+namespace serde_msgpack {
+
+/// MessagePack Serializer function from T to bytes
+template<typename T>
+auto to_bytes(T&& obj) -> cpp::result<std::vector<uint8_t>, serde::Error>
+{
+  std::vector<uint8_t> out;
+  auto ser = detail::SerializerNew(out);
+  ser->serialize(std::forward<T>(obj));
+  return out;
+}
+
+/// MessagePack Serializer function from T to bytes, appended to out.
+/// Reusing out (cleared) across calls avoids allocating once its capacity is warmed up.
+template<typename T>
+auto to_bytes(T&& obj, std::vector<uint8_t>& out) -> cpp::result<void, serde::Error>
+{
+  auto ser = detail::SerializerNew(out);
+  ser->serialize(std::forward<T>(obj));
+  return {};
+}
+
+} // namespace serde_msgpack
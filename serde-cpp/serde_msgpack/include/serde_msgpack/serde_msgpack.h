@@ -0,0 +1,5 @@
+#pragma once
+
+// include serialization and deserialization
+#include "ser_msgpack.h"
+#include "de_msgpack.h"
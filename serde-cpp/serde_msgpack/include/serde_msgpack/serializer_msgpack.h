@@ -0,0 +1,273 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <serde/ser.h>
+#include <serde/error.h>
+#include <serde/result.hpp>
+
+#include "detail/format.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Serde MessagePack
+////////////////////////////////////////////////////////////////////////////////
+namespace serde_msgpack {
+
+/// MessagePack Serializer
+///
+/// Writes MessagePack (https://msgpack.org), always in the smallest format for
+/// each value: positive/negative fixint and the narrowest int and uint, fixstr,
+/// fixarray and fixmap when they fit.
+///
+///   bool                     true / false
+///   ints, char, uchar        int / uint, non negative values as uint
+///   float, double            float32 / float64
+///   str                      str
+///   bytes                    bin
+///   none                     nil
+///   seq                      array
+///   map                      map
+///   struct                   map of field name (str) to field value
+///
+/// Structs are maps keyed by field name, as the dictionaries and structs of the
+/// MessagePack libraries of other languages are, so they are read back by name
+/// regardless of the field order.
+///
+/// Sequences, maps and structs of unknown size (serialize_seq_begin) get a one
+/// byte fixarray/fixmap header, filled in when they end. The rare ones with more
+/// than 15 elements are moved forward to make room for the wider header.
+///
+/// The output vector is owned by the caller and is appended to, so it can be
+/// reused (cleared) across messages to avoid allocating once warmed up.
+class MsgpackSerializer final : public serde::StaticSerializer<MsgpackSerializer> {
+public:
+  explicit MsgpackSerializer(std::vector<uint8_t>& out) : out(&out) {}
+
+  /// Serialize a new value, keeping the allocated capacity.
+  /// Anything already written to the output vector is left there.
+  void reset() { frames.clear(); }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Serializer interface
+  //////////////////////////////////////////////////////////////////////////////
+
+  // Scalars ///////////////////////////////////////////////////////////////////
+  void serialize_bool(bool v) final { write_byte(v ? detail::code::true_ : detail::code::false_); }
+  void serialize_i8(int8_t v) final { write_int(v); }
+  void serialize_u8(uint8_t v) final { write_uint(v); }
+  void serialize_i16(int16_t v) final { write_int(v); }
+  void serialize_u16(uint16_t v) final { write_uint(v); }
+  void serialize_i32(int32_t v) final { write_int(v); }
+  void serialize_u32(uint32_t v) final { write_uint(v); }
+  void serialize_i64(int64_t v) final { write_int(v); }
+  void serialize_u64(uint64_t v) final { write_uint(v); }
+  void serialize_float(float v) final { write_float(v); }
+  void serialize_double(double v) final { write_float(v); }
+  void serialize_char(char v) final { write_int(v); }
+  void serialize_uchar(unsigned char v) final { write_uint(v); }
+  void serialize_str(const char* v, size_t len) final {
+    value_begin();
+    write_block(detail::write_str_header, v, len);
+  }
+  void serialize_bytes(const void* val, size_t len) final {
+    value_begin();
+    write_block(detail::write_bin_header, val, len);
+  }
+
+  // Optional //////////////////////////////////////////////////////////////////
+  void serialize_none() final { write_byte(detail::code::nil); }
+
+  // Sequence //////////////////////////////////////////////////////////////////
+  void serialize_seq_begin() final { container_begin(Kind::Seq); }
+  void serialize_seq_begin_sized(size_t len) final { container_begin_sized(Kind::Seq, len); }
+  void serialize_seq_end() final { container_end(); }
+
+  // Sequence of scalars ///////////////////////////////////////////////////////
+  void serialize_seq_bool(const bool* vals, size_t len) final {
+    uint8_t* p = seq_begin(len, 1);
+    for (size_t i = 0; i < len; i++)
+      *p++ = vals[i] ? detail::code::true_ : detail::code::false_;
+  }
+  void serialize_seq_i8(const int8_t* vals, size_t len) final { serialize_seq_ints(vals, len); }
+  void serialize_seq_u8(const uint8_t* vals, size_t len) final { serialize_seq_ints(vals, len); }
+  void serialize_seq_i16(const int16_t* vals, size_t len) final { serialize_seq_ints(vals, len); }
+  void serialize_seq_u16(const uint16_t* vals, size_t len) final { serialize_seq_ints(vals, len); }
+  void serialize_seq_i32(const int32_t* vals, size_t len) final { serialize_seq_ints(vals, len); }
+  void serialize_seq_u32(const uint32_t* vals, size_t len) final { serialize_seq_ints(vals, len); }
+  void serialize_seq_i64(const int64_t* vals, size_t len) final { serialize_seq_ints(vals, len); }
+  void serialize_seq_u64(const uint64_t* vals, size_t len) final { serialize_seq_ints(vals, len); }
+  void serialize_seq_float(const float* vals, size_t len) final { serialize_seq_floats(vals, len); }
+  void serialize_seq_double(const double* vals, size_t len) final { serialize_seq_floats(vals, len); }
+  void serialize_seq_char(const char* vals, size_t len) final { serialize_seq_ints(vals, len); }
+  void serialize_seq_uchar(const unsigned char* vals, size_t len) final { serialize_seq_ints(vals, len); }
+
+  // Map ///////////////////////////////////////////////////////////////////////
+  void serialize_map_begin() final { container_begin(Kind::Map); }
+  void serialize_map_begin_sized(size_t len) final { container_begin_sized(Kind::Map, len); }
+  void serialize_map_end() final { container_end(); }
+
+  void serialize_map_key_begin() final {
+    if (!frames.empty())
+      frames.back().count++;
+  }
+  void serialize_map_key_end() final {}
+  void serialize_map_value_begin() final {}
+  void serialize_map_value_end() final {}
+
+  // Struct ////////////////////////////////////////////////////////////////////
+  void serialize_struct_begin() final { container_begin(Kind::Map); }
+  void serialize_struct_end() final { container_end(); }
+  void serialize_struct_field_begin(const char* name) final {
+    if (!frames.empty())
+      frames.back().count++;
+    write_block(detail::write_str_header, name, std::strlen(name));
+  }
+  void serialize_struct_field_end() final {}
+
+private:
+  static constexpr size_t npos = size_t(-1);
+
+  enum class Kind : uint8_t { Seq, Map };
+
+  // Open containers, only tracked while a container of unknown size is open:
+  // its elements (entries for maps) are counted to fill in its header when it ends.
+  struct Frame {
+    Kind kind;
+    size_t header_pos; // position of the one byte header in the output, npos if written up front
+    size_t count;      // elements (entries for maps) written so far
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Serialization Utils
+  //////////////////////////////////////////////////////////////////////////////
+
+  // Count a new element of the enclosing sequence of unknown size, if any.
+  // Map keys and struct fields count their entry instead, values don't count.
+  void value_begin() {
+    if (!frames.empty() && frames.back().kind == Kind::Seq)
+      frames.back().count++;
+  }
+
+  void container_begin(Kind kind) {
+    value_begin();
+    frames.push_back(Frame{kind, out->size(), 0});
+    out->push_back(0);
+  }
+
+  void container_begin_sized(Kind kind, size_t len) {
+    value_begin();
+    uint8_t buf[5];
+    uint8_t* end = kind == Kind::Seq ? detail::write_array_header(buf, len) : detail::write_map_header(buf, len);
+    out->insert(out->end(), buf, end);
+    if (!frames.empty())
+      frames.push_back(Frame{kind, npos, 0});
+  }
+
+  void container_end() {
+    if (frames.empty())
+      return;
+    const Frame top = frames.back();
+    frames.pop_back();
+    if (top.header_pos == npos)
+      return;
+    uint8_t buf[5];
+    uint8_t* end = top.kind == Kind::Seq ? detail::write_array_header(buf, top.count)
+                                         : detail::write_map_header(buf, top.count);
+    const auto size = static_cast<size_t>(end - buf);
+    // the placeholder is one byte, wider headers shift the elements forward
+    if (size > 1)
+      out->insert(out->begin() + static_cast<ptrdiff_t>(top.header_pos) + 1, buf + 1, end);
+    (*out)[top.header_pos] = buf[0];
+  }
+
+  void write_byte(uint8_t v) {
+    value_begin();
+    out->push_back(v);
+  }
+
+  void write_uint(uint64_t v) {
+    value_begin();
+    uint8_t buf[detail::scalar_max_size];
+    out->insert(out->end(), buf, detail::write_uint(buf, v));
+  }
+
+  void write_int(int64_t v) {
+    value_begin();
+    uint8_t buf[detail::scalar_max_size];
+    out->insert(out->end(), buf, detail::write_int(buf, v));
+  }
+
+  template<typename T>
+  void write_float(T v) {
+    value_begin();
+    uint8_t buf[detail::scalar_max_size];
+    out->insert(out->end(), buf, detail::write_float(buf, v));
+  }
+
+  void write_block(uint8_t* (*write_header)(uint8_t*, size_t), const void* val, size_t len) {
+    uint8_t buf[5];
+    out->insert(out->end(), buf, write_header(buf, len));
+    const auto* bytes = static_cast<const uint8_t*>(val);
+    out->insert(out->end(), bytes, bytes + len);
+  }
+
+  // Write the array header and grow the output for len elements of at most
+  // max_size bytes each, returns where the first element goes
+  uint8_t* seq_begin(size_t len, size_t max_size) {
+    value_begin();
+    uint8_t buf[5];
+    out->insert(out->end(), buf, detail::write_array_header(buf, len));
+    const size_t pos = out->size();
+    out->resize(pos + len * max_size);
+    return out->data() + pos;
+  }
+
+  template<typename T>
+  void serialize_seq_ints(const T* vals, size_t len) {
+    // reserve the worst case once, then write without checking the capacity per element
+    uint8_t* p = seq_begin(len, detail::scalar_max_size);
+    for (size_t i = 0; i < len; i++) {
+      if constexpr (std::is_signed_v<T>)
+        p = detail::write_int(p, vals[i]);
+      else
+        p = detail::write_uint(p, vals[i]);
+    }
+    out->resize(static_cast<size_t>(p - out->data()));
+  }
+
+  template<typename T>
+  void serialize_seq_floats(const T* vals, size_t len) {
+    uint8_t* p = seq_begin(len, 1 + sizeof(T));
+    for (size_t i = 0; i < len; i++)
+      p = detail::write_float(p, vals[i]);
+  }
+
+  std::vector<uint8_t>* out;
+  std::vector<Frame> frames;
+};
+
+/// MessagePack Serializer function from T to bytes, statically dispatched.
+/// Same output as to_bytes(), with the serializer calls resolved at compile time.
+template<typename T>
+auto to_bytes_static(T&& obj) -> cpp::result<std::vector<uint8_t>, serde::Error>
+{
+  std::vector<uint8_t> out;
+  MsgpackSerializer ser(out);
+  ser.serialize(std::forward<T>(obj));
+  return out;
+}
+
+/// MessagePack Serializer function from T to bytes appended to out, statically dispatched
+template<typename T>
+auto to_bytes_static(T&& obj, std::vector<uint8_t>& out) -> cpp::result<void, serde::Error>
+{
+  MsgpackSerializer ser(out);
+  ser.serialize(std::forward<T>(obj));
+  return {};
+}
+
+} // namespace serde_msgpack
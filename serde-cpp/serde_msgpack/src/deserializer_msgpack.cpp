@@ -0,0 +1,23 @@
+#include "serde_msgpack/de_msgpack.h"
+#include "serde_msgpack/deserializer_msgpack.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Serde MessagePack
+////////////////////////////////////////////////////////////////////////////////
+namespace serde_msgpack {
+
+namespace detail {
+
+auto DeserializerNew(const void* data, size_t len) -> std::unique_ptr<serde::Deserializer>
+{
+  return std::make_unique<MsgpackDeserializer>(data, len);
+}
+
+void DeserializerExpectEnd(serde::Deserializer* de)
+{
+  static_cast<MsgpackDeserializer*>(de)->expect_end();
+}
+
+} // namespace detail
+
+} // namespace serde_msgpack
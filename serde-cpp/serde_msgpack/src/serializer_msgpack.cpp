@@ -0,0 +1,18 @@
+#include "serde_msgpack/ser_msgpack.h"
+#include "serde_msgpack/serializer_msgpack.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Serde MessagePack
+////////////////////////////////////////////////////////////////////////////////
+namespace serde_msgpack {
+
+namespace detail {
+
+auto SerializerNew(std::vector<uint8_t>& out) -> std::unique_ptr<serde::Serializer>
+{
+  return std::make_unique<MsgpackSerializer>(out);
+}
+
+} // namespace detail
+
+} // namespace serde_msgpack
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include <cstring>
+
+#include "serde/std.h"
+#include "serde/serde.h"
+#include "serde_msgpack/serde_msgpack.h"
+#include "serde_msgpack/serializer_msgpack.h"
+#include "serde_msgpack/deserializer_msgpack.h"
+
+using Bytes = std::vector<uint8_t>;
+
+namespace {
+struct Point {
+  int32_t x;
+  int32_t y;
+  std::string label;
+  template<typename S>
+  void serialize(S& ser) const {
+    ser.serialize_struct_begin();
+    ser.serialize_struct_field("x", x);
+    ser.serialize_struct_field("y", y);
+    ser.serialize_struct_field("label", label);
+    ser.serialize_struct_end();
+  }
+  template<typename D>
+  void deserialize(D& de) {
+    de.deserialize_struct_begin();
+    de.deserialize_struct_field("x", x);
+    de.deserialize_struct_field("y", y);
+    de.deserialize_struct_field("label", label);
+    de.deserialize_struct_end();
+  }
+  bool operator==(const Point& o) const { return x == o.x && y == o.y && label == o.label; }
+};
+
+// bin payload borrowed from the input
+struct Blob {
+  const uint8_t* data = nullptr;
+  size_t size = 0;
+  void serialize(serde::Serializer& ser) const { ser.serialize_bytes(data, size); }
+  void deserialize(serde::Deserializer& de) {
+    const void* bytes = nullptr;
+    de.deserialize_bytes_borrowed(bytes, size);
+    data = static_cast<const uint8_t*>(bytes);
+  }
+};
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////////
+// Scalars
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+static void expect_bytes(T val, Bytes expected)
+{
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  EXPECT_EQ(bytes, expected);
+  auto de_val = serde_msgpack::from_bytes<T>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Builtin, Int_SmallestFormat)
+{
+  expect_bytes<int>(0, {0x00});
+  expect_bytes<int>(127, {0x7f});                         // positive fixint
+  expect_bytes<int>(128, {0xcc, 0x80});                   // uint8
+  expect_bytes<int>(-1, {0xff});                          // negative fixint
+  expect_bytes<int>(-32, {0xe0});
+  expect_bytes<int>(-33, {0xd0, 0xdf});                   // int8
+  expect_bytes<int>(-129, {0xd1, 0xff, 0x7f});            // int16
+  expect_bytes<int>(65536, {0xce, 0x00, 0x01, 0x00, 0x00}); // uint32
+  expect_bytes<int64_t>(INT64_MIN, {0xd3, 0x80, 0, 0, 0, 0, 0, 0, 0});
+  expect_bytes<uint64_t>(UINT64_MAX, {0xcf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff});
+  expect_bytes<uint16_t>(300, {0xcd, 0x01, 0x2c});
+}
+
+TEST(Builtin, Int_AnyFormat)
+{
+  // other encoders may not pick the smallest format, any one is read if the value fits
+  EXPECT_EQ(serde_msgpack::from_bytes<uint8_t>(Bytes{0xcf, 0, 0, 0, 0, 0, 0, 0, 200}).value(), 200);
+  EXPECT_EQ(serde_msgpack::from_bytes<int16_t>(Bytes{0xd3, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe}).value(), -2);
+  EXPECT_EQ(serde_msgpack::from_bytes<uint32_t>(Bytes{0xd0, 0x05}).value(), 5u);
+  EXPECT_EQ(serde_msgpack::from_bytes<double>(Bytes{0xd0, 0xfb}).value(), -5.0);
+  EXPECT_EQ(serde_msgpack::from_bytes<float>(Bytes{0xcb, 0x3f, 0xf8, 0, 0, 0, 0, 0, 0}).value(), 1.5f);
+}
+
+TEST(Builtin, Float_Bool_Char)
+{
+  expect_bytes<float>(1.5f, {0xca, 0x3f, 0xc0, 0x00, 0x00});
+  expect_bytes<double>(-2.0, {0xcb, 0xc0, 0, 0, 0, 0, 0, 0, 0});
+  expect_bytes<bool>(true, {0xc3});
+  expect_bytes<bool>(false, {0xc2});
+  expect_bytes<char>('A', {0x41});
+  expect_bytes<unsigned char>(250, {0xcc, 0xfa});
+}
+
+TEST(Builtin, Bytes_Bin)
+{
+  const uint8_t data[] = {1, 2, 3};
+  auto bytes = serde_msgpack::to_bytes(Blob{data, sizeof(data)}).value();
+  EXPECT_EQ(bytes, (Bytes{0xc4, 3, 1, 2, 3})); // bin8
+  auto blob = serde_msgpack::from_bytes<Blob>(bytes).value();
+  ASSERT_EQ(blob.size, 3u);
+  EXPECT_EQ(blob.data, bytes.data() + 2); // borrowed, not copied
+  EXPECT_EQ(std::memcmp(blob.data, data, 3), 0);
+
+  const Bytes large(300, 9);
+  auto large_bytes = serde_msgpack::to_bytes(Blob{large.data(), large.size()}).value();
+  EXPECT_EQ((Bytes{large_bytes.begin(), large_bytes.begin() + 3}), (Bytes{0xc5, 0x01, 0x2c})); // bin16
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Structs
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Builtin, Struct_Map)
+{
+  const Point val{1, -2, "p"};
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0x83, 0xa1, 'x', 0x01, 0xa1, 'y', 0xfe, 0xa5, 'l', 'a', 'b', 'e', 'l', 0xa1, 'p'}));
+  EXPECT_EQ(serde_msgpack::from_bytes<Point>(bytes).value(), val);
+  EXPECT_EQ(serde_msgpack::from_bytes_static<Point>(bytes).value(), val);
+}
+
+TEST(Builtin, Struct_FieldsOutOfOrder)
+{
+  // {"label": "q", "extra": [1, {"a": nil}], "y": 7, "x": 8}, as a dict from another language
+  const Bytes bytes = {0x84, 0xa5, 'l', 'a', 'b', 'e', 'l', 0xa1, 'q',
+                       0xa5, 'e', 'x', 't', 'r', 'a', 0x92, 0x01, 0x81, 0xa1, 'a', 0xc0,
+                       0xa1, 'y', 0x07, 0xa1, 'x', 0x08};
+  const Point val{8, 7, "q"};
+  EXPECT_EQ(serde_msgpack::from_bytes<Point>(bytes).value(), val);
+  using Many = std::vector<Point>;
+  Bytes many = {0x92};
+  many.insert(many.end(), bytes.begin(), bytes.end());
+  many.insert(many.end(), bytes.begin(), bytes.end());
+  EXPECT_EQ(serde_msgpack::from_bytes<Many>(many).value(), (Many{val, val}));
+}
+
+TEST(Builtin, Static_SameBytes)
+{
+  using Type = std::map<std::string, std::vector<std::optional<Point>>>;
+  const Type val = {{"a", {Point{1, 2, "one"}, std::nullopt}}, {"b", {}}};
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  EXPECT_EQ(serde_msgpack::to_bytes_static(val).value(), bytes);
+  EXPECT_EQ(serde_msgpack::from_bytes_static<Type>(bytes).value(), val);
+}
+
+TEST(Builtin, Reuse_Serializer)
+{
+  Bytes out;
+  serde_msgpack::MsgpackSerializer ser(out);
+  serde_msgpack::MsgpackDeserializer de;
+  for (int i = 0; i < 3; i++) {
+    out.clear();
+    ser.reset();
+    ser.serialize(Point{i, i, "r"});
+    de.reset(out.data(), out.size());
+    Point val{};
+    de.deserialize(val);
+    de.expect_end();
+    ASSERT_FALSE(de.has_error());
+    EXPECT_EQ(val, (Point{i, i, "r"}));
+  }
+}
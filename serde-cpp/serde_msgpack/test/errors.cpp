@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include "serde/std.h"
+#include "serde/serde.h"
+#include "serde_msgpack/serde_msgpack.h"
+#include "serde_msgpack/deserializer_msgpack.h"
+
+using Bytes = std::vector<uint8_t>;
+
+namespace {
+struct Pos {
+  int x = 0;
+  int y = 0;
+  template<typename D>
+  void deserialize(D& de) {
+    de.deserialize_struct_begin();
+    de.deserialize_struct_field("x", x);
+    de.deserialize_struct_field("y", y);
+    de.deserialize_struct_end();
+  }
+};
+} // namespace
+
+TEST(Errors, Truncated)
+{
+  auto res = serde_msgpack::from_bytes<std::string>(Bytes{0xa5, 'H', 'e'});
+  ASSERT_TRUE(res.has_error());
+  EXPECT_EQ(res.error().text, "unexpected end of input");
+  EXPECT_EQ(res.error().column, 1u);
+  EXPECT_EQ(serde_msgpack::from_bytes<int>(Bytes{0xcd, 0x01}).error().text, "unexpected end of input");
+  EXPECT_EQ(serde_msgpack::from_bytes<int>(Bytes{}).error().text, "unexpected end of input");
+  EXPECT_EQ(serde_msgpack::from_bytes<std::vector<int>>(Bytes{0x93, 1, 2}).error().text, "length exceeds input");
+  // ends after a uint16 element, the next element is not read past the input
+  EXPECT_EQ(serde_msgpack::from_bytes<std::vector<int>>(Bytes{0x93, 0xcd, 0x01, 0x00}).error().text, "unexpected end of input");
+  EXPECT_EQ(serde_msgpack::from_bytes_static<std::vector<int>>(Bytes{0x93, 0xcd, 0x01, 0x00}).error().text, "unexpected end of input");
+}
+
+TEST(Errors, CorruptLength)
+{
+  // an array32 of 4G elements must fail before resizing the vector to it
+  auto res = serde_msgpack::from_bytes<std::vector<std::string>>(Bytes{0xdd, 0xff, 0xff, 0xff, 0xff, 0xa0});
+  ASSERT_TRUE(res.has_error());
+  EXPECT_EQ(res.error().text, "length exceeds input");
+}
+
+TEST(Errors, WrongType)
+{
+  EXPECT_EQ(serde_msgpack::from_bytes<int>(Bytes{0xa1, '1'}).error().text, "expected an integer");
+  EXPECT_EQ(serde_msgpack::from_bytes<bool>(Bytes{0x01}).error().text, "expected a bool");
+  EXPECT_EQ(serde_msgpack::from_bytes<std::string>(Bytes{0x01}).error().text, "expected a string");
+  EXPECT_EQ(serde_msgpack::from_bytes<std::vector<int>>(Bytes{0x80}).error().text, "expected an array");
+  EXPECT_EQ(serde_msgpack::from_bytes<Pos>(Bytes{0x90}).error().text, "expected a map");
+  EXPECT_EQ(serde_msgpack::from_bytes<double>(Bytes{0xc0}).error().text, "expected a float");
+  EXPECT_EQ(serde_msgpack::from_bytes<int>(Bytes{0xc1}).error().text, "invalid format byte");
+}
+
+TEST(Errors, NumberOutOfRange)
+{
+  EXPECT_EQ(serde_msgpack::from_bytes<int16_t>(Bytes{0xcd, 0x80, 0x00}).error().text, "number out of range");
+  EXPECT_EQ(serde_msgpack::from_bytes<uint32_t>(Bytes{0xff}).error().text, "number out of range");
+  EXPECT_EQ(serde_msgpack::from_bytes<std::vector<uint8_t>>(Bytes{0x92, 1, 0xcd, 0x01, 0x00}).error().text, "number out of range");
+}
+
+TEST(Errors, MissingField)
+{
+  const Bytes bytes = {0x82, 0xa1, 'x', 0x01, 0xa1, 'z', 0x02};
+  auto res = serde_msgpack::from_bytes<Pos>(bytes);
+  ASSERT_TRUE(res.has_error());
+  EXPECT_EQ(res.error().text, "key not found in map: y");
+  EXPECT_EQ(res.error().column, 1u);
+  EXPECT_EQ(serde_msgpack::from_bytes_static<Pos>(bytes).error().text, res.error().text);
+}
+
+TEST(Errors, SequenceLengthMismatch)
+{
+  using Type = std::array<int, 3>;
+  EXPECT_EQ(serde_msgpack::from_bytes<Type>(Bytes{0x92, 1, 2}).error().text, "sequence length mismatch");
+}
+
+TEST(Errors, TrailingBytes)
+{
+  auto res = serde_msgpack::from_bytes<int>(Bytes{0x01, 0x02});
+  ASSERT_TRUE(res.has_error());
+  EXPECT_EQ(res.error().text, "trailing bytes after value");
+  EXPECT_EQ(res.error().column, 2u);
+}
@@ -0,0 +1,335 @@
+#include <gtest/gtest.h>
+
+#include "serde/std.h"
+#include "serde/serde.h"
+#include "serde_msgpack/serde_msgpack.h"
+
+using Bytes = std::vector<uint8_t>;
+
+///////////////////////////////////////////////////////////////////////////////
+// std::string
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, String_Value)
+{
+  using Type = std::string;
+  const Type val = "Hello";
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0xa5, 'H', 'e', 'l', 'l', 'o'})); // fixstr
+  auto de_val = serde_msgpack::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, String_Empty)
+{
+  using Type = std::string;
+  const Type val = {};
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0xa0}));
+  auto de_val = serde_msgpack::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, String_EmbeddedNull)
+{
+  using Type = std::string;
+  const Type val("Hello\0World", 11);
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  auto de_val = serde_msgpack::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, String_Long)
+{
+  using Type = std::string;
+  for (size_t len : {31u, 32u, 255u, 256u, 65535u, 65536u}) {
+    const Type val(len, 'x');
+    auto bytes = serde_msgpack::to_bytes(val).value();
+    const size_t header = len < 32 ? 1 : len <= 255 ? 2 : len <= 65535 ? 3 : 5; // fixstr, str8, str16, str32
+    EXPECT_EQ(bytes.size(), header + len);
+    auto de_val = serde_msgpack::from_bytes<Type>(bytes).value();
+    EXPECT_EQ(de_val, val);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::string_view
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, StringView_Borrowed)
+{
+  using Type = std::map<std::string_view, std::vector<std::string_view>>;
+  const Type val = {{"first", {"a", "bb"}}, {"second", {"ccc"}}};
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  auto de_val = serde_msgpack::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+  // the views point into the input bytes
+  const auto* data = reinterpret_cast<const char*>(bytes.data());
+  EXPECT_GE(de_val.at("second").at(0).data(), data);
+  EXPECT_LT(de_val.at("second").at(0).data(), data + bytes.size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::unique_ptr / std::shared_ptr / std::optional
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, UniquePtr_Value)
+{
+  using Type = std::unique_ptr<std::string>;
+  const Type val = std::make_unique<std::string>("Potatoes");
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  EXPECT_EQ(bytes.front(), 0xa8);
+  auto de_val = serde_msgpack::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(*de_val, *val);
+}
+
+TEST(Std, UniquePtr_Empty)
+{
+  using Type = std::unique_ptr<std::string>;
+  const Type val = {};
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0xc0})); // nil
+  auto de_val = serde_msgpack::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, SharedPtr_Value)
+{
+  using Type = std::shared_ptr<int>;
+  const Type val = std::make_shared<int>(-1);
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0xff}));
+  auto de_val = serde_msgpack::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(*de_val, *val);
+}
+
+TEST(Std, Optional_Value)
+{
+  using Type = std::vector<std::optional<int>>;
+  const Type val = {10, std::nullopt, 300};
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0x93, 0x0a, 0xc0, 0xcd, 0x01, 0x2c}));
+  auto de_val = serde_msgpack::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::array / std::vector
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, Array_Value)
+{
+  using Type = std::array<int32_t, 6>;
+  const Type val = {56, 333, 1, -3, -49, 100000};
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0x96, 56, 0xcd, 0x01, 0x4d, 1, 0xfd, 0xd0, 0xcf, 0xce, 0x00, 0x01, 0x86, 0xa0}));
+  auto de_val = serde_msgpack::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Array_Bool)
+{
+  using Type = std::array<bool, 3>;
+  const Type val = {true, false, true};
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0x93, 0xc3, 0xc2, 0xc3}));
+  auto de_val = serde_msgpack::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Vector_Empty)
+{
+  using Type = std::vector<size_t>;
+  const Type val = {};
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0x90}));
+  auto de_val = serde_msgpack::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Vector_Array16)
+{
+  using Type = std::vector<uint8_t>;
+  const Type val(16, 7);
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  EXPECT_EQ(bytes.size(), 3u + 16u);
+  EXPECT_EQ(bytes[0], 0xdc);
+  auto de_val = serde_msgpack::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Vector_Double)
+{
+  using Type = std::vector<double>;
+  const Type val = {1.5, -0.25};
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0x92, 0xcb, 0x3f, 0xf8, 0, 0, 0, 0, 0, 0, 0xcb, 0xbf, 0xd0, 0, 0, 0, 0, 0, 0}));
+  auto de_val = serde_msgpack::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Vector_Limits)
+{
+  using Type = std::vector<int64_t>;
+  const Type val = {INT64_MIN, INT32_MIN, -129, -128, -33, -32, 127, 128, 255, 256, 65536, INT64_MAX};
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  auto de_val = serde_msgpack::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+  auto de_u64 = serde_msgpack::from_bytes<std::vector<uint64_t>>(serde_msgpack::to_bytes(std::vector<uint64_t>{UINT64_MAX}).value()).value();
+  EXPECT_EQ(de_u64.at(0), UINT64_MAX);
+}
+
+TEST(Std, Vector_Nested)
+{
+  using Type = std::vector<std::vector<std::string>>;
+  const Type val = {{"a", "b"}, {}, {"c"}};
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0x93, 0x92, 0xa1, 'a', 0xa1, 'b', 0x90, 0x91, 0xa1, 'c'}));
+  auto de_val = serde_msgpack::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// std::variant / std::tuple / std::pair
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, Variant_Index)
+{
+  using Type = std::variant<char, int, std::string>;
+  const Type val = "Hi";
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0x81, 0x02, 0xa2, 'H', 'i'})); // {2: "Hi"}
+  auto de_val = serde_msgpack::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Tuple_Value)
+{
+  using Type = std::tuple<char, int, std::string>;
+  const Type val = {'z', 3467, "T"};
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0x93, 'z', 0xcd, 0x0d, 0x8b, 0xa1, 'T'}));
+  auto de_val = serde_msgpack::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Pair_Value)
+{
+  using Type = std::pair<int, std::string>;
+  const Type val = {69, "x"};
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  // {"first": 69, "second": "x"}
+  EXPECT_EQ(bytes, (Bytes{0x82, 0xa5, 'f', 'i', 'r', 's', 't', 69, 0xa6, 's', 'e', 'c', 'o', 'n', 'd', 0xa1, 'x'}));
+  auto de_val = serde_msgpack::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Containers
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Std, List_Value)
+{
+  using Type = std::list<int>;
+  const Type val = {7, 9, 4, -1};
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0x94, 7, 9, 4, 0xff}));
+  auto de_val = serde_msgpack::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, ForwardList_Value)
+{
+  // unknown size, the header is filled in at the end
+  using Type = std::forward_list<int>;
+  const Type val = {7, 9, 4, -1};
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0x94, 7, 9, 4, 0xff}));
+  auto de_val = serde_msgpack::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, ForwardList_Large)
+{
+  // more than 15 elements of unknown size, the elements move for the array16 header
+  using Type = std::vector<std::forward_list<int>>;
+  Type val(2);
+  for (int i = 0; i < 300; i++)
+    val[0].push_front(i);
+  val[1] = {1};
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  EXPECT_EQ(bytes[0], 0x92);
+  EXPECT_EQ(bytes[1], 0xdc);
+  auto de_val = serde_msgpack::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Set_Value)
+{
+  using Type = std::set<std::string>;
+  const Type val = {"b", "a"};
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0x92, 0xa1, 'a', 0xa1, 'b'}));
+  auto de_val = serde_msgpack::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, UnorderedSet_Value)
+{
+  using Type = std::unordered_set<int>;
+  const Type val = {5, 600, -70000};
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  auto de_val = serde_msgpack::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Map_Value)
+{
+  using Type = std::map<std::string, long int>;
+  const Type val = {{"foo", 10}, {"bar", 22}};
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0x82, 0xa3, 'b', 'a', 'r', 22, 0xa3, 'f', 'o', 'o', 10}));
+  auto de_val = serde_msgpack::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Map_IntKeys)
+{
+  using Type = std::map<int, std::vector<int>>;
+  const Type val = {{-1, {1}}, {1000, {}}};
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  EXPECT_EQ(bytes, (Bytes{0x82, 0xff, 0x91, 1, 0xcd, 0x03, 0xe8, 0x90}));
+  auto de_val = serde_msgpack::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Map_Map16)
+{
+  using Type = std::map<int, int>;
+  Type val;
+  for (int i = 0; i < 20; i++)
+    val[i] = i;
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  EXPECT_EQ(bytes[0], 0xde);
+  EXPECT_EQ(bytes.size(), 3u + 40u);
+  auto de_val = serde_msgpack::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, UnorderedMultiMap_Value)
+{
+  using Type = std::unordered_multimap<short int, std::string>;
+  const Type val = {{1, "one"}, {1, "uno"}, {2, "two"}};
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  auto de_val = serde_msgpack::from_bytes<Type>(bytes).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Deque_Queue_Stack)
+{
+  const std::deque<std::string> val = {"clubs", "queen", "king"};
+  auto bytes = serde_msgpack::to_bytes(val).value();
+  EXPECT_EQ(serde_msgpack::from_bytes<std::deque<std::string>>(bytes).value(), val);
+  EXPECT_EQ(serde_msgpack::from_bytes<std::queue<std::string>>(bytes).value(), std::queue<std::string>(val));
+  EXPECT_EQ(serde_msgpack::from_bytes<std::stack<std::string>>(bytes).value(), std::stack<std::string>(val));
+}
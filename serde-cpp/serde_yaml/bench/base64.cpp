@@ -0,0 +1,72 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "serde/std.h"
+#include "serde/serde.h"
+#include "serde/fmt/base64.h"
+#include "serde_yaml/serializer_yaml.h"
+#include "serde_yaml/deserializer_yaml.h"
+
+#include <c4/format.hpp>
+
+#include "bench.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// Base64: c4 cbase64/base64 (previous path) vs serde::fmt, and blob payloads
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+struct Certificate {
+  uint8_t der[4096];
+  void serialize(serde::Serializer& ser) const { ser.serialize_bytes(der, sizeof(der)); }
+  void deserialize(serde::Deserializer& de) { de.deserialize_bytes(der, sizeof(der)); }
+};
+} // namespace
+
+void bench_base64()
+{
+  std::mt19937 rng(42);
+  std::vector<uint8_t> blob(1 << 20);
+  for (auto& b : blob)
+    b = static_cast<uint8_t>(rng());
+
+  std::string text(serde::fmt::base64_encoded_size(blob.size()), '\0');
+  bench::measure("encode 1MiB, c4 cbase64", 10, [&] {
+    bench::do_not_optimize(c4::to_chars(c4::to_substr(text), c4::fmt::cbase64(blob.data(), blob.size())));
+  });
+  bench::measure("encode 1MiB, serde::fmt::base64_encode", 10, [&] {
+    bench::do_not_optimize(serde::fmt::base64_encode(blob.data(), blob.size(), &text[0]));
+  });
+
+  std::vector<uint8_t> decoded(blob.size());
+  bench::measure("decode 1MiB, c4 base64", 10, [&] {
+    auto wrapper = c4::fmt::base64(decoded.data(), decoded.size());
+    bench::do_not_optimize(c4::from_chars(c4::to_csubstr(text), &wrapper));
+  });
+  bench::measure("decode 1MiB, serde::fmt::base64_decode", 10, [&] {
+    bench::do_not_optimize(serde::fmt::base64_decode(text.data(), text.data() + text.size(),
+                                                     decoded.data(), decoded.data() + decoded.size()));
+  });
+  bench::measure("decode 1MiB, into std::vector", 10, [&] {
+    decoded.clear();
+    bench::do_not_optimize(serde::fmt::base64_decode(text.data(), text.data() + text.size(), decoded));
+  });
+
+  // a few KiB certificates, the typical blob in configs
+  std::vector<Certificate> certs(256);
+  for (auto& cert : certs)
+    std::copy(blob.begin(), blob.begin() + sizeof(cert.der), cert.der);
+  const std::string yaml = serde_yaml::to_string_static(certs).value();
+  bench::measure("serialize 256 x 4KiB blobs", 10, [&] {
+    bench::do_not_optimize(serde_yaml::to_string_static(certs).value());
+  });
+  serde_yaml::YamlDeserializer de;
+  bench::measure("deserialize 256 x 4KiB blobs", 10, [&] {
+    de.reset(yaml);
+    de.parse();
+    de.deserialize(certs);
+    bench::do_not_optimize(certs.data());
+  });
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+
+namespace bench {
+
+// Prevent the compiler from optimizing away a benchmark result
+template<typename T>
+inline void do_not_optimize(const T& val) {
+  asm volatile("" : : "r,m"(val) : "memory");
+}
+
+// Run fn for a number of iterations and print the average time per iteration
+template<typename Fn>
+inline double measure(const char* name, size_t iterations, Fn&& fn) {
+  fn(); // warm-up
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; i++)
+    fn();
+  auto end = std::chrono::steady_clock::now();
+  double us = std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+  std::printf("%-40s %12.2f us/iter\n", name, us);
+  return us;
+}
+
+} // namespace bench
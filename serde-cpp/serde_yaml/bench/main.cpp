@@ -0,0 +1,38 @@
+#include <cstdio>
+
+///////////////////////////////////////////////////////////////////////////////
+// serde_yaml benchmarks, build with -DCMAKE_BUILD_TYPE=Release for meaningful numbers
+///////////////////////////////////////////////////////////////////////////////
+
+void bench_static_dispatch();
+void bench_seq_scalars();
+void bench_malformed();
+void bench_struct_fields();
+void bench_reuse();
+void bench_stream();
+void bench_number_format();
+void bench_number_parse();
+void bench_base64();
+
+int main()
+{
+  std::printf("== static dispatch\n");
+  bench_static_dispatch();
+  std::printf("== sequence of scalars\n");
+  bench_seq_scalars();
+  std::printf("== malformed inputs\n");
+  bench_malformed();
+  std::printf("== struct fields lookup\n");
+  bench_struct_fields();
+  std::printf("== reused serializer/deserializer\n");
+  bench_reuse();
+  std::printf("== tree vs stream serializer\n");
+  bench_stream();
+  std::printf("== number formatting\n");
+  bench_number_format();
+  std::printf("== number parsing\n");
+  bench_number_parse();
+  std::printf("== base64\n");
+  bench_base64();
+  return 0;
+}
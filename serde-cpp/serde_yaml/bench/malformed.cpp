@@ -0,0 +1,62 @@
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "serde/std.h"
+#include "serde/serde.h"
+#include "serde_yaml/serde_yaml.h"
+
+#include "bench.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// Deserialization of malformed inputs, which fail fast on the first error
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+struct Record {
+  int32_t id;
+  std::string name;
+  std::vector<double> values;
+  template<typename D>
+  void deserialize(D& de) {
+    de.deserialize_struct_begin();
+    de.deserialize_struct_field("id", id);
+    de.deserialize_struct_field("name", name);
+    de.deserialize_struct_field("values", values);
+    de.deserialize_struct_end();
+  }
+};
+} // namespace
+
+void bench_malformed()
+{
+  constexpr int count = 10000;
+  auto record = [](int i, const char* id, const char* name_key) {
+    return std::string("- id: ") + id + "\n  " + name_key + ": record" + std::to_string(i) + "\n  values: [1.5, 2.5, 3.5]\n";
+  };
+
+  // well-formed document and malformed variants of it
+  std::string valid, bad_scalar_first, bad_scalar_middle, missing_field, syntax_error;
+  for (int i = 0; i < count; i++) {
+    const std::string id = std::to_string(i);
+    valid += record(i, id.c_str(), "name");
+    bad_scalar_first += record(i, i == 0 ? "zero" : id.c_str(), "name");
+    bad_scalar_middle += record(i, i == count / 2 ? "half" : id.c_str(), "name");
+    missing_field += record(i, id.c_str(), i == 0 ? "nmae" : "name");
+  }
+  syntax_error = valid + "- id: [1, 2\n";
+
+  const std::pair<const char*, const std::string*> corpus[] = {
+    {"valid (full decode)", &valid},
+    {"invalid scalar in first record", &bad_scalar_first},
+    {"invalid scalar in middle record", &bad_scalar_middle},
+    {"missing field in first record", &missing_field},
+    {"syntax error at the end", &syntax_error},
+  };
+  for (auto& [name, yaml] : corpus) {
+    bench::measure(name, 20, [&] {
+      auto res = serde_yaml::from_str<std::vector<Record>>(std::string(*yaml));
+      bench::do_not_optimize(res);
+    });
+  }
+}
@@ -0,0 +1,53 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include "serde/std.h"
+#include "serde/serde.h"
+#include "serde/fmt/number.h"
+#include "serde_yaml/serializer_yaml.h"
+
+#include <c4/format.hpp>
+
+#include "bench.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// Number formatting: c4 to_chars (previous path) vs serde::fmt, and float-heavy payloads
+///////////////////////////////////////////////////////////////////////////////
+
+void bench_number_format()
+{
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<double> dist(-1e6, 1e6);
+  std::vector<double> doubles(100000);
+  for (auto& v : doubles)
+    v = dist(rng);
+  std::vector<int64_t> ints(doubles.begin(), doubles.end());
+
+  char buf[64];
+  bench::measure("double, c4::to_chars", 10, [&] {
+    for (double v : doubles)
+      bench::do_not_optimize(c4::to_chars(c4::substr(buf, sizeof(buf)), v));
+  });
+  bench::measure("double, serde::fmt::format_float", 10, [&] {
+    for (double v : doubles)
+      bench::do_not_optimize(serde::fmt::format_float(buf, buf + sizeof(buf), v));
+  });
+  bench::measure("int64, c4::to_chars", 10, [&] {
+    for (int64_t v : ints)
+      bench::do_not_optimize(c4::to_chars(c4::substr(buf, sizeof(buf)), v));
+  });
+  bench::measure("int64, serde::fmt::format_int", 10, [&] {
+    for (int64_t v : ints)
+      bench::do_not_optimize(serde::fmt::format_int(buf, buf + sizeof(buf), v));
+  });
+
+  bench::measure("serialize vector<double>", 10, [&] {
+    bench::do_not_optimize(serde_yaml::to_string_static(doubles).value());
+  });
+  serde_yaml::EmitOptions fixed;
+  fixed.float_precision = 3;
+  bench::measure("serialize vector<double>, precision 3", 10, [&] {
+    bench::do_not_optimize(serde_yaml::to_string_static(doubles, fixed).value());
+  });
+}
@@ -0,0 +1,68 @@
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "serde/std.h"
+#include "serde/serde.h"
+#include "serde/fmt/parse.h"
+#include "serde_yaml/serializer_yaml.h"
+#include "serde_yaml/deserializer_yaml.h"
+
+#include <c4/format.hpp>
+
+#include "bench.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// Number parsing: c4 from_chars (previous path) vs serde::fmt, and number-heavy payloads
+///////////////////////////////////////////////////////////////////////////////
+
+void bench_number_parse()
+{
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<double> dist(-1e6, 1e6);
+  std::vector<double> doubles(100000);
+  for (auto& v : doubles)
+    v = dist(rng);
+  std::vector<int64_t> ints(doubles.begin(), doubles.end());
+
+  std::vector<std::string> double_texts, int_texts;
+  char buf[64];
+  for (double v : doubles) {
+    std::snprintf(buf, sizeof(buf), "%.17g", v);
+    double_texts.emplace_back(buf);
+  }
+  for (int64_t v : ints)
+    int_texts.emplace_back(std::to_string(v));
+
+  bench::measure("double, c4::from_chars", 10, [&] {
+    double v = 0;
+    for (auto& s : double_texts)
+      bench::do_not_optimize(c4::from_chars(c4::csubstr(s.data(), s.size()), &v));
+  });
+  bench::measure("double, serde::fmt::parse_float", 10, [&] {
+    double v = 0;
+    for (auto& s : double_texts)
+      bench::do_not_optimize(serde::fmt::parse_float(s.data(), s.data() + s.size(), v));
+  });
+  bench::measure("int64, c4::from_chars", 10, [&] {
+    int64_t v = 0;
+    for (auto& s : int_texts)
+      bench::do_not_optimize(c4::from_chars(c4::csubstr(s.data(), s.size()), &v));
+  });
+  bench::measure("int64, serde::fmt::parse_int", 10, [&] {
+    int64_t v = 0;
+    for (auto& s : int_texts)
+      bench::do_not_optimize(serde::fmt::parse_int(s.data(), s.data() + s.size(), v));
+  });
+
+  const std::string yaml = serde_yaml::to_string_static(doubles).value();
+  serde_yaml::YamlDeserializer de;
+  std::vector<double> out;
+  bench::measure("deserialize vector<double>", 10, [&] {
+    de.reset(yaml);
+    de.parse();
+    de.deserialize(out);
+    bench::do_not_optimize(out.data());
+  });
+}
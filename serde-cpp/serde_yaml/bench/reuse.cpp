@@ -0,0 +1,88 @@
+#include <string>
+#include <vector>
+
+#include "serde/std.h"
+#include "serde/serde.h"
+#include "serde_yaml/serializer_yaml.h"
+#include "serde_yaml/deserializer_yaml.h"
+#include "serde_yaml/de_yaml.h"
+
+#include "bench.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// Fresh serializer/deserializer per message vs reused ones with reset()
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+struct Message {
+  int32_t id;
+  std::string topic;
+  std::vector<double> payload;
+  template<typename S>
+  void serialize(S& ser) const {
+    ser.serialize_struct_begin();
+    ser.serialize_struct_field("id", id);
+    ser.serialize_struct_field("topic", topic);
+    ser.serialize_struct_field("payload", payload);
+    ser.serialize_struct_end();
+  }
+  template<typename D>
+  void deserialize(D& de) {
+    de.deserialize_struct_begin();
+    de.deserialize_struct_field("id", id);
+    de.deserialize_struct_field("topic", topic);
+    de.deserialize_struct_field("payload", payload);
+    de.deserialize_struct_end();
+  }
+};
+} // namespace
+
+void bench_reuse()
+{
+  constexpr size_t messages = 1000;
+  const Message message{42, "sensors/temperature", {21.5, 21.75, 22.0, 22.25}};
+  const std::string yaml = serde_yaml::to_string_static(message).value();
+
+  bench::measure("encode, fresh serializer", 10, [&] {
+    for (size_t i = 0; i < messages; i++)
+      bench::do_not_optimize(serde_yaml::to_string_static(message).value());
+  });
+  serde_yaml::YamlSerializer ser;
+  std::string out;
+  bench::measure("encode, reused serializer", 10, [&] {
+    for (size_t i = 0; i < messages; i++) {
+      ser.reset();
+      ser.serialize(message);
+      ser.emit(out);
+      bench::do_not_optimize(out);
+    }
+  });
+
+  bench::measure("decode, fresh deserializer", 10, [&] {
+    for (size_t i = 0; i < messages; i++)
+      bench::do_not_optimize(serde_yaml::from_str_static<Message>(std::string(yaml)).value());
+  });
+  serde_yaml::YamlDeserializer de;
+  Message decoded{};
+  bench::measure("decode, reused deserializer", 10, [&] {
+    for (size_t i = 0; i < messages; i++) {
+      de.reset(yaml);
+      de.parse();
+      de.deserialize(decoded);
+      bench::do_not_optimize(decoded);
+    }
+  });
+
+  bench::measure("decode, from_str(std::string&&) copy", 10, [&] {
+    for (size_t i = 0; i < messages; i++)
+      bench::do_not_optimize(serde_yaml::from_str<Message>(std::string(yaml)).value());
+  });
+  bench::measure("decode, from_str(std::string_view)", 10, [&] {
+    for (size_t i = 0; i < messages; i++)
+      bench::do_not_optimize(serde_yaml::from_str<Message>(std::string_view(yaml)).value());
+  });
+  bench::measure("decode, from_str(de, std::string_view)", 10, [&] {
+    for (size_t i = 0; i < messages; i++)
+      bench::do_not_optimize(serde_yaml::from_str<Message>(de, std::string_view(yaml)).value());
+  });
+}
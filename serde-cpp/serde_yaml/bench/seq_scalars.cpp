@@ -0,0 +1,73 @@
+#include <vector>
+
+#include "serde/std.h"
+#include "serde/serde.h"
+#include "serde_yaml/serializer_yaml.h"
+#include "serde_yaml/deserializer_yaml.h"
+
+#include "bench.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// Bulk serialize_seq_*/deserialize_seq_* calls vs element by element de/serialization
+///////////////////////////////////////////////////////////////////////////////
+
+void bench_seq_scalars()
+{
+  std::vector<float> floats(100000);
+  std::vector<int32_t> ints(100000);
+  for (size_t i = 0; i < floats.size(); i++) {
+    floats[i] = i * 0.25f;
+    ints[i] = static_cast<int32_t>(i * 7);
+  }
+
+  bench::measure("float elements (serialize_float)", 10, [&] {
+    serde_yaml::YamlSerializer ser;
+    ser.serde::Serializer::serialize_seq_float(floats.data(), floats.size());
+    bench::do_not_optimize(ser.emit());
+  });
+  bench::measure("float block (serialize_seq_float)", 10, [&] {
+    serde_yaml::YamlSerializer ser;
+    ser.serialize(floats);
+    bench::do_not_optimize(ser.emit());
+  });
+  bench::measure("i32 elements (serialize_i32)", 10, [&] {
+    serde_yaml::YamlSerializer ser;
+    ser.serde::Serializer::serialize_seq_i32(ints.data(), ints.size());
+    bench::do_not_optimize(ser.emit());
+  });
+  bench::measure("i32 block (serialize_seq_i32)", 10, [&] {
+    serde_yaml::YamlSerializer ser;
+    ser.serialize(ints);
+    bench::do_not_optimize(ser.emit());
+  });
+
+  std::string floats_yaml = serde_yaml::to_string_static(floats).value();
+  std::string ints_yaml = serde_yaml::to_string_static(ints).value();
+
+  bench::measure("float elements (deserialize_float)", 10, [&] {
+    serde_yaml::YamlDeserializer de(floats_yaml);
+    de.parse();
+    floats.resize(100000);
+    de.serde::Deserializer::deserialize_seq_float(floats.data(), floats.size());
+    bench::do_not_optimize(floats);
+  });
+  bench::measure("float block (deserialize_seq_float)", 10, [&] {
+    serde_yaml::YamlDeserializer de(floats_yaml);
+    de.parse();
+    de.deserialize(floats);
+    bench::do_not_optimize(floats);
+  });
+  bench::measure("i32 elements (deserialize_i32)", 10, [&] {
+    serde_yaml::YamlDeserializer de(ints_yaml);
+    de.parse();
+    ints.resize(100000);
+    de.serde::Deserializer::deserialize_seq_i32(ints.data(), ints.size());
+    bench::do_not_optimize(ints);
+  });
+  bench::measure("i32 block (deserialize_seq_i32)", 10, [&] {
+    serde_yaml::YamlDeserializer de(ints_yaml);
+    de.parse();
+    de.deserialize(ints);
+    bench::do_not_optimize(ints);
+  });
+}
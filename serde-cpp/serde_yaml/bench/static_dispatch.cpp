@@ -0,0 +1,78 @@
+#include <string>
+#include <vector>
+
+#include "serde/std.h"
+#include "serde/serde.h"
+#include "serde_yaml/serde_yaml.h"
+#include "serde_yaml/serializer_yaml.h"
+#include "serde_yaml/deserializer_yaml.h"
+
+#include "bench.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// Virtual Serializer vs StaticSerializer dispatch on the same types
+///////////////////////////////////////////////////////////////////////////////
+
+struct Sample {
+  int32_t id;
+  double value;
+  bool valid;
+  std::string name;
+  std::vector<int16_t> tags;
+};
+
+namespace serde {
+// same shape as serde_gen output
+template<typename T>
+struct Serialize<T, std::enable_if_t<std::is_same_v<T, Sample>>> {
+template<typename S>
+static void serialize(S& ser, const T& val) {
+ser.serialize_struct_begin();
+ser.serialize_struct_field("id", val.id);
+ser.serialize_struct_field("value", val.value);
+ser.serialize_struct_field("valid", val.valid);
+ser.serialize_struct_field("name", val.name);
+ser.serialize_struct_field("tags", val.tags);
+ser.serialize_struct_end();
+}
+};
+template<typename T>
+struct Deserialize<T, std::enable_if_t<std::is_same_v<T, Sample>>> {
+template<typename D>
+static void deserialize(D& de, T& val) {
+de.deserialize_struct_begin();
+de.deserialize_struct_field("id", val.id);
+de.deserialize_struct_field("value", val.value);
+de.deserialize_struct_field("valid", val.valid);
+de.deserialize_struct_field("name", val.name);
+de.deserialize_struct_field("tags", val.tags);
+de.deserialize_struct_end();
+}
+};
+} // namespace serde
+
+void bench_static_dispatch()
+{
+  std::vector<Sample> samples;
+  for (int i = 0; i < 10000; i++)
+    samples.push_back(Sample{i, i * 0.5, i % 2 == 0, "sample" + std::to_string(i), {1, 2, 3}});
+
+  bench::measure("serialize virtual (to_string)", 20, [&] {
+    auto str = serde_yaml::to_string(samples).value();
+    bench::do_not_optimize(str);
+  });
+  bench::measure("serialize static (to_string_static)", 20, [&] {
+    auto str = serde_yaml::to_string_static(samples).value();
+    bench::do_not_optimize(str);
+  });
+
+  const std::string yaml = serde_yaml::to_string(samples).value();
+  bench::measure("deserialize virtual (from_str)", 20, [&] {
+    auto vec = serde_yaml::from_str<std::vector<Sample>>(std::string(yaml)).value();
+    bench::do_not_optimize(vec);
+  });
+  bench::measure("deserialize static (from_str_static)", 20, [&] {
+    auto vec = serde_yaml::from_str_static<std::vector<Sample>>(std::string(yaml)).value();
+    bench::do_not_optimize(vec);
+  });
+}
@@ -0,0 +1,56 @@
+#include <map>
+#include <string>
+#include <vector>
+
+#include "serde/std.h"
+#include "serde/serde.h"
+#include "serde_yaml/serializer_yaml.h"
+#include "serde_yaml/stream_serializer_yaml.h"
+
+#include "bench.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// ryml::Tree based serializer vs streaming the yaml text directly
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+struct Record {
+  int32_t id;
+  std::string name;
+  std::vector<double> values;
+  std::map<std::string, int64_t> counters;
+  template<typename S>
+  void serialize(S& ser) const {
+    ser.serialize_struct_begin();
+    ser.serialize_struct_field("id", id);
+    ser.serialize_struct_field("name", name);
+    ser.serialize_struct_field("values", values);
+    ser.serialize_struct_field("counters", counters);
+    ser.serialize_struct_end();
+  }
+};
+} // namespace
+
+void bench_stream()
+{
+  std::vector<Record> records(10000);
+  for (size_t i = 0; i < records.size(); i++) {
+    records[i].id = int32_t(i);
+    records[i].name = "record-" + std::to_string(i);
+    records[i].values = {i * 0.5, i * 0.25, -1.0 * i};
+    records[i].counters = {{"reads", int64_t(i * 3)}, {"writes", int64_t(i)}};
+  }
+
+  bench::measure("tree serializer", 10, [&] {
+    bench::do_not_optimize(serde_yaml::to_string_static(records).value());
+  });
+  bench::measure("stream serializer", 10, [&] {
+    bench::do_not_optimize(serde_yaml::to_string_stream(records).value());
+  });
+  std::string out;
+  bench::measure("stream serializer, reused output", 10, [&] {
+    out.clear();
+    serde_yaml::to_string_stream(records, out).value();
+    bench::do_not_optimize(out);
+  });
+}
@@ -0,0 +1,63 @@
+#include <array>
+#include <string>
+#include <vector>
+
+#include "serde/std.h"
+#include "serde/serde.h"
+#include "serde_yaml/deserializer_yaml.h"
+
+#include "bench.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// Struct field lookup with keys in field order vs out of order (wide structs)
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+constexpr size_t num_fields = 80;
+
+struct Config {
+  std::array<int32_t, num_fields> fields{};
+  static const char* name(size_t i) {
+    static const auto names = [] {
+      std::array<std::string, num_fields> names;
+      for (size_t i = 0; i < num_fields; i++)
+        names[i] = "config_field_" + std::to_string(i);
+      return names;
+    }();
+    return names[i].c_str();
+  }
+  template<typename D>
+  void deserialize(D& de) {
+    de.deserialize_struct_begin();
+    for (size_t i = 0; i < num_fields; i++)
+      de.deserialize_struct_field(name(i), fields[i]);
+    de.deserialize_struct_end();
+  }
+};
+
+std::string configs_yaml(size_t count, bool reverse) {
+  std::string yaml;
+  for (size_t n = 0; n < count; n++) {
+    for (size_t i = 0; i < num_fields; i++) {
+      size_t k = reverse ? num_fields - 1 - i : i;
+      yaml += (i ? "  " : "- ") + std::string(Config::name(k)) + ": " + std::to_string(k) + "\n";
+    }
+  }
+  return yaml;
+}
+} // namespace
+
+void bench_struct_fields()
+{
+  const std::string in_order = configs_yaml(1000, false);
+  const std::string out_of_order = configs_yaml(1000, true);
+
+  bench::measure("80 fields in order", 10, [&] {
+    auto configs = serde_yaml::from_str_static<std::vector<Config>>(std::string(in_order));
+    bench::do_not_optimize(configs);
+  });
+  bench::measure("80 fields out of order", 10, [&] {
+    auto configs = serde_yaml::from_str_static<std::vector<Config>>(std::string(out_of_order));
+    bench::do_not_optimize(configs);
+  });
+}
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <memory>
 #include <string>
+#include <string_view>
 #include <serde/de.h>
 #include <serde/error.h>
 #include <serde/result.hpp>
@@ -16,11 +18,116 @@ template<typename T>
 auto from_str(std::string&& str) -> cpp::result<T, serde::Error>
 {
   auto de = detail::DeserializerNew(std::move(str));
-  std::ignore = detail::DeserializerParse(de.get());
+  if (auto parsed = detail::DeserializerParse(de.get()); !parsed)
+    return cpp::fail(std::move(parsed).error());
   T obj{};
   de->deserialize(obj);
+  if (de->has_error())
+    return cpp::fail(de->error());
   return std::move(obj);
 }
 
+/// YAML Deserializer function from a read-only yaml buffer to T.
+/// The yaml is parsed from a copy owned by the deserializer and released on return,
+/// so T must not borrow strings from it (e.g. std::string_view fields),
+/// use from_str_borrowed() for those.
+/// Each call allocates its own deserializer and copy, to decode many messages without
+/// allocating for each of them keep a YamlDeserializer and use from_str(de, str)
+/// (deserializer_yaml.h), which reuses its buffers.
+template<typename T>
+auto from_str(std::string_view str) -> cpp::result<T, serde::Error>
+{
+  auto de = detail::DeserializerNew(str);
+  if (auto parsed = detail::DeserializerParse(de.get()); !parsed)
+    return cpp::fail(std::move(parsed).error());
+  T obj{};
+  de->deserialize(obj);
+  if (de->has_error())
+    return cpp::fail(de->error());
+  return std::move(obj);
+}
+
+/// YAML Deserializer function from a null-terminated yaml string to T, see from_str(std::string_view)
+template<typename T>
+auto from_str(const char* str) -> cpp::result<T, serde::Error>
+{
+  return from_str<T>(std::string_view(str));
+}
+
+/// YAML Deserializer function from a yaml file to T.
+/// The file is memory mapped copy-on-write and parsed in place, without reading it
+/// into a string first. The file itself is never modified.
+template<typename T>
+auto from_file(const std::string& path) -> cpp::result<T, serde::Error>
+{
+  auto de = detail::DeserializerOpen(path.c_str());
+  if (!de)
+    return cpp::fail(std::move(de).error());
+  if (auto parsed = detail::DeserializerParse(de.value().get()); !parsed)
+    return cpp::fail(std::move(parsed).error());
+  T obj{};
+  de.value()->deserialize(obj);
+  if (de.value()->has_error())
+    return cpp::fail(de.value()->error());
+  return std::move(obj);
+}
+
+/// YAML Deserializer function from the yaml file open in fd to T.
+/// Same as from_file(), fd is not closed and its offset is left untouched.
+/// fd must refer to a regular file, pipes, sockets and ttys can't be mapped and fail.
+template<typename T>
+auto from_fd(int fd) -> cpp::result<T, serde::Error>
+{
+  auto de = detail::DeserializerMap(fd);
+  if (!de)
+    return cpp::fail(std::move(de).error());
+  if (auto parsed = detail::DeserializerParse(de.value().get()); !parsed)
+    return cpp::fail(std::move(parsed).error());
+  T obj{};
+  de.value()->deserialize(obj);
+  if (de.value()->has_error())
+    return cpp::fail(de.value()->error());
+  return std::move(obj);
+}
+
+/// YAML Document, a deserialized T together with the yaml string it was deserialized from.
+/// Borrowed strings in T (std::string_view) point into the document's yaml string,
+/// so they are valid as long as the Document is alive, moving the Document keeps them valid.
+template<typename T>
+class Document {
+public:
+  const T& value() const { return obj; }
+  T& value() { return obj; }
+  const T& operator*() const { return obj; }
+  T& operator*() { return obj; }
+  const T* operator->() const { return &obj; }
+  T* operator->() { return &obj; }
+
+private:
+  template<typename U>
+  friend auto from_str_borrowed(std::string&& str) -> cpp::result<Document<U>, serde::Error>;
+
+  Document(std::unique_ptr<serde::Deserializer> de) : de(std::move(de)), obj{} {}
+
+  // de owns the yaml string, declared first to be destroyed after obj
+  std::unique_ptr<serde::Deserializer> de;
+  T obj;
+};
+
+/// YAML Deserializer function from yaml string to a Document of T.
+/// Same as from_str(), but T may borrow strings from the yaml string without copying them,
+/// e.g. std::string_view fields, as the Document keeps the yaml string alive.
+template<typename T>
+auto from_str_borrowed(std::string&& str) -> cpp::result<Document<T>, serde::Error>
+{
+  Document<T> doc(detail::DeserializerNew(std::move(str)));
+  if (auto parsed = detail::DeserializerParse(doc.de.get()); !parsed)
+    return cpp::fail(std::move(parsed).error());
+  doc.de->deserialize(doc.obj);
+  if (doc.de->has_error())
+    return cpp::fail(doc.de->error());
+  return std::move(doc);
+}
+
 } // namespace serde_yaml
 
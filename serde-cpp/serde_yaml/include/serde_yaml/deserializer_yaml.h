@@ -0,0 +1,610 @@
+#pragma once
+
+#include <stack>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <cstring>
+#include <serde/de.h>
+#include <serde/error.h>
+#include <serde/result.hpp>
+#include <serde/fmt/base64.h>
+
+#include <ryml_std.hpp>
+#include <ryml.hpp>
+#include <c4/format.hpp>
+
+#include "detail/mapped_file.h"
+#include "detail/number_yaml.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Serde YAML
+////////////////////////////////////////////////////////////////////////////////
+namespace serde_yaml {
+
+/// YAML Deserializer
+///
+/// Parses the YAML text into a ryml::Tree and walks it from the Deserializer calls.
+/// It is a StaticDeserializer, so deserializing through a YamlDeserializer& has
+/// all the deserializer calls resolved at compile time (see from_str_static).
+///
+/// A YamlDeserializer can be kept around and reused with reset(yaml), which keeps
+/// the yaml buffer, tree nodes, arena and stack capacity, so once warmed up
+/// parsing and deserializing another document does not allocate in the deserializer.
+class YamlDeserializer final : public serde::StaticDeserializer<YamlDeserializer> {
+  // Position in the tree, found is set for map entries pushed by deserialize_map_key_find.
+  // Frames pushed by deserialize_map_begin keep the map id, their node is the entry
+  // expected next, used as cursor by deserialize_map_key_find.
+  struct Frame {
+    ryml::NodeRef node;
+    bool found;
+    size_t map = ryml::NONE;
+  };
+
+  // Hashed key index of a wide map, built on the first out of order key lookup in it
+  struct KeyIndex {
+    size_t map = ryml::NONE;
+    std::unordered_map<std::string_view, size_t> ids;
+  };
+  // maps with at least this many entries get a KeyIndex, smaller ones are searched linearly
+  static constexpr size_t wide_map = 16;
+
+  // Thrown from the ryml error callback, ryml expects the callback not to return
+  struct ParseError {
+    std::string text;
+    ryml::Location location;
+  };
+
+  std::string yaml;
+  detail::MappedFile file; // parsed instead of yaml when mapped
+  ryml::Callbacks callbacks;
+  ryml::Parser parser;
+  ryml::Tree tree;
+  std::stack<Frame, std::vector<Frame>> stack;
+  std::vector<KeyIndex> indexes; // indexes of the maps in the stack, reused
+  size_t num_indexes = 0;
+  bool expect_key = false;
+
+public:
+  YamlDeserializer()
+    : callbacks(nullptr, nullptr, nullptr, &YamlDeserializer::throw_parse_error),
+      parser(callbacks, ryml::ParserOptions().locations(true)),
+      tree(callbacks) {
+  }
+
+  YamlDeserializer(std::string yaml) : YamlDeserializer() {
+    this->yaml = std::move(yaml);
+  }
+
+  /// Drop the parsed document and error to deserialize again, keeping the allocated capacity
+  /// of the yaml buffer, tree nodes, arena, parser and stack.
+  void reset() {
+    yaml.clear();
+    file = {};
+    tree.clear();
+    tree.clear_arena();
+    while (!stack.empty())
+      stack.pop();
+    num_indexes = 0;
+    expect_key = false;
+    clear_error();
+  }
+
+  /// Reset and copy yaml into the kept yaml buffer, to be parsed next
+  void reset(std::string_view yaml) {
+    reset();
+    this->yaml.assign(yaml.data(), yaml.size());
+  }
+
+  /// Reset and take the memory mapped file to be parsed next, in place.
+  /// The mapping is kept until the next reset.
+  void reset(detail::MappedFile&& file) {
+    reset();
+    this->file = std::move(file);
+  }
+
+  void parse() {
+    const auto source = file.data() ? ryml::substr(file.data(), file.size())
+                                    : ryml::substr(yaml.data(), yaml.length());
+    try {
+      parser.parse_in_place({}, source, &tree);
+    }
+    catch (const ParseError& e) {
+      // the parser position is already 1-based
+      set_error({serde::Error::Kind::Invalid, e.location.line, e.location.col, e.text});
+      return;
+    }
+    stack.push({tree.rootref(), false});
+  }
+
+  template<typename T>
+  void deserialize_scalar(T& val) {
+    if (has_error()) return;
+    auto& curr = stack.top().node;
+    if (!is_valid(curr)) {
+      return fail("no scalar to extract");
+    }
+
+    if (expect_key) {
+      if (curr.has_key()) {
+        if (auto status = parse_scalar(curr.key(), val); status != serde::fmt::ParseStatus::Ok)
+          return fail(status == serde::fmt::ParseStatus::OutOfRange ? "number out of range" : "invalid scalar key");
+        //std::cout << "got key " << val << std::endl;
+      }
+      else {
+        fail("no key to extract");
+      }
+    }
+    else if (curr.has_val()) {
+      if (auto status = parse_scalar(curr.val(), val); status != serde::fmt::ParseStatus::Ok)
+        return fail(status == serde::fmt::ParseStatus::OutOfRange ? "number out of range" : "invalid scalar value");
+      //std::cout << "got val " << val << std::endl;
+      if (curr.has_parent() && curr.parent_is_seq()) {
+        //std::cout << "next_sibling" << std::endl;
+        curr = curr.next_sibling();
+      }
+    }
+    else {
+      fail("no value to extract");
+    }
+  }
+
+  void deserialize_bool(bool& val) final { deserialize_scalar(val); }
+  void deserialize_i8(int8_t& val) final { deserialize_scalar(val); }
+  void deserialize_u8(uint8_t& val) final { deserialize_scalar(val); }
+  void deserialize_i16(int16_t& val) final { deserialize_scalar(val); }
+  void deserialize_u16(uint16_t& val) final { deserialize_scalar(val); }
+  void deserialize_i32(int32_t& val) final { deserialize_scalar(val); }
+  void deserialize_u32(uint32_t& val) final { deserialize_scalar(val); }
+  void deserialize_i64(int64_t& val) final { deserialize_scalar(val); }
+  void deserialize_u64(uint64_t& val) final { deserialize_scalar(val); }
+  void deserialize_float(float& val) final { deserialize_scalar(val); }
+  void deserialize_double(double& val) final { deserialize_scalar(val); }
+  void deserialize_char(char& val) final { deserialize_scalar(val); }
+  void deserialize_uchar(unsigned char& val) final { deserialize_scalar(val); }
+
+  void deserialize_cstr(char* val, size_t len) final {
+    if (has_error()) return;
+    auto& curr = stack.top().node;
+    if (!is_valid(curr)) {
+      return fail("no scalar to extract");
+    }
+
+    if (expect_key) {
+      if (curr.has_key()) {
+        auto cstr = curr.key();
+        len = std::min(cstr.len + 1, len);
+        if (len) {
+          std::strncpy(val, cstr.data(), len);
+          val[len-1] = '\0';
+        }
+        //std::cout << "got key " << val << std::endl;
+      }
+      else {
+        fail("no key to extract");
+      }
+    }
+    else if (curr.has_val()) {
+      auto cstr = curr.val();
+      len = std::min(cstr.len + 1, len);
+      if (len) {
+        std::strncpy(val, cstr.data(), len);
+        val[len-1] = '\0';
+      }
+      //std::cout << "got val " << val << std::endl;
+      if (curr.has_parent() && curr.parent_is_seq()) {
+        //std::cout << "next_sibling" << std::endl;
+        curr = curr.next_sibling();
+      }
+    }
+    else {
+      //std::cerr << "no value to extract" << std::endl;
+      if (len)
+        *val = '\0';
+    }
+  }
+
+  void deserialize_str(const char*& val, size_t& len) final {
+    if (has_error()) return;
+    auto& curr = stack.top().node;
+    if (!is_valid(curr)) {
+      return fail("no scalar to extract");
+    }
+
+    if (expect_key) {
+      if (curr.has_key()) {
+        auto str = curr.key();
+        val = str.str;
+        len = str.len;
+      }
+      else {
+        fail("no key to extract");
+      }
+    }
+    else if (curr.has_val()) {
+      auto str = curr.val();
+      val = str.str;
+      len = str.len;
+      if (curr.has_parent() && curr.parent_is_seq()) {
+        curr = curr.next_sibling();
+      }
+    }
+    else {
+      val = nullptr;
+      len = 0;
+    }
+  }
+
+  void deserialize_bytes(void* val, size_t len) final {
+    if (has_error()) return;
+    auto& curr = stack.top().node;
+    if (!is_valid(curr)) {
+      return fail("no scalar to extract");
+    }
+
+    if (expect_key) {
+      if (curr.has_key()) {
+        if (len && !decode_base64(curr.key(), val, len))
+          return fail("invalid base64 key");
+        //std::cout << "got key " << val << std::endl;
+      }
+      else {
+        fail("no key to extract");
+      }
+    }
+    else if (curr.has_val()) {
+      if (len && !decode_base64(curr.val(), val, len))
+        return fail("invalid base64 value");
+      //std::cout << "got val " << val << std::endl;
+      if (curr.has_parent() && curr.parent_is_seq()) {
+        //std::cout << "next_sibling" << std::endl;
+        curr = curr.next_sibling();
+      }
+    }
+    else {
+      //std::cerr << "no value to extract" << std::endl;
+    }
+  }
+
+  void deserialize_length(size_t& len) final {
+    if (has_error()) return;
+    auto& curr = stack.top().node;
+    if (!is_valid(curr)) {
+      return fail("not valid node to check length");
+    }
+    if (expect_key) {
+      if (curr.has_key()) {
+        //std::cout << "got key " << val << std::endl;
+        len = curr.key().len;
+      }
+      else {
+        fail("no key to check length");
+      }
+    }
+    else if (curr.has_val()) {
+      len = curr.val().len;
+    }
+    else {
+      //std::cerr << "no value to check length" << std::endl;
+      len = 0;
+    }
+  }
+
+  // Optional //////////////////////////////////////////////////////////////////
+  void deserialize_is_some(bool& val) final {
+    if (has_error()) return;
+    auto& curr = stack.top().node;
+    if (!is_valid(curr)) {
+      return fail("not valid node to check for some");
+    }
+    if (expect_key) {
+      if (curr.has_key()) {
+        //std::cout << "got key " << val << std::endl;
+        val = !curr.key_is_null();
+      }
+      else {
+        fail("no key to check for some");
+      }
+    }
+    else if (curr.has_val()) {
+      val = !curr.val_is_null();
+    }
+    else if (curr.is_container()) {
+      val = true;
+    }
+    else {
+      fail("no value to check for some");
+    }
+  }
+
+  void deserialize_none() final {
+    if (has_error()) return;
+    auto& curr = stack.top().node;
+    if (!is_valid(curr)) {
+      return fail("not valid node to extract none");
+    }
+    if (expect_key) {
+      if (curr.has_key()) {
+        //std::cout << "got key " << val << std::endl;
+      }
+      else {
+        fail("no key to extract none");
+      }
+    }
+    else if (curr.has_val()) {
+      //std::cout << "got val " << val << std::endl;
+      if (curr.has_parent() && curr.parent_is_seq()) {
+        //std::cout << "next_sibling" << std::endl;
+        curr = curr.next_sibling();
+      }
+    }
+    else {
+      fail("no value to extract none");
+    }
+  }
+
+
+  void deserialize_seq_begin() final {
+    if (has_error()) return;
+    auto curr = stack.top().node;
+    if (!curr.is_seq()) {
+      return fail("no sequence to begin");
+    }
+    //std::cout << "num_children "  << curr.num_children() << std::endl;
+    stack.push({curr.first_child(), false});
+  }
+
+  void deserialize_seq_end() final {
+    if (has_error()) return;
+    stack.pop();
+    next_in_seq();
+  }
+
+  void deserialize_seq_size(size_t& val) final {
+    if (has_error()) return;
+    auto curr = stack.top().node;
+    if (!curr.is_seq()) {
+      return fail("no sequence to count");
+    }
+    val = curr.num_children();
+  }
+
+  // Sequence of scalars ///////////////////////////////////////////////////////
+  template<typename T>
+  void deserialize_seq_scalars(T* vals, size_t len) {
+    if (has_error()) return;
+    auto curr = stack.top().node;
+    if (!curr.is_seq()) {
+      return fail("no sequence to deserialize");
+    }
+    if (curr.num_children() != len) {
+      return fail("sequence length mismatch");
+    }
+    // walk the children by id and convert the values in one loop,
+    // no stack push/pop nor NodeRef hop for each element
+    size_t i = 0;
+    for (size_t child = tree.first_child(curr.id()); child != ryml::NONE && i < len; child = tree.next_sibling(child), i++) {
+      if (!tree.has_val(child))
+        return fail("no value to extract", tree.ref(child));
+      if (auto status = parse_scalar(tree.val(child), vals[i]); status != serde::fmt::ParseStatus::Ok)
+        return fail(status == serde::fmt::ParseStatus::OutOfRange ? "number out of range" : "invalid scalar value",
+                    tree.ref(child));
+    }
+    next_in_seq();
+  }
+
+  void deserialize_seq_bool(bool* vals, size_t len) final { deserialize_seq_scalars(vals, len); }
+  void deserialize_seq_i8(int8_t* vals, size_t len) final { deserialize_seq_scalars(vals, len); }
+  void deserialize_seq_u8(uint8_t* vals, size_t len) final { deserialize_seq_scalars(vals, len); }
+  void deserialize_seq_i16(int16_t* vals, size_t len) final { deserialize_seq_scalars(vals, len); }
+  void deserialize_seq_u16(uint16_t* vals, size_t len) final { deserialize_seq_scalars(vals, len); }
+  void deserialize_seq_i32(int32_t* vals, size_t len) final { deserialize_seq_scalars(vals, len); }
+  void deserialize_seq_u32(uint32_t* vals, size_t len) final { deserialize_seq_scalars(vals, len); }
+  void deserialize_seq_i64(int64_t* vals, size_t len) final { deserialize_seq_scalars(vals, len); }
+  void deserialize_seq_u64(uint64_t* vals, size_t len) final { deserialize_seq_scalars(vals, len); }
+  void deserialize_seq_float(float* vals, size_t len) final { deserialize_seq_scalars(vals, len); }
+  void deserialize_seq_double(double* vals, size_t len) final { deserialize_seq_scalars(vals, len); }
+  void deserialize_seq_char(char* vals, size_t len) final { deserialize_seq_scalars(vals, len); }
+  void deserialize_seq_uchar(unsigned char* vals, size_t len) final { deserialize_seq_scalars(vals, len); }
+
+  void deserialize_map_begin() final {
+    if (has_error()) return;
+    auto curr = stack.top().node;
+    if (!curr.is_map()) {
+      return fail("no map to begin");
+    }
+    //std::cout << "num_children "  << curr.num_children() << std::endl;
+    stack.push({curr.first_child(), false, curr.id()});
+  }
+
+  void deserialize_map_size(size_t& val) final {
+    if (has_error()) return;
+    auto curr = stack.top().node;
+    if (!curr.is_map()) {
+      return fail("no map to count");
+    }
+    val = curr.num_children();
+  }
+
+  void deserialize_map_end() final {
+    if (has_error()) return;
+    if (num_indexes && indexes[num_indexes - 1].map == stack.top().map)
+      num_indexes--;
+    stack.pop();
+    next_in_seq();
+  }
+
+  void deserialize_map_key_begin() final {
+    // TODO: check for has_key
+    //std::cout << "expect key" << std::endl;
+    expect_key = true;
+  }
+
+  void deserialize_map_key_end() final {
+    // TODO: check for was true
+    //std::cout << "unexpect key" << std::endl;
+    expect_key = false;
+  }
+
+  void deserialize_map_key_find(const char* key) final {
+    if (has_error()) return;
+    auto& top = stack.top();
+    if (top.map == ryml::NONE) {
+      return fail("no map to find key");
+    }
+    // keys are usually in the same order as they are looked up (struct field order),
+    // so try the entry after the last found one before searching the whole map
+    const ryml::csubstr name(key, std::strlen(key));
+    size_t child = top.node.id();
+    if (child == ryml::NONE || tree.key(child) != name)
+      child = find_key(top.map, name);
+    if (child == ryml::NONE) {
+      return fail("key not found in map");
+    }
+    top.node = ryml::NodeRef(&tree, tree.next_sibling(child));
+    stack.push({ryml::NodeRef(&tree, child), true});
+  }
+
+  void deserialize_map_value_begin() final {
+  }
+  void deserialize_map_value_end() final {
+    if (has_error()) return;
+    auto& top = stack.top();
+    if (top.found) {
+      stack.pop();
+    } else {
+      top.node = top.node.next_sibling();
+    }
+  }
+
+  // Struct ////////////////////////////////////////////////////////////////////
+  void deserialize_struct_begin() final {
+    deserialize_map_begin();
+  }
+
+  void deserialize_struct_end() final {
+    deserialize_map_end();
+  }
+
+  void deserialize_struct_field_begin(const char* name) final {
+    deserialize_map_key_find(name);
+    deserialize_map_value_begin();
+  }
+
+  void deserialize_struct_field_end() final {
+    deserialize_map_value_end();
+  }
+
+private:
+  static bool is_valid(const ryml::NodeRef& node) {
+    return node.valid() && !node.is_seed() && node.get();
+  }
+
+  // Decode straight into the caller's bytes, shorter contents leave the rest of them untouched
+  static bool decode_base64(ryml::csubstr s, void* val, size_t len) {
+    auto* out = static_cast<uint8_t*>(val);
+    return serde::fmt::base64_decode(s.str, s.str + s.len, out, out + len) != nullptr;
+  }
+
+  // Numbers through the serde::fmt parser, bool and char through ryml
+  template<typename T>
+  static serde::fmt::ParseStatus parse_scalar(ryml::csubstr s, T& val) {
+    if constexpr (detail::is_number_v<T>)
+      return detail::parse_number(s.str, s.str + s.len, val);
+    else
+      return from_chars(s, &val) ? serde::fmt::ParseStatus::Ok : serde::fmt::ParseStatus::Invalid;
+  }
+
+  // Set the error at the location of the innermost valid node in the stack.
+  // The remaining calls return early on error, so the stack is not needed anymore.
+  void fail(const char* text) {
+    while (!stack.empty() && !is_valid(stack.top().node))
+      stack.pop();
+    fail(text, stack.empty() ? ryml::NodeRef{} : stack.top().node);
+  }
+
+  // Set the error at the location of node, if valid
+  void fail(const char* text, const ryml::NodeRef& node) {
+    serde::Error error{serde::Error::Kind::Invalid};
+    error.text = text;
+    if (is_valid(node)) {
+      // node locations are 0-based in ryml
+      auto location = parser.location(node);
+      error.line = location.line + 1;
+      error.column = location.col + 1;
+    }
+    set_error(std::move(error));
+  }
+
+  [[noreturn]] static void throw_parse_error(const char* msg, size_t msg_len, ryml::Location location, void*) {
+    throw ParseError{std::string(msg, msg_len), location};
+  }
+
+  // Search a key in a map, through its KeyIndex if it is a wide map
+  size_t find_key(size_t map, ryml::csubstr key) {
+    if (tree.num_children(map) < wide_map)
+      return tree.find_child(map, key);
+
+    KeyIndex* index = nullptr;
+    if (num_indexes && indexes[num_indexes - 1].map == map) {
+      index = &indexes[num_indexes - 1];
+    }
+    else {
+      if (num_indexes == indexes.size())
+        indexes.emplace_back();
+      index = &indexes[num_indexes++];
+      index->map = map;
+      index->ids.clear();
+      for (size_t child = tree.first_child(map); child != ryml::NONE; child = tree.next_sibling(child)) {
+        const ryml::csubstr k = tree.key(child);
+        index->ids.emplace(std::string_view(k.str, k.len), child); // first one wins, like find_child
+      }
+    }
+    auto it = index->ids.find(std::string_view(key.str, key.len));
+    return it != index->ids.end() ? it->second : ryml::NONE;
+  }
+
+  // Step over a sequence element that has been deserialized as a whole (seq, map, struct)
+  void next_in_seq() {
+    if (stack.empty())
+      return;
+    auto& curr = stack.top().node;
+    if (curr.has_parent() && curr.parent_is_seq()) {
+      curr = curr.next_sibling();
+    }
+  }
+};
+
+/// YAML Deserializer function from yaml string to T, statically dispatched.
+/// Same result as from_str(), but the YamlDeserializer calls are inlined into
+/// the deserialization of T instead of going through the Deserializer vtable.
+template<typename T>
+auto from_str_static(std::string&& str) -> cpp::result<T, serde::Error>
+{
+  YamlDeserializer de(std::move(str));
+  de.parse();
+  T obj{};
+  de.deserialize(obj);
+  if (de.has_error())
+    return cpp::fail(de.error());
+  return std::move(obj);
+}
+
+/// YAML Deserializer function from a read-only yaml buffer to T, reusing the caller's deserializer.
+/// The yaml is copied into the kept yaml buffer of de and parsed there, so once de is warmed up
+/// deserializing one message after the other does not allocate in the deserializer.
+/// Borrowed strings in T (std::string_view) point into that buffer, valid until de is reset.
+template<typename T>
+auto from_str(YamlDeserializer& de, std::string_view str) -> cpp::result<T, serde::Error>
+{
+  de.reset(str);
+  de.parse();
+  T obj{};
+  de.deserialize(obj);
+  if (de.has_error())
+    return cpp::fail(de.error());
+  return std::move(obj);
+}
+
+} // namespace serde_yaml
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <serde/error.h>
 #include <serde/result.hpp>
 #include <serde/de/deserializer.h>
@@ -12,7 +13,11 @@
 namespace serde_yaml::detail {
 
 auto DeserializerNew(std::string&& str) -> std::unique_ptr<serde::Deserializer>;
+// Deserializer of a copy of str
+auto DeserializerNew(std::string_view str) -> std::unique_ptr<serde::Deserializer>;
 auto DeserializerParse(serde::Deserializer* de) -> cpp::result<void, serde::Error>;
+auto DeserializerOpen(const char* path) -> cpp::result<std::unique_ptr<serde::Deserializer>, serde::Error>;
+auto DeserializerMap(int fd) -> cpp::result<std::unique_ptr<serde::Deserializer>, serde::Error>;
 
 } // namespace serde_yaml::detail
 
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <istream>
+#include <string>
+#include <string_view>
+
+///////////////////////////////////////////////////////////////////////////////
+// Serde YAML detail
+///////////////////////////////////////////////////////////////////////////////
+namespace serde_yaml::detail {
+
+/// Reads the lines of an input stream or of an in-memory buffer one at a time,
+/// with one line of lookahead (unget).
+/// Only the current line is held in memory when reading from a stream.
+class LineReader {
+public:
+  explicit LineReader(std::istream& in) : in(&in) {}
+  explicit LineReader(std::string_view buf) : buf(buf) {}
+
+  /// Next line without its '\n', false at the end of the input.
+  /// The line is valid until the next call.
+  bool next(std::string_view& line) {
+    if (pending) {
+      pending = false;
+    }
+    else if (in) {
+      if (!std::getline(*in, storage))
+        return false;
+      current = storage;
+    }
+    else {
+      if (pos >= buf.size())
+        return false;
+      size_t end = buf.find('\n', pos);
+      if (end == std::string_view::npos)
+        end = buf.size();
+      current = buf.substr(pos, end - pos);
+      pos = end + 1;
+    }
+    number++;
+    line = current;
+    return true;
+  }
+
+  /// Give the last line back, to be returned again by next()
+  void unget() {
+    pending = true;
+    number--;
+  }
+
+  /// 1-based number of the last line returned by next()
+  size_t line_number() const { return number; }
+
+private:
+  std::istream* in = nullptr;
+  std::string_view buf;
+  size_t pos = 0;
+  std::string storage;
+  std::string_view current;
+  bool pending = false;
+  size_t number = 0;
+};
+
+/// Whether line is the document marker ("---" or "...") alone or followed by a space
+inline bool is_document_marker(std::string_view line, std::string_view marker) {
+  return line.substr(0, 3) == marker &&
+    (line.size() == 3 || line[3] == ' ' || line[3] == '\t' || line[3] == '\r');
+}
+inline bool is_document_start(std::string_view line) { return is_document_marker(line, "---"); }
+inline bool is_document_end(std::string_view line) { return is_document_marker(line, "..."); }
+
+} // namespace serde_yaml::detail
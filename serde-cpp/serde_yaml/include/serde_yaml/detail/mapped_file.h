@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <serde/error.h>
+#include <serde/result.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+// Serde YAML detail
+///////////////////////////////////////////////////////////////////////////////
+namespace serde_yaml::detail {
+
+/// Private (copy-on-write) read/write memory mapping of a whole file.
+/// Writes to the mapping are never carried through to the file, so the parser
+/// can modify the text in place. The mapping is released on destruction.
+class MappedFile {
+public:
+  MappedFile() = default;
+  MappedFile(MappedFile&& other) noexcept : ptr(other.ptr), len(other.len) {
+    other.ptr = nullptr;
+    other.len = 0;
+  }
+  MappedFile& operator=(MappedFile&& other) noexcept;
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile();
+
+  /// Map the regular file open in fd, fd may be closed afterwards
+  static auto map(int fd) -> cpp::result<MappedFile, serde::Error>;
+  /// Map the file at path
+  static auto open(const char* path) -> cpp::result<MappedFile, serde::Error>;
+
+  char* data() const { return ptr; }
+  size_t size() const { return len; }
+
+private:
+  char* ptr = nullptr;
+  size_t len = 0;
+};
+
+} // namespace serde_yaml::detail
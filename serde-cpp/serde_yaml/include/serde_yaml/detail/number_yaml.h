@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <serde/fmt/number.h>
+#include <serde/fmt/parse.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// Serde YAML detail
+///////////////////////////////////////////////////////////////////////////////
+namespace serde_yaml::detail {
+
+/// Buffer size for format_number, with room for the fixed notation of large values
+inline constexpr size_t number_max_chars = 128;
+
+/// Types formatted as YAML numbers, bool and char have their own representation
+template<typename T>
+inline constexpr bool is_number_v = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>;
+
+/// Write the number v as a YAML scalar into [first, last): integers in decimal, floats with the
+/// shortest round-trip digits or, if precision >= 0, with precision digits after the decimal point,
+/// and non finite floats as .inf, -.inf and .nan.
+/// Returns the end of the written text, or nullptr if it doesn't fit.
+template<typename T>
+inline char* format_number(char* first, char* last, T v, int precision = -1) {
+  if constexpr (std::is_floating_point_v<T>) {
+    if (!std::isfinite(v)) {
+      const char* text = std::isnan(v) ? ".nan" : v < 0 ? "-.inf" : ".inf";
+      const size_t len = std::strlen(text);
+      if (static_cast<size_t>(last - first) < len)
+        return nullptr;
+      std::memcpy(first, text, len);
+      return first + len;
+    }
+    if (precision >= 0) {
+      // fall back to the shortest format for values too large for the buffer in fixed notation
+      if (char* end = serde::fmt::format_float_fixed(first, last, v, precision))
+        return end;
+    }
+    return serde::fmt::format_float(first, last, v);
+  }
+  else {
+    return serde::fmt::format_int(first, last, v);
+  }
+}
+
+/// Parse the whole of [first, last) as a YAML number: integers in decimal or with a 0x, 0o or 0b prefix,
+/// floats in decimal and the non finite .inf, -.inf, .nan (also as .Inf, .INF, .NaN, .NAN).
+template<typename T>
+inline serde::fmt::ParseStatus parse_number(const char* first, const char* last, T& val) {
+  if constexpr (std::is_floating_point_v<T>) {
+    const bool has_sign = first != last && (*first == '+' || *first == '-');
+    const std::string_view text(first + has_sign, static_cast<size_t>(last - first) - has_sign);
+    if (text == ".inf" || text == ".Inf" || text == ".INF") {
+      val = has_sign && *first == '-' ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+      return serde::fmt::ParseStatus::Ok;
+    }
+    if (!has_sign && (text == ".nan" || text == ".NaN" || text == ".NAN")) {
+      val = std::numeric_limits<T>::quiet_NaN();
+      return serde::fmt::ParseStatus::Ok;
+    }
+    return serde::fmt::parse_float(first, last, val);
+  }
+  else {
+    return serde::fmt::parse_int(first, last, val);
+  }
+}
+
+} // namespace serde_yaml::detail
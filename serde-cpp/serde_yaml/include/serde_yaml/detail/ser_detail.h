@@ -2,17 +2,24 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 #include <serde/error.h>
 #include <serde/result.hpp>
 #include <serde/ser/serializer.h>
 
+#include "../emit_options.h"
+
 ///////////////////////////////////////////////////////////////////////////////
 // Serde YAML detail
 ///////////////////////////////////////////////////////////////////////////////
 namespace serde_yaml::detail {
 
 auto SerializerNew() -> std::unique_ptr<serde::Serializer>;
+auto SerializerNew(const EmitOptions& options) -> std::unique_ptr<serde::Serializer>;
 auto SerializerOutput(serde::Serializer* ser) -> cpp::result<std::string, serde::Error>;
+auto SerializerOutputAppend(serde::Serializer* ser, std::string& out) -> cpp::result<void, serde::Error>;
+auto SerializerOutputAppend(serde::Serializer* ser, std::vector<char>& out) -> cpp::result<void, serde::Error>;
+auto SerializerOutputBuffer(serde::Serializer* ser, char* buf, size_t len) -> cpp::result<size_t, serde::Error>;
 
 } // namespace serde_yaml::detail
 
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+////////////////////////////////////////////////////////////////////////////////
+// Serde YAML
+////////////////////////////////////////////////////////////////////////////////
+namespace serde_yaml {
+
+/// YAML emission options of YamlSerializer.
+/// By default everything is emitted in block style, one scalar per line.
+struct EmitOptions {
+  /// Emit sequences and maps holding only scalars in flow style: `[1, 2, 3]`, `{x: 1, y: 2}`
+  bool flow_scalars = false;
+  /// With flow_scalars, only up to this many elements, larger ones are still emitted in block style
+  size_t flow_max_size = SIZE_MAX;
+  /// Emit any sequence or map nested this deep (the top-level container is depth 0) in flow style,
+  /// including all of its contents
+  size_t flow_min_depth = SIZE_MAX;
+  /// Digits after the decimal point of floats and doubles, in fixed notation (3.14, 100.00).
+  /// Negative for the fewest digits that read back to the exact same value (default).
+  int float_precision = -1;
+
+  /// Flow style for every sequence and map of scalars
+  static EmitOptions flow() {
+    EmitOptions options;
+    options.flow_scalars = true;
+    return options;
+  }
+
+  /// Flow style for small sequences and maps only: of scalars with at most max_size elements,
+  /// or nested at least min_depth deep
+  static EmitOptions flow_auto(size_t max_size, size_t min_depth = SIZE_MAX) {
+    EmitOptions options;
+    options.flow_scalars = true;
+    options.flow_max_size = max_size;
+    options.flow_min_depth = min_depth;
+    return options;
+  }
+};
+
+} // namespace serde_yaml
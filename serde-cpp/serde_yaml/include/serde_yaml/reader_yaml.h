@@ -0,0 +1,230 @@
+#pragma once
+
+#include <algorithm>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <serde/de.h>
+#include <serde/error.h>
+#include <serde/result.hpp>
+
+#include "deserializer_yaml.h"
+#include "detail/line_reader.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Serde YAML
+////////////////////////////////////////////////////////////////////////////////
+namespace serde_yaml {
+
+/// YAML Sequence Reader
+///
+/// Deserializes a top-level block sequence one element at a time, reading the
+/// input incrementally, so huge sequences are decoded with the memory of a single
+/// element: only the lines of the current element and its ryml::Tree are held,
+/// the YamlDeserializer and its buffers are reused from one element to the next.
+///
+/// The input must be a block sequence ("- " items), optionally preceded by
+/// comments, directives and a "---" document start. An empty flow sequence "[]"
+/// is read as no elements, other flow sequences are rejected.
+///
+/// ryml has no event parser to stop at the end of an element, so the elements are
+/// split on the text instead: an element ends at the next line starting with "- "
+/// at the indentation of the first item. That is always the next item in block
+/// context, including plain scalars continued over several lines and block scalars.
+/// Only a quoted scalar or a flow sequence/map spanning lines may legally have such
+/// a line inside, which is not supported: it is split there and reported as a parse
+/// error. A parse error stops the reader, as the element boundaries can't be trusted
+/// anymore, while an element that parses but fails to deserialize into T is skipped.
+///
+///   std::ifstream file("inventory.yaml");
+///   serde_yaml::YamlSeqReader reader(file);
+///   Item item;
+///   while (reader.next(item).value()) { ... }
+class YamlSeqReader {
+public:
+  explicit YamlSeqReader(std::istream& in) : lines(in) {}
+  explicit YamlSeqReader(std::string_view yaml) : lines(yaml) {}
+
+  /// Deserialize the next element of the sequence into val.
+  /// Returns false once there are no more elements.
+  /// Borrowed strings in val are valid until the next call.
+  template<typename T>
+  auto next(T& val) -> cpp::result<bool, serde::Error> {
+    auto read = read_element();
+    if (!read || !read.value())
+      return read;
+    de.reset(chunk);
+    de.parse();
+    if (de.has_error()) {
+      done = true;
+      return cpp::fail(element_error());
+    }
+    de.deserialize_seq_begin();
+    de.deserialize(val);
+    de.deserialize_seq_end();
+    if (de.has_error())
+      return cpp::fail(element_error());
+    return true;
+  }
+
+private:
+  // Error of the current element, at its location in the input
+  serde::Error element_error() const {
+    serde::Error err = de.error();
+    if (err.line)
+      err.line += first_line - 1;
+    return err;
+  }
+
+  // Collect the lines of the next element into chunk, as a single element sequence
+  auto read_element() -> cpp::result<bool, serde::Error> {
+    chunk.clear();
+    if (done)
+      return false;
+    std::string_view line;
+    if (!started) {
+      started = true;
+      if (auto first = find_first_item(); !first || !first.value()) {
+        done = true;
+        return first;
+      }
+    }
+    if (!lines.next(line) || detail::is_document_start(line) || detail::is_document_end(line)) {
+      done = true;
+      return false;
+    }
+    first_line = lines.line_number();
+    append_line(line);
+    while (lines.next(line)) {
+      if (is_item(line) || detail::is_document_start(line) || detail::is_document_end(line)) {
+        lines.unget();
+        break;
+      }
+      append_line(line);
+    }
+    return true;
+  }
+
+  // Skip the lines before the first item and take its indentation, leaving it to be read next
+  auto find_first_item() -> cpp::result<bool, serde::Error> {
+    std::string_view line;
+    while (lines.next(line)) {
+      const size_t first = line.find_first_not_of(" \t\r");
+      if (first == std::string_view::npos || line[first] == '#' || line[0] == '%' || detail::is_document_start(line))
+        continue;
+      if (line.substr(first, 2) == "[]")
+        return false;
+      indent = first;
+      if (!is_item(line)) {
+        return cpp::fail(serde::Error{serde::Error::Kind::Invalid, lines.line_number(), first + 1,
+                                      "expected a block sequence"});
+      }
+      lines.unget();
+      return true;
+    }
+    return false;
+  }
+
+  bool is_item(std::string_view line) const {
+    if (line.size() <= indent || line[indent] != '-')
+      return false;
+    if (line.find_first_not_of(' ') != indent)
+      return false;
+    return line.size() == indent + 1 || line[indent + 1] == ' ' || line[indent + 1] == '\t' || line[indent + 1] == '\r';
+  }
+
+  void append_line(std::string_view line) {
+    chunk.append(line.data(), line.size());
+    chunk.push_back('\n');
+  }
+
+  detail::LineReader lines;
+  std::string chunk;
+  YamlDeserializer de;
+  size_t indent = 0;
+  size_t first_line = 0;
+  bool started = false;
+  bool done = false;
+};
+
+/// YAML Document Reader
+///
+/// Deserializes the documents of a YAML stream ("---" separated documents, such
+/// as log or snapshot files) one at a time, reading the input incrementally, so
+/// only the current document and its ryml::Tree are held in memory and the
+/// YamlDeserializer and its buffers are reused from one document to the next.
+///
+/// Documents without any content (only comments or blank lines) are skipped.
+///
+///   std::ifstream file("snapshots.yaml");
+///   serde_yaml::YamlDocReader reader(file);
+///   Snapshot snapshot;
+///   while (reader.next(snapshot).value()) { ... }
+class YamlDocReader {
+public:
+  explicit YamlDocReader(std::istream& in) : lines(in) {}
+  explicit YamlDocReader(std::string_view yaml) : lines(yaml) {}
+
+  /// Deserialize the next document of the stream into val.
+  /// Returns false once there are no more documents.
+  /// Borrowed strings in val are valid until the next call.
+  template<typename T>
+  auto next(T& val) -> cpp::result<bool, serde::Error> {
+    if (!read_document())
+      return false;
+    de.reset(chunk);
+    de.parse();
+    de.deserialize(val);
+    if (de.has_error()) {
+      serde::Error err = de.error();
+      if (err.line)
+        err.line += first_line - 1; // document location to input location
+      return cpp::fail(std::move(err));
+    }
+    return true;
+  }
+
+private:
+  // Collect the lines of the next document into chunk, without its markers and directives.
+  // Those are replaced by blank lines, so locations in chunk map back to the input lines.
+  bool read_document() {
+    chunk.clear();
+    bool has_content = false;
+    std::string_view line;
+    while (lines.next(line)) {
+      if (detail::is_document_start(line)) {
+        if (has_content) {
+          lines.unget();
+          break;
+        }
+        chunk.clear(); // drop the previous empty document, if any
+        line.remove_prefix(std::min<size_t>(4, line.size()));
+      }
+      else if (detail::is_document_end(line)) {
+        if (has_content)
+          break;
+        chunk.clear();
+        continue;
+      }
+      else if (!has_content && !line.empty() && line[0] == '%') {
+        line = {}; // directive
+      }
+      if (chunk.empty())
+        first_line = lines.line_number();
+      if (!has_content) {
+        const size_t first = line.find_first_not_of(" \t\r");
+        has_content = first != std::string_view::npos && line[first] != '#';
+      }
+      chunk.append(line.data(), line.size());
+      chunk.push_back('\n');
+    }
+    return has_content;
+  }
+
+  detail::LineReader lines;
+  std::string chunk;
+  YamlDeserializer de;
+  size_t first_line = 0;
+};
+
+} // namespace serde_yaml
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <serde/ser.h>
 #include <serde/error.h>
 #include <serde/result.hpp>
@@ -21,5 +22,44 @@ auto to_string(T&& obj) -> cpp::result<std::string, serde::Error>
   return detail::SerializerOutput(ser.get());
 }
 
+/// YAML Serializer function from T to yaml string with the given emission options,
+/// e.g. EmitOptions::flow() for compact flow style sequences and maps of scalars
+template<typename T>
+auto to_string(T&& obj, const EmitOptions& options) -> cpp::result<std::string, serde::Error>
+{
+  auto ser = detail::SerializerNew(options);
+  ser->serialize(std::forward<T>(obj));
+  return detail::SerializerOutput(ser.get());
+}
+
+/// YAML Serializer function from T to yaml string, appended to out
+template<typename T>
+auto to_string(T&& obj, std::string& out) -> cpp::result<void, serde::Error>
+{
+  auto ser = detail::SerializerNew();
+  ser->serialize(std::forward<T>(obj));
+  return detail::SerializerOutputAppend(ser.get(), out);
+}
+
+/// YAML Serializer function from T to yaml text, appended to out
+template<typename T>
+auto to_buffer(T&& obj, std::vector<char>& out) -> cpp::result<void, serde::Error>
+{
+  auto ser = detail::SerializerNew();
+  ser->serialize(std::forward<T>(obj));
+  return detail::SerializerOutputAppend(ser.get(), out);
+}
+
+/// YAML Serializer function from T to yaml text in the fixed buffer [buf, buf + len), not null-terminated.
+/// Returns the size of the yaml text, which is greater than len if it didn't fit in the buffer
+/// (call again with a buffer of at least that size).
+template<typename T>
+auto to_buffer(T&& obj, char* buf, size_t len) -> cpp::result<size_t, serde::Error>
+{
+  auto ser = detail::SerializerNew();
+  ser->serialize(std::forward<T>(obj));
+  return detail::SerializerOutputBuffer(ser.get(), buf, len);
+}
+
 } // namespace serde_yaml
 
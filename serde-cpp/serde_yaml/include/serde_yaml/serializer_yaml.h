@@ -0,0 +1,343 @@
+#pragma once
+
+#include <algorithm>
+#include <stack>
+#include <string>
+#include <utility>
+#include <vector>
+#include <serde/ser.h>
+#include <serde/error.h>
+#include <serde/result.hpp>
+#include <serde/fmt/base64.h>
+
+#include <ryml_std.hpp>
+#include <ryml.hpp>
+#include <c4/format.hpp>
+
+#include "detail/number_yaml.h"
+
+#include "emit_options.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Serde YAML
+////////////////////////////////////////////////////////////////////////////////
+namespace serde_yaml {
+
+/// YAML Serializer
+///
+/// Builds a ryml::Tree from the Serializer calls and emits it as YAML text.
+/// It is a StaticSerializer, so serializing through a YamlSerializer& has
+/// all the serializer calls resolved at compile time (see to_string_static).
+///
+/// Sequences and maps can be emitted in flow style instead, see EmitOptions.
+///
+/// A YamlSerializer can be kept around and reused with reset(), which keeps
+/// the tree nodes, arena and stack capacity, so once warmed up serializing
+/// and emitting into the same output string does not allocate.
+class YamlSerializer final : public serde::StaticSerializer<YamlSerializer> {
+public:
+  YamlSerializer() {
+    stack.push({tree.rootref(), false});
+  }
+
+  explicit YamlSerializer(const EmitOptions& options) : YamlSerializer() {
+    this->options = options;
+  }
+
+  /// Emission options of the following serializations
+  void set_options(const EmitOptions& options) { this->options = options; }
+  const EmitOptions& get_options() const { return options; }
+
+  /// Drop the serialized data to serialize again, keeping the allocated capacity
+  void reset() {
+    tree.clear();
+    tree.clear_arena();
+    while (!stack.empty())
+      stack.pop();
+    stack.push({tree.rootref(), false});
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Serializer interface
+  //////////////////////////////////////////////////////////////////////////////
+
+  // Scalars ///////////////////////////////////////////////////////////////////
+  void serialize_bool(bool v) final { serialize_scalar(v); }
+  void serialize_i8(int8_t v) final { serialize_number(v); }
+  void serialize_u8(uint8_t v) final { serialize_number(v); }
+  void serialize_i16(int16_t v) final { serialize_number(v); }
+  void serialize_u16(uint16_t v) final { serialize_number(v); }
+  void serialize_i32(int32_t v) final { serialize_number(v); }
+  void serialize_u32(uint32_t v) final { serialize_number(v); }
+  void serialize_i64(int64_t v) final { serialize_number(v); }
+  void serialize_u64(uint64_t v) final { serialize_number(v); }
+  void serialize_float(float v) final { serialize_number(v); }
+  void serialize_double(double v) final { serialize_number(v); }
+  void serialize_char(char v) final { serialize_scalar(v); }
+  void serialize_uchar(unsigned char v) final { serialize_number(v); }
+  void serialize_str(const char* v, size_t len) final { serialize_scalar(ryml::csubstr(v, len)); }
+  void serialize_bytes(const void* val, size_t len) final {
+    scratch.clear();
+    serde::fmt::base64_encode(val, len, scratch);
+    serialize_scalar(ryml::csubstr(scratch.data(), scratch.size()));
+  }
+
+  // Optional //////////////////////////////////////////////////////////////////
+  void serialize_none() final { serialize_scalar("null"); }
+
+  // Sequence //////////////////////////////////////////////////////////////////
+  void serialize_seq_begin() final {
+    container_begin(ryml::SEQ);
+  }
+
+  void serialize_seq_end() final {
+    if (stack.top().node.is_seq())
+      container_end();
+  }
+
+  void serialize_seq_begin_sized(size_t len) final {
+    serialize_seq_begin();
+    reserve_nodes(len);
+  }
+
+  // Sequence of scalars ///////////////////////////////////////////////////////
+  void serialize_seq_bool(const bool* vals, size_t len) final { serialize_seq_scalars(vals, len); }
+  void serialize_seq_i8(const int8_t* vals, size_t len) final { serialize_seq_scalars(vals, len); }
+  void serialize_seq_u8(const uint8_t* vals, size_t len) final { serialize_seq_scalars(vals, len); }
+  void serialize_seq_i16(const int16_t* vals, size_t len) final { serialize_seq_scalars(vals, len); }
+  void serialize_seq_u16(const uint16_t* vals, size_t len) final { serialize_seq_scalars(vals, len); }
+  void serialize_seq_i32(const int32_t* vals, size_t len) final { serialize_seq_scalars(vals, len); }
+  void serialize_seq_u32(const uint32_t* vals, size_t len) final { serialize_seq_scalars(vals, len); }
+  void serialize_seq_i64(const int64_t* vals, size_t len) final { serialize_seq_scalars(vals, len); }
+  void serialize_seq_u64(const uint64_t* vals, size_t len) final { serialize_seq_scalars(vals, len); }
+  void serialize_seq_float(const float* vals, size_t len) final { serialize_seq_scalars(vals, len); }
+  void serialize_seq_double(const double* vals, size_t len) final { serialize_seq_scalars(vals, len); }
+  void serialize_seq_char(const char* vals, size_t len) final { serialize_seq_scalars(vals, len); }
+  void serialize_seq_uchar(const unsigned char* vals, size_t len) final { serialize_seq_scalars(vals, len); }
+
+  // Map ///////////////////////////////////////////////////////////////////////
+  void serialize_map_begin() final {
+    container_begin(ryml::MAP);
+  }
+
+  void serialize_map_end() final {
+    if (stack.top().node.is_map())
+      container_end();
+  }
+
+  void serialize_map_begin_sized(size_t len) final {
+    serialize_map_begin();
+    reserve_nodes(len);
+  }
+
+  void serialize_map_key_begin() final {
+    auto curr = stack.top().node;
+    curr.append_child();
+    stack.push({curr.last_child(), false});
+  }
+
+  void serialize_map_key_end() final {
+  }
+
+  void serialize_map_value_begin() final {
+  }
+
+  void serialize_map_value_end() final {
+    stack.pop();
+  }
+
+  // Struct ////////////////////////////////////////////////////////////////////
+  void serialize_struct_begin() final {
+    serialize_map_begin();
+  }
+  void serialize_struct_end() final {
+    serialize_map_end();
+  }
+
+  void serialize_struct_field_begin(const char* name) final {
+    serialize_map_key_begin();
+    serialize(name);
+    serialize_map_key_end();
+    serialize_map_value_begin();
+  }
+  void serialize_struct_field_end() final {
+    serialize_map_value_end();
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Serialization Utils
+  //////////////////////////////////////////////////////////////////////////////
+
+  template<typename T>
+  void serialize_scalar(T&& val) {
+    auto curr = stack.top().node;
+    if (curr.is_seq())
+      curr.append_child() << val;
+    else if (curr.has_parent() && curr.parent_is_map()) {
+      curr.is_seed();
+      if (!curr.has_key())
+        curr << ryml::key(val);
+      else if (!curr.has_val())
+        curr << val;
+      else {
+        curr.append_sibling() << ryml::key(val);
+        stack.push({curr.next_sibling(), false});
+      }
+    }
+    else {
+      curr << val;
+    }
+  }
+
+  template<typename T>
+  void serialize_number(T v) {
+    char buf[detail::number_max_chars];
+    char* end = detail::format_number(buf, buf + sizeof(buf), v, options.float_precision);
+    serialize_scalar(ryml::csubstr(buf, size_t(end - buf)));
+  }
+
+  // Text of the scalar v copied into the tree arena
+  template<typename T>
+  ryml::csubstr to_arena(const T& v) {
+    if constexpr (detail::is_number_v<T>) {
+      char buf[detail::number_max_chars];
+      char* end = detail::format_number(buf, buf + sizeof(buf), v, options.float_precision);
+      return tree.to_arena(ryml::csubstr(buf, size_t(end - buf)));
+    }
+    else {
+      return tree.to_arena(v);
+    }
+  }
+
+  // Make room in the tree for len more nodes, growing the capacity geometrically
+  // so many small sized containers do not reallocate the tree one after the other.
+  void reserve_nodes(size_t len) {
+    const size_t required = tree.size() + len;
+    if (required > tree.capacity())
+      tree.reserve(std::max(required, 2 * tree.capacity()));
+  }
+
+  // Append a whole block of scalars as a sequence, reserving the tree nodes
+  // up front and copying each value's text straight into the tree arena.
+  template<typename T>
+  void serialize_seq_scalars(const T* vals, size_t len) {
+    serialize_seq_begin_sized(len);
+    const size_t seq = stack.top().node.id();
+    for (size_t i = 0; i < len; i++) {
+      const size_t child = tree.append_child(seq);
+      tree.to_val(child, to_arena(vals[i]));
+    }
+    serialize_seq_end();
+  }
+
+  // A sequence or map in a sequence or map is a new child node, pushed until its end.
+  // Anywhere else (the root, the value of a map entry) the node on top becomes the container
+  // itself, it is left in the stack for its owner to pop (reset, serialize_map_value_end).
+  void container_begin(ryml::NodeType_e type) {
+    auto curr = stack.top().node;
+    if (curr.is_seq() || curr.is_map()) {
+      curr.append_child() |= type;
+      stack.push({curr.last_child(), true});
+    }
+    else {
+      curr |= type;
+    }
+  }
+
+  void container_end() {
+    auto& top = stack.top();
+    apply_style(top.node);
+    if (top.pushed)
+      stack.pop();
+  }
+
+  // Mark the container just completed for flow style emission if the options ask for it
+  void apply_style(ryml::NodeRef node) {
+    if (!options.flow_scalars && options.flow_min_depth == SIZE_MAX)
+      return;
+    const size_t id = node.id();
+    size_t size = 0;
+    bool scalars = true;
+    for (size_t child = tree.first_child(id); child != ryml::NONE; child = tree.next_sibling(child)) {
+      scalars = scalars && !tree.is_container(child);
+      size++;
+    }
+    if (size == 0)
+      return; // empty containers are emitted as [] / {} already
+    bool flow = options.flow_scalars && scalars && size <= options.flow_max_size;
+    if (!flow && options.flow_min_depth != SIZE_MAX) {
+      size_t depth = 0;
+      for (size_t parent = tree.parent(id); parent != ryml::NONE; parent = tree.parent(parent)) {
+        if (tree.is_container(parent))
+          depth++;
+      }
+      flow = depth >= options.flow_min_depth;
+    }
+    if (flow)
+      node |= ryml::_WIP_STYLE_FLOW_SL;
+  }
+
+  std::string emit() const {
+    return ryml::emitrs<std::string>(tree);
+  }
+
+  /// Emit into out, replacing its contents and reusing its capacity
+  void emit(std::string& out) const {
+    ryml::emitrs(tree, &out);
+  }
+
+  /// Emit appending to out (std::string or std::vector<char>).
+  /// Emits straight into the spare capacity of out, only when it doesn't fit
+  /// out is grown to the required size and emitted again.
+  template<typename Container>
+  void emit_append(Container& out) const {
+    const size_t pos = out.size();
+    out.resize(std::max(out.capacity(), pos + 1));
+    auto ret = ryml::emit(tree, ryml::substr(out.data() + pos, out.size() - pos), false);
+    if (ret.str == nullptr && ret.len > 0) {
+      out.resize(pos + ret.len);
+      ret = ryml::emit(tree, ryml::substr(out.data() + pos, ret.len), false);
+    }
+    out.resize(pos + ret.len);
+  }
+
+  /// Emit into the fixed buffer [buf, buf + len), returns the size of the yaml.
+  /// If the returned size is greater than len the yaml didn't fit, and buf contents are unspecified.
+  size_t emit(char* buf, size_t len) const {
+    return ryml::emit(tree, ryml::substr(buf, len), false).len;
+  }
+
+private:
+  // Node being serialized, pushed is set for the containers pushed by container_begin
+  struct Frame {
+    ryml::NodeRef node;
+    bool pushed;
+  };
+
+  EmitOptions options;
+  ryml::Tree tree;
+  std::stack<Frame, std::vector<Frame>> stack;
+  std::string scratch; // base64 text of serialize_bytes, copied into the tree arena
+};
+
+/// YAML Serializer function from T to yaml string, statically dispatched.
+/// Same output as to_string(), but the YamlSerializer calls are inlined into
+/// the serialization of T instead of going through the Serializer vtable.
+template<typename T>
+auto to_string_static(T&& obj) -> cpp::result<std::string, serde::Error>
+{
+  YamlSerializer ser;
+  ser.serialize(std::forward<T>(obj));
+  return ser.emit();
+}
+
+/// YAML Serializer function from T to yaml string with the given emission options, statically dispatched.
+template<typename T>
+auto to_string_static(T&& obj, const EmitOptions& options) -> cpp::result<std::string, serde::Error>
+{
+  YamlSerializer ser(options);
+  ser.serialize(std::forward<T>(obj));
+  return ser.emit();
+}
+
+} // namespace serde_yaml
@@ -0,0 +1,294 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+#include <serde/ser.h>
+#include <serde/error.h>
+#include <serde/result.hpp>
+#include <serde/fmt/base64.h>
+
+#include <ryml_std.hpp>
+#include <ryml.hpp>
+#include <c4/format.hpp>
+
+#include "detail/number_yaml.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Serde YAML
+////////////////////////////////////////////////////////////////////////////////
+namespace serde_yaml {
+
+/// YAML Stream Serializer
+///
+/// Writes the YAML text straight into an output string as the Serializer calls
+/// come in, without building a ryml::Tree first. The output is the same block
+/// style YAML emitted by YamlSerializer: same indentation, same empty container
+/// forms (`[]`, `{}`) and same scalar formatting and quoting, but it doesn't
+/// take EmitOptions.
+///
+/// The output string is owned by the caller and is appended to, so it can be
+/// reused (cleared) across messages to avoid allocating once warmed up.
+class YamlStreamSerializer final : public serde::StaticSerializer<YamlStreamSerializer> {
+public:
+  explicit YamlStreamSerializer(std::string& out) : out(&out) {
+    reset();
+  }
+
+  /// Serialize a new value, keeping the allocated capacity.
+  /// Anything already written to the output string is left there.
+  void reset() {
+    stack.clear();
+    stack.push_back(Frame{Kind::Root, 0, false, 0, Entry::Key});
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Serializer interface
+  //////////////////////////////////////////////////////////////////////////////
+
+  // Scalars ///////////////////////////////////////////////////////////////////
+  void serialize_bool(bool v) final { serialize_scalar(v); }
+  void serialize_i8(int8_t v) final { serialize_number(v); }
+  void serialize_u8(uint8_t v) final { serialize_number(v); }
+  void serialize_i16(int16_t v) final { serialize_number(v); }
+  void serialize_u16(uint16_t v) final { serialize_number(v); }
+  void serialize_i32(int32_t v) final { serialize_number(v); }
+  void serialize_u32(uint32_t v) final { serialize_number(v); }
+  void serialize_i64(int64_t v) final { serialize_number(v); }
+  void serialize_u64(uint64_t v) final { serialize_number(v); }
+  void serialize_float(float v) final { serialize_number(v); }
+  void serialize_double(double v) final { serialize_number(v); }
+  void serialize_char(char v) final { serialize_scalar(v); }
+  void serialize_uchar(unsigned char v) final { serialize_number(v); }
+  void serialize_str(const char* v, size_t len) final { write_scalar(ryml::csubstr(v, len)); }
+  void serialize_bytes(const void* val, size_t len) final {
+    scratch.clear();
+    serde::fmt::base64_encode(val, len, scratch);
+    write_scalar(ryml::csubstr(scratch.data(), scratch.size()));
+  }
+
+  // Optional //////////////////////////////////////////////////////////////////
+  void serialize_none() final { write_scalar("null"); }
+
+  // Sequence //////////////////////////////////////////////////////////////////
+  void serialize_seq_begin() final { container_begin(Kind::Seq); }
+  void serialize_seq_end() final { container_end(Kind::Seq); }
+
+  // Map ///////////////////////////////////////////////////////////////////////
+  void serialize_map_begin() final { container_begin(Kind::Map); }
+  void serialize_map_end() final { container_end(Kind::Map); }
+
+  void serialize_map_key_begin() final {
+    Frame& top = stack.back();
+    if (top.kind != Kind::Map)
+      return;
+    child_begin(top);
+    top.entry = Entry::Key;
+  }
+
+  void serialize_map_key_end() final {
+  }
+
+  void serialize_map_value_begin() final {
+  }
+
+  void serialize_map_value_end() final {
+    Frame& top = stack.back();
+    if (top.kind == Kind::Map)
+      top.entry = Entry::Key;
+  }
+
+  // Struct ////////////////////////////////////////////////////////////////////
+  void serialize_struct_begin() final {
+    serialize_map_begin();
+  }
+  void serialize_struct_end() final {
+    serialize_map_end();
+  }
+
+  void serialize_struct_field_begin(const char* name) final {
+    serialize_map_key_begin();
+    serialize(name);
+    serialize_map_key_end();
+    serialize_map_value_begin();
+  }
+  void serialize_struct_field_end() final {
+    serialize_map_value_end();
+  }
+
+private:
+  enum class Kind : uint8_t { Root, Seq, Map };
+  // Next scalar of a map entry: the key, or its value after the key
+  enum class Entry : uint8_t { Key, Value };
+
+  struct Frame {
+    Kind kind;
+    size_t level;      // indentation level of the children
+    bool first_inline; // first child goes on the parent's "- " line
+    size_t count;      // children written so far
+    Entry entry;
+    // Held back until knowing if the container is empty: "[]"/"{}" or the children
+    const char* header = "";
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Serialization Utils
+  //////////////////////////////////////////////////////////////////////////////
+
+  template<typename T>
+  void serialize_number(T v) {
+    char buf[detail::number_max_chars];
+    char* end = detail::format_number(buf, buf + sizeof(buf), v);
+    write_scalar(ryml::csubstr(buf, size_t(end - buf)));
+  }
+
+  template<typename T>
+  void serialize_scalar(const T& val) {
+    char buf[64];
+    size_t len = ryml::to_chars(ryml::substr(buf, sizeof(buf)), val);
+    if (len <= sizeof(buf)) {
+      write_scalar(ryml::csubstr(buf, len));
+      return;
+    }
+    scratch.resize(len);
+    len = ryml::to_chars(ryml::substr(&scratch[0], len), val);
+    write_scalar(ryml::csubstr(scratch.data(), len));
+  }
+
+  void write_scalar(ryml::csubstr s) {
+    Frame& top = stack.back();
+    switch (top.kind) {
+      case Kind::Root:
+        write_text(s, 0);
+        out->push_back('\n');
+        break;
+      case Kind::Seq:
+        child_begin(top);
+        out->append("- ", 2);
+        write_text(s, top.level);
+        out->push_back('\n');
+        break;
+      case Kind::Map:
+        if (top.entry == Entry::Key) {
+          write_text(s, top.level);
+          out->push_back(':');
+          top.entry = Entry::Value;
+        }
+        else {
+          out->push_back(' ');
+          write_text(s, top.level);
+          out->push_back('\n');
+          top.entry = Entry::Key;
+        }
+        break;
+    }
+  }
+
+  void container_begin(Kind kind) {
+    Frame& top = stack.back();
+    if (top.kind == Kind::Root && top.count == 0) {
+      // the root node itself becomes the container, its children are not indented
+      top.kind = kind;
+      return;
+    }
+    const size_t level = top.level + 1;
+    if (top.kind == Kind::Seq) {
+      child_begin(top);
+      out->push_back('-');
+      stack.push_back(Frame{kind, level, true, 0, Entry::Key, " "});
+    }
+    else {
+      // value of a map entry, "key:" was already written
+      stack.push_back(Frame{kind, level, false, 0, Entry::Key, "\n"});
+    }
+  }
+
+  void container_end(Kind kind) {
+    Frame& top = stack.back();
+    if (top.kind != kind)
+      return;
+    if (top.count == 0)
+      out->append(kind == Kind::Seq ? " []\n" : " {}\n");
+    if (stack.size() > 1)
+      stack.pop_back();
+    else
+      top.count = 1; // root done
+  }
+
+  // Start a new child line of the container: flush the held back header and indent.
+  void child_begin(Frame& frame) {
+    if (frame.count == 0)
+      out->append(frame.header);
+    if (frame.count > 0 || !frame.first_inline)
+      out->append(2 * frame.level, ' ');
+    frame.count++;
+  }
+
+  // Write a scalar plain or quoted, with the same rules as the ryml emitter.
+  void write_text(ryml::csubstr s, size_t level) {
+    if (s.len == 0)
+      return;
+    const bool needs_quotes = !s.is_number() &&
+      (s.begins_with_any(" \n\t\r*&%@`") || s.begins_with("<<") || s.ends_with_any(" \n\t\r") ||
+       s.first_of("#:-?,\n{}[]'\"") != ryml::npos);
+    if (!needs_quotes) {
+      out->append(s.str, s.len);
+      return;
+    }
+    const bool has_dquotes = s.first_of('"') != ryml::npos;
+    const bool has_squotes = s.first_of('\'') != ryml::npos;
+    if (!has_squotes && has_dquotes) {
+      out->push_back('\'');
+      out->append(s.str, s.len);
+      out->push_back('\'');
+    }
+    else if (has_squotes && !has_dquotes) {
+      out->push_back('"');
+      out->append(s.str, s.len);
+      out->push_back('"');
+    }
+    else {
+      // single quoted, with quotes and line breaks doubled
+      out->push_back('\'');
+      size_t pos = 0;
+      for (size_t i = 0; i < s.len; i++) {
+        if (s.str[i] != '\'' && s.str[i] != '\n')
+          continue;
+        out->append(s.str + pos, i + 1 - pos);
+        out->push_back(s.str[i]);
+        if (s.str[i] == '\n' && i + 1 < s.len)
+          out->append(2 * (level + 1), ' ');
+        pos = i + 1;
+      }
+      out->append(s.str + pos, s.len - pos);
+      out->push_back('\'');
+    }
+  }
+
+  std::string* out;
+  std::vector<Frame> stack;
+  std::string scratch;
+};
+
+/// YAML Serializer function from T to yaml string, writing the yaml text directly
+/// without building a ryml::Tree. Same output as to_string().
+template<typename T>
+auto to_string_stream(T&& obj) -> cpp::result<std::string, serde::Error>
+{
+  std::string out;
+  YamlStreamSerializer ser(out);
+  ser.serialize(std::forward<T>(obj));
+  return out;
+}
+
+/// YAML Serializer function from T to yaml string, writing the yaml text directly
+/// appended to out without building a ryml::Tree.
+template<typename T>
+auto to_string_stream(T&& obj, std::string& out) -> cpp::result<void, serde::Error>
+{
+  YamlStreamSerializer ser(out);
+  ser.serialize(std::forward<T>(obj));
+  return {};
+}
+
+} // namespace serde_yaml
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <serde/ser.h>
+#include <serde/error.h>
+#include <serde/result.hpp>
+
+#include "stream_serializer_yaml.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Serde YAML
+////////////////////////////////////////////////////////////////////////////////
+namespace serde_yaml {
+
+/// YAML Document Writer
+///
+/// Appends values as the "---" separated documents of a YAML stream to an
+/// output std::ostream or std::string, to be read back with YamlDocReader.
+/// Each document is written directly with a YamlStreamSerializer which is reused,
+/// so writing many documents does not allocate once warmed up.
+///
+///   std::ofstream file("snapshots.yaml", std::ios::app);
+///   serde_yaml::YamlDocWriter writer(file);
+///   writer.write(snapshot).value();
+class YamlDocWriter {
+public:
+  explicit YamlDocWriter(std::ostream& out) : stream(&out), out(&buffer), ser(buffer) {}
+  explicit YamlDocWriter(std::string& out) : out(&out), ser(out) {}
+
+  // out and ser may point into the writer's own buffer, which a copy or move would leave behind
+  YamlDocWriter(const YamlDocWriter&) = delete;
+  YamlDocWriter& operator=(const YamlDocWriter&) = delete;
+
+  /// Append val as the next document of the stream
+  template<typename T>
+  auto write(const T& val) -> cpp::result<void, serde::Error> {
+    if (stream)
+      buffer.clear();
+    out->append("---\n");
+    ser.reset();
+    ser.serialize(val);
+    if (stream) {
+      stream->write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+      if (!*stream)
+        return cpp::fail(serde::Error{serde::Error::Kind::Invalid, 0, 0, "failed to write the document"});
+    }
+    return {};
+  }
+
+private:
+  std::ostream* stream = nullptr;
+  std::string buffer; // document being written to the stream
+  std::string* out;
+  YamlStreamSerializer ser;
+};
+
+} // namespace serde_yaml
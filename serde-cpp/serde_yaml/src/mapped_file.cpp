@@ -0,0 +1,75 @@
+#include "serde_yaml/detail/mapped_file.h"
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Serde YAML
+////////////////////////////////////////////////////////////////////////////////
+namespace serde_yaml {
+
+namespace detail {
+
+static auto SystemError(const char* what) -> serde::Error
+{
+  return {serde::Error::Kind::Invalid, 0, 0, std::string(what) + ": " + std::strerror(errno)};
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+  if (this != &other) {
+    if (ptr)
+      ::munmap(ptr, len);
+    ptr = other.ptr;
+    len = other.len;
+    other.ptr = nullptr;
+    other.len = 0;
+  }
+  return *this;
+}
+
+MappedFile::~MappedFile()
+{
+  if (ptr)
+    ::munmap(ptr, len);
+}
+
+auto MappedFile::map(int fd) -> cpp::result<MappedFile, serde::Error>
+{
+  struct stat st;
+  if (::fstat(fd, &st) != 0)
+    return cpp::fail(SystemError("failed to stat file"));
+  // pipes, sockets and ttys can't be mapped, and report a size of 0 which would read as empty
+  if (!S_ISREG(st.st_mode))
+    return cpp::fail(serde::Error{serde::Error::Kind::Invalid, 0, 0, "not a regular file"});
+  MappedFile file;
+  if (st.st_size == 0)
+    return std::move(file); // nothing to map, empty document
+  void* ptr = ::mmap(nullptr, size_t(st.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  if (ptr == MAP_FAILED)
+    return cpp::fail(SystemError("failed to map file"));
+  // the parser reads the text front to back
+  ::madvise(ptr, size_t(st.st_size), MADV_SEQUENTIAL);
+  file.ptr = static_cast<char*>(ptr);
+  file.len = size_t(st.st_size);
+  return std::move(file);
+}
+
+auto MappedFile::open(const char* path) -> cpp::result<MappedFile, serde::Error>
+{
+  const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return cpp::fail(SystemError("failed to open file"));
+  auto file = map(fd);
+  ::close(fd);
+  return file;
+}
+
+} // namespace detail
+
+} // namespace serde_yaml
@@ -1,8 +1,12 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 #include "serde/std.h"
 #include "serde/serde.h"
 #include "serde_yaml/serde_yaml.h"
+#include "serde_yaml/serializer_yaml.h"
+#include "serde_yaml/deserializer_yaml.h"
 
 #include "types.h"
 
@@ -200,7 +204,7 @@ struct Deserialize<T, std::enable_if_t<std::is_same_v<T, Egg>>> {
     std::string_view str(cstr);
     if (str == "Yolk") val = T::Yolk;
     else if (str == "Whites") val = T::Whites;
-    else return; // TODO: mark error
+    else de.set_error({serde::Error::Kind::Invalid, 0, 0, "unknown Egg"});
   }
 };
 } // namespace serde
@@ -220,3 +224,309 @@ TEST(Advanced, Egg)
   EXPECT_EQ(egg, de);
 }
 
+
+///////////////////////////////////////////////////////////////////////////////
+// Statically dispatched serializer
+///////////////////////////////////////////////////////////////////////////////
+
+struct Baz {
+  int v;
+  std::vector<std::string> names;
+  std::map<std::string, Egg> eggs;
+};
+
+namespace serde {
+// Serialize specialization templated on the serializer type, like serde_gen output
+template<typename T>
+struct Serialize<T, std::enable_if_t<std::is_same_v<T, Baz>>> {
+  template<typename S>
+  static void serialize(S& ser, const T& val) {
+    ser.serialize_struct_begin();
+    ser.serialize_struct_field("v", val.v);
+    ser.serialize_struct_field("names", val.names);
+    ser.serialize_struct_field("eggs", val.eggs);
+    ser.serialize_struct_end();
+  }
+};
+// Deserialize specialization templated on the deserializer type, like serde_gen output
+template<typename T>
+struct Deserialize<T, std::enable_if_t<std::is_same_v<T, Baz>>> {
+  template<typename D>
+  static void deserialize(D& de, T& val) {
+    de.deserialize_struct_begin();
+    de.deserialize_struct_field("v", val.v);
+    de.deserialize_struct_field("names", val.names);
+    de.deserialize_struct_field("eggs", val.eggs);
+    de.deserialize_struct_end();
+  }
+};
+} // namespace serde
+
+TEST(Advanced, StaticDispatch)
+{
+  Baz baz{7, {"a", "b"}, {{"first", Egg::Yolk}, {"second", Egg::Whites}}};
+  auto str = serde_yaml::to_string_static(baz).value();
+  EXPECT_STREQ(str.c_str(), "v: 7\nnames:\n  - a\n  - b\neggs:\n  first: Yolk\n  second: Whites\n");
+  EXPECT_EQ(str, serde_yaml::to_string(baz).value());
+
+  // types implemented only for serde::Serializer& go through the virtual path
+  types::Point point{ 10, 20 };
+  EXPECT_EQ(serde_yaml::to_string_static(point).value(), serde_yaml::to_string(point).value());
+  EXPECT_EQ(serde_yaml::to_string_static(Bar{}).value(), "5\n");
+}
+
+TEST(Advanced, StaticDispatchDeserialize)
+{
+  auto baz = serde_yaml::from_str_static<Baz>("v: 7\nnames: [a, b]\neggs: {first: Yolk, second: Whites}\n").value();
+  EXPECT_EQ(baz.v, 7);
+  EXPECT_EQ(baz.names, (std::vector<std::string>{"a", "b"}));
+  EXPECT_EQ(baz.eggs, (std::map<std::string, Egg>{{"first", Egg::Yolk}, {"second", Egg::Whites}}));
+
+  // types implemented only for serde::Deserializer& go through the virtual path
+  EXPECT_EQ(serde_yaml::from_str_static<Bar>("5").value().v, 5);
+  EXPECT_EQ(serde_yaml::from_str_static<Foo<int>>("4").value().v, 4);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Struct field lookup order
+///////////////////////////////////////////////////////////////////////////////
+
+template<size_t N>
+struct Wide {
+  int f[N] = {};
+  static const char* name(size_t i) {
+    static const auto names = [] {
+      std::array<std::string, N> names;
+      for (size_t i = 0; i < N; i++)
+        names[i] = "f" + std::to_string(i);
+      return names;
+    }();
+    return names[i].c_str();
+  }
+  template<typename D>
+  void deserialize(D& de) {
+    de.deserialize_struct_begin();
+    for (size_t i = 0; i < N; i++)
+      de.deserialize_struct_field(name(i), f[i]);
+    de.deserialize_struct_end();
+  }
+  static std::string yaml(bool reverse) {
+    std::string str = "{";
+    for (size_t i = 0; i < N; i++) {
+      size_t k = reverse ? N - 1 - i : i;
+      str += std::string(i ? ", " : "") + name(k) + ": " + std::to_string(k * 10);
+    }
+    return str + "}";
+  }
+};
+
+template<size_t N>
+void expect_wide(const Wide<N>& wide) {
+  for (size_t i = 0; i < N; i++)
+    EXPECT_EQ(wide.f[i], static_cast<int>(i * 10)) << Wide<N>::name(i);
+}
+
+TEST(Advanced, StructFieldsInOrder)
+{
+  expect_wide(serde_yaml::from_str<Wide<4>>(Wide<4>::yaml(false)).value());
+  expect_wide(serde_yaml::from_str<Wide<40>>(Wide<40>::yaml(false)).value());
+}
+
+TEST(Advanced, StructFieldsOutOfOrder)
+{
+  expect_wide(serde_yaml::from_str<Wide<4>>(Wide<4>::yaml(true)).value());
+  expect_wide(serde_yaml::from_str<Wide<40>>(Wide<40>::yaml(true)).value());
+  // the key index of a map is reused for the next one
+  auto wides = serde_yaml::from_str_static<std::vector<Wide<40>>>(
+      "[" + Wide<40>::yaml(true) + ", " + Wide<40>::yaml(false) + ", " + Wide<40>::yaml(true) + "]").value();
+  ASSERT_EQ(wides.size(), 3u);
+  for (auto& wide : wides)
+    expect_wide(wide);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Reusable serializer/deserializer
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Advanced, SerializerReset)
+{
+  serde_yaml::YamlSerializer ser;
+  std::string out;
+  for (int i = 0; i < 3; i++) {
+    ser.reset();
+    Baz baz{i, {"a", std::to_string(i)}, {{"first", Egg::Yolk}}};
+    ser.serialize(baz);
+    ser.emit(out);
+    EXPECT_EQ(out, serde_yaml::to_string(baz).value());
+  }
+}
+
+TEST(Advanced, DeserializerReset)
+{
+  serde_yaml::YamlDeserializer de;
+  for (int i = 0; i < 3; i++) {
+    de.reset("v: " + std::to_string(i) + "\nnames: [a, b]\neggs: {first: Yolk}\n");
+    de.parse();
+    Baz baz{};
+    de.deserialize(baz);
+    ASSERT_FALSE(de.has_error());
+    EXPECT_EQ(baz.v, i);
+    EXPECT_EQ(baz.names, (std::vector<std::string>{"a", "b"}));
+  }
+  // an error does not stick after reset
+  de.reset("[1, 2]");
+  de.parse();
+  Baz baz{};
+  de.deserialize(baz);
+  EXPECT_TRUE(de.has_error());
+  de.reset("v: 3\nnames: []\neggs: {}\n");
+  de.parse();
+  de.deserialize(baz);
+  EXPECT_FALSE(de.has_error());
+  EXPECT_EQ(baz.v, 3);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Output into caller buffers
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Advanced, OutputAppend)
+{
+  Baz baz{7, {"a", "b"}, {{"first", Egg::Yolk}}};
+  const std::string yaml = serde_yaml::to_string(baz).value();
+
+  std::string str = "# header\n";
+  ASSERT_FALSE(serde_yaml::to_string(baz, str).has_error());
+  EXPECT_EQ(str, "# header\n" + yaml);
+  ASSERT_FALSE(serde_yaml::to_string(baz, str).has_error());
+  EXPECT_EQ(str, "# header\n" + yaml + yaml);
+
+  std::vector<char> vec = {'-', '-', '-', '\n'};
+  ASSERT_FALSE(serde_yaml::to_buffer(baz, vec).has_error());
+  EXPECT_EQ(std::string(vec.begin(), vec.end()), "---\n" + yaml);
+}
+
+TEST(Advanced, OutputFixedBuffer)
+{
+  Baz baz{7, {"a", "b"}, {{"first", Egg::Yolk}}};
+  const std::string yaml = serde_yaml::to_string(baz).value();
+
+  char small[8];
+  size_t size = serde_yaml::to_buffer(baz, small, sizeof(small)).value();
+  EXPECT_EQ(size, yaml.size());
+
+  std::vector<char> buf(size);
+  size = serde_yaml::to_buffer(baz, buf.data(), buf.size()).value();
+  EXPECT_EQ(size, yaml.size());
+  EXPECT_EQ(std::string(buf.data(), size), yaml);
+}
+
+TEST(Advanced, FromStrView)
+{
+  // e.g. a message payload in a receive buffer
+  const char buffer[] = "v: 7\nnames: [a, b]\neggs: {first: Yolk}\n--- trailing bytes";
+  const std::string_view payload(buffer, sizeof(buffer) - sizeof("--- trailing bytes"));
+  for (int i = 0; i < 3; i++) {
+    auto baz = serde_yaml::from_str<Baz>(payload).value();
+    EXPECT_EQ(baz.v, 7);
+    EXPECT_EQ(baz.names, (std::vector<std::string>{"a", "b"}));
+    EXPECT_EQ(baz.eggs, (std::map<std::string, Egg>{{"first", Egg::Yolk}}));
+  }
+  // the input is left untouched
+  EXPECT_EQ(payload, "v: 7\nnames: [a, b]\neggs: {first: Yolk}\n");
+
+  const std::string yaml = "[1, 2, 3]";
+  EXPECT_EQ(serde_yaml::from_str<std::vector<int>>(yaml).value(), (std::vector<int>{1, 2, 3}));
+  EXPECT_EQ(serde_yaml::from_str<std::vector<int>>("[4]").value(), (std::vector<int>{4}));
+  EXPECT_TRUE(serde_yaml::from_str<std::vector<int>>(std::string_view("[x]")).has_error());
+}
+
+TEST(Advanced, FromStrView_Reused)
+{
+  const std::string_view payload = "v: 7\nnames: [a, b]\neggs: {first: Yolk}\n";
+  serde_yaml::YamlDeserializer de;
+  for (int i = 0; i < 3; i++) {
+    auto baz = serde_yaml::from_str<Baz>(de, payload).value();
+    EXPECT_EQ(baz.v, 7);
+    EXPECT_EQ(baz.names, (std::vector<std::string>{"a", "b"}));
+    EXPECT_EQ(baz.eggs, (std::map<std::string, Egg>{{"first", Egg::Yolk}}));
+  }
+  EXPECT_TRUE(serde_yaml::from_str<Baz>(de, "[1, 2]").has_error());
+
+  // once warmed up every message is copied into the same buffer of the deserializer,
+  // borrowed strings point into it and not into the input
+  const std::string_view text = "Hello";
+  const char* buffer = serde_yaml::from_str<std::string_view>(de, text).value().data();
+  EXPECT_NE(buffer, text.data());
+  for (int i = 0; i < 3; i++) {
+    auto view = serde_yaml::from_str<std::string_view>(de, text).value();
+    EXPECT_EQ(view, text);
+    EXPECT_EQ(view.data(), buffer);
+  }
+}
+
+// Deserializes a yaml string field with a nested from_str() call
+struct Embedded {
+  std::vector<int> inner;
+  int after = 0;
+
+  void deserialize(serde::Deserializer& de) {
+    std::string text;
+    de.deserialize_struct_begin();
+    de.deserialize_struct_field("text", text);
+    inner = serde_yaml::from_str<std::vector<int>>(std::string_view(text)).value();
+    de.deserialize_struct_field("after", after);
+    de.deserialize_struct_end();
+  }
+};
+
+TEST(Advanced, FromStrView_Nested)
+{
+  // the nested call must not clobber the outer parse
+  const std::string_view yaml = "text: '[1, 2]'\nafter: 3\n";
+  auto val = serde_yaml::from_str<Embedded>(yaml).value();
+  EXPECT_EQ(val.inner, (std::vector<int>{1, 2}));
+  EXPECT_EQ(val.after, 3);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Emission options
+///////////////////////////////////////////////////////////////////////////////
+
+TEST(Advanced, EmitFlowScalars)
+{
+  std::vector<int> vec(1000);
+  for (size_t i = 0; i < vec.size(); i++)
+    vec[i] = int(i);
+  auto block = serde_yaml::to_string(vec).value();
+  auto flow = serde_yaml::to_string(vec, serde_yaml::EmitOptions::flow()).value();
+  EXPECT_LT(flow.size(), block.size());
+  EXPECT_LE(std::count(flow.begin(), flow.end(), '\n'), 1);
+  EXPECT_EQ(serde_yaml::from_str<std::vector<int>>(std::move(flow)).value(), vec);
+
+  Baz baz{7, {"a", "b"}, {{"first", Egg::Yolk}, {"second", Egg::Whites}}};
+  auto str = serde_yaml::to_string_static(baz, serde_yaml::EmitOptions::flow()).value();
+  // the struct holds containers, only the names and eggs go flow
+  EXPECT_EQ(std::count(str.begin(), str.end(), '\n'), 3);
+  auto de_baz = serde_yaml::from_str<Baz>(std::move(str)).value();
+  EXPECT_EQ(de_baz.v, baz.v);
+  EXPECT_EQ(de_baz.names, baz.names);
+  EXPECT_EQ(de_baz.eggs, baz.eggs);
+}
+
+TEST(Advanced, EmitFlowAuto)
+{
+  using Type = std::vector<std::vector<int>>;
+  const Type val = {{1, 2}, {}, {3, 4, 5, 6, 7, 8}};
+  // only the first one is small enough, the empty one stays as it is
+  auto str = serde_yaml::to_string(val, serde_yaml::EmitOptions::flow_auto(4)).value();
+  EXPECT_EQ(std::count(str.begin(), str.end(), '\n'), 2 + 6);
+  EXPECT_EQ(serde_yaml::from_str<Type>(std::move(str)).value(), val);
+
+  // everything below the top level sequence, whatever its size
+  using Nested = std::vector<std::map<std::string, std::vector<int>>>;
+  const Nested nested = {{{"a", {1, 2}}, {"b", {3}}}, {{"c", {4, 5, 6, 7, 8}}}};
+  str = serde_yaml::to_string(nested, serde_yaml::EmitOptions::flow_auto(0, 1)).value();
+  EXPECT_EQ(std::count(str.begin(), str.end(), '\n'), 2);
+  EXPECT_EQ(serde_yaml::from_str<Nested>(std::move(str)).value(), nested);
+}
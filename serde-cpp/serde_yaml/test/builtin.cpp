@@ -1,7 +1,13 @@
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <limits>
+
+#include "serde/std.h"
+#include "serde/fmt/base64.h"
 #include "serde/serde.h"
 #include "serde_yaml/serde_yaml.h"
+#include "serde_yaml/stream_serializer_yaml.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 // Builtin types
@@ -153,6 +159,80 @@ TEST(Builtin, Double)
   EXPECT_DOUBLE_EQ(de_val, val);
 }
 
+TEST(Builtin, Double_ShortestRoundTrip)
+{
+  for (double val : {0.1, 1.0 / 3.0, 2.0 / 3.0, 1e-7, 123456789.125, 1e300, 5e-324}) {
+    auto str = serde_yaml::to_string(val).value();
+    auto de_val = serde_yaml::from_str<double>(std::string(str)).value();
+    EXPECT_EQ(de_val, val) << str;
+  }
+  EXPECT_EQ(serde_yaml::to_string(0.1).value(), "0.1\n");
+  EXPECT_EQ(serde_yaml::to_string(0.1f).value(), "0.1\n");
+  EXPECT_EQ(serde_yaml::to_string(100.0).value(), "100\n");
+}
+
+TEST(Builtin, Double_NonFinite)
+{
+  EXPECT_EQ(serde_yaml::to_string(std::numeric_limits<double>::infinity()).value(), ".inf\n");
+  // not a plain number for ryml, so it is quoted, and still reads back as a float
+  EXPECT_EQ(serde_yaml::to_string(-std::numeric_limits<double>::infinity()).value(), "'-.inf'\n");
+  EXPECT_EQ(serde_yaml::to_string(std::numeric_limits<float>::quiet_NaN()).value(), ".nan\n");
+}
+
+TEST(Builtin, Double_FixedPrecision)
+{
+  serde_yaml::EmitOptions options;
+  options.float_precision = 2;
+  EXPECT_EQ(serde_yaml::to_string(3.14159, options).value(), "3.14\n");
+  EXPECT_EQ(serde_yaml::to_string(100.0f, options).value(), "100.00\n");
+  EXPECT_EQ(serde_yaml::to_string(std::vector<double>{0.125, -2.5}, options).value(), "- 0.12\n- -2.50\n");
+  // integers are not affected
+  EXPECT_EQ(serde_yaml::to_string(42, options).value(), "42\n");
+}
+
+TEST(Builtin, Int_Limits)
+{
+  EXPECT_EQ(serde_yaml::to_string(std::numeric_limits<int64_t>::min()).value(), "-9223372036854775808\n");
+  EXPECT_EQ(serde_yaml::to_string(std::numeric_limits<uint64_t>::max()).value(), "18446744073709551615\n");
+  EXPECT_EQ(serde_yaml::to_string(std::numeric_limits<int16_t>::min()).value(), "-32768\n");
+  EXPECT_EQ(serde_yaml::to_string(0).value(), "0\n");
+  EXPECT_EQ(serde_yaml::to_string(std::vector<int16_t>{-7, 10, 99, 100, 32767}).value(), "- -7\n- 10\n- 99\n- 100\n- 32767\n");
+}
+
+TEST(Builtin, Int_Parse)
+{
+  EXPECT_EQ(serde_yaml::from_str<int64_t>("-9223372036854775808").value(), std::numeric_limits<int64_t>::min());
+  EXPECT_EQ(serde_yaml::from_str<uint64_t>("18446744073709551615").value(), std::numeric_limits<uint64_t>::max());
+  EXPECT_EQ(serde_yaml::from_str<int16_t>("-32768").value(), -32768);
+  EXPECT_EQ(serde_yaml::from_str<int>("+42").value(), 42);
+  EXPECT_EQ(serde_yaml::from_str<int>("0x1F").value(), 31);
+  EXPECT_EQ(serde_yaml::from_str<int>("-0x10").value(), -16);
+  EXPECT_EQ(serde_yaml::from_str<int>("0o17").value(), 15);
+  EXPECT_EQ(serde_yaml::from_str<int>("0b101").value(), 5);
+  EXPECT_EQ(serde_yaml::from_str<uint32_t>("0xFFFFFFFF").value(), 0xFFFFFFFFu);
+  EXPECT_EQ(serde_yaml::from_str<std::vector<uint16_t>>("[0x10, 010, 0b11]").value(), (std::vector<uint16_t>{16, 10, 3}));
+}
+
+TEST(Builtin, Double_Parse)
+{
+  EXPECT_EQ(serde_yaml::from_str<double>("1.5e-7").value(), 1.5e-7);
+  EXPECT_EQ(serde_yaml::from_str<double>("-.5").value(), -0.5);
+  EXPECT_EQ(serde_yaml::from_str<double>("1e23").value(), 1e23);
+  EXPECT_EQ(serde_yaml::from_str<double>("2.2250738585072011e-308").value(), 2.2250738585072011e-308);
+  EXPECT_EQ(serde_yaml::from_str<double>("9007199254740993").value(), 9007199254740992.0); // ties to even
+  EXPECT_EQ(serde_yaml::from_str<double>("3.14159265358979323846264338327950288").value(), 3.14159265358979323846);
+  EXPECT_EQ(serde_yaml::from_str<float>("3.4028235e38").value(), std::numeric_limits<float>::max());
+  EXPECT_EQ(serde_yaml::from_str<float>("1e-50").value(), 0.0f);
+  EXPECT_TRUE(std::signbit(serde_yaml::from_str<double>("-0.0").value()));
+
+  EXPECT_EQ(serde_yaml::from_str<double>(".inf").value(), std::numeric_limits<double>::infinity());
+  EXPECT_EQ(serde_yaml::from_str<double>("-.Inf").value(), -std::numeric_limits<double>::infinity());
+  EXPECT_TRUE(std::isnan(serde_yaml::from_str<float>(".NaN").value()));
+  for (double val : {std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()})
+    EXPECT_EQ(serde_yaml::from_str<double>(serde_yaml::to_string(val).value()).value(), val);
+  EXPECT_TRUE(std::isnan(serde_yaml::from_str<double>(serde_yaml::to_string(std::nan("")).value()).value()));
+}
+
 TEST(Builtin, Char)
 {
   char val = 'A';
@@ -222,3 +302,71 @@ TEST(Builtin, Bytes) // base64 encoded
   auto de_val = serde_yaml::from_str<Struct>(std::move(str)).value();
   EXPECT_TRUE(0 == memcmp(val.val, de_val.val, sizeof(Struct::val)));
 }
+
+namespace {
+template<size_t N>
+struct Blob {
+  uint8_t val[N] = {};
+  void serialize(serde::Serializer& ser) const { ser.serialize_bytes(val, sizeof(val)); }
+  void deserialize(serde::Deserializer& de) { de.deserialize_bytes(val, sizeof(val)); }
+};
+
+template<size_t N>
+void expect_blob_roundtrip() {
+  Blob<N> val;
+  for (size_t i = 0; i < N; i++)
+    val.val[i] = static_cast<uint8_t>(i * 37 + 11);
+  auto str = serde_yaml::to_string(val).value();
+  EXPECT_EQ(str.size(), serde::fmt::base64_encoded_size(N) + 1) << N;
+  EXPECT_EQ(serde_yaml::to_string_stream(val).value(), str) << N;
+  auto de_val = serde_yaml::from_str<Blob<N>>(std::move(str)).value();
+  EXPECT_TRUE(0 == memcmp(val.val, de_val.val, N)) << N;
+}
+} // namespace
+
+TEST(Builtin, Bytes_Lengths) // whole SIMD blocks and the scalar tails
+{
+  expect_blob_roundtrip<1>();
+  expect_blob_roundtrip<2>();
+  expect_blob_roundtrip<3>();
+  expect_blob_roundtrip<12>();
+  expect_blob_roundtrip<28>();
+  expect_blob_roundtrip<100>();
+  expect_blob_roundtrip<1000>();
+  EXPECT_EQ(serde_yaml::to_string(Blob<6>{{'f', 'o', 'o', 'b', 'a', 'r'}}).value(), "Zm9vYmFy\n");
+  // unpadded
+  auto de_val = serde_yaml::from_str<Blob<5>>("Zm9vYmE").value();
+  EXPECT_TRUE(0 == memcmp(de_val.val, "fooba", 5));
+}
+
+TEST(Builtin, Bytes_ShortContents) // the bytes after the decoded ones are left untouched
+{
+  for (size_t n : {3u, 12u, 24u, 48u, 75u}) {
+    std::vector<uint8_t> data(n);
+    for (size_t i = 0; i < n; i++)
+      data[i] = static_cast<uint8_t>(i * 13 + 1);
+    std::string text;
+    serde::fmt::base64_encode(data.data(), n, text);
+    uint8_t out[100];
+    memset(out, 0xAA, sizeof(out));
+    const uint8_t* end = serde::fmt::base64_decode(text.data(), text.data() + text.size(), out, out + sizeof(out));
+    ASSERT_EQ(end, out + n) << n;
+    EXPECT_TRUE(0 == memcmp(out, data.data(), n)) << n;
+    for (size_t i = n; i < sizeof(out); i++)
+      ASSERT_EQ(out[i], 0xAA) << n << " " << i;
+  }
+}
+
+TEST(Builtin, Bytes_DecodeEmpty)
+{
+  const char text[] = "";
+  std::vector<uint8_t> out;
+  EXPECT_TRUE(serde::fmt::base64_decode(text, text, out));
+  EXPECT_TRUE(out.empty());
+  out = {1, 2};
+  EXPECT_TRUE(serde::fmt::base64_decode(text, text, out));
+  EXPECT_EQ(out, (std::vector<uint8_t>{1, 2}));
+  const char one[] = "Z";
+  EXPECT_FALSE(serde::fmt::base64_decode(one, one + 1, out));
+  EXPECT_EQ(out, (std::vector<uint8_t>{1, 2}));
+}
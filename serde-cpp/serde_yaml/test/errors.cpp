@@ -1,6 +1,119 @@
+#include <gtest/gtest.h>
+
+#include "serde/std.h"
+#include "serde/serde.h"
+#include "serde_yaml/serde_yaml.h"
+#include "serde_yaml/deserializer_yaml.h"
+
 // wrong serialization/deserialization calls
 
 // 1. serialize two consective values wihout seq/map
 // 2. don't finish maps/seqs
 // 3. missing fields
 // 4. unexpected fields
+
+///////////////////////////////////////////////////////////////////////////////
+// Deserialization errors
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+struct Pos {
+  int x = 0;
+  int y = 0;
+  template<typename D>
+  void deserialize(D& de) {
+    de.deserialize_struct_begin();
+    de.deserialize_struct_field("x", x);
+    de.deserialize_struct_field("y", y);
+    de.deserialize_struct_end();
+  }
+};
+
+struct Counted {
+  static inline int count = 0;
+  int v = 0;
+  void deserialize(serde::Deserializer& de) {
+    count++;
+    de.deserialize(v);
+  }
+};
+} // namespace
+
+TEST(Errors, ParseError)
+{
+  auto res = serde_yaml::from_str<std::vector<int>>("[1, 2\n");
+  ASSERT_TRUE(res.has_error());
+  EXPECT_EQ(res.error().kind, serde::Error::Kind::Invalid);
+  EXPECT_GT(res.error().line, 0u);
+  EXPECT_FALSE(res.error().text.empty());
+}
+
+TEST(Errors, InvalidScalar)
+{
+  auto res = serde_yaml::from_str<std::vector<int>>("- 1\n- 2\n- three\n");
+  ASSERT_TRUE(res.has_error());
+  EXPECT_EQ(res.error().line, 3u);
+}
+
+TEST(Errors, NumberOutOfRange)
+{
+  auto res = serde_yaml::from_str<std::vector<uint8_t>>("- 1\n- 300\n");
+  ASSERT_TRUE(res.has_error());
+  EXPECT_EQ(res.error().text, "number out of range");
+  EXPECT_EQ(res.error().line, 2u);
+
+  EXPECT_EQ(serde_yaml::from_str<uint32_t>("-1").error().text, "number out of range");
+  EXPECT_EQ(serde_yaml::from_str<uint64_t>("18446744073709551616").error().text, "number out of range");
+  EXPECT_EQ(serde_yaml::from_str<int16_t>("0x8000").error().text, "number out of range");
+  EXPECT_EQ(serde_yaml::from_str<double>("1e400").error().text, "number out of range");
+  EXPECT_EQ(serde_yaml::from_str<float>("1e39").error().text, "number out of range");
+  EXPECT_EQ(serde_yaml::from_str<int>("12abc").error().text, "invalid scalar value");
+  EXPECT_EQ(serde_yaml::from_str<int>("1.5").error().text, "invalid scalar value");
+  EXPECT_EQ(serde_yaml::from_str<double>("1e").error().text, "invalid scalar value");
+}
+
+TEST(Errors, InvalidBase64)
+{
+  struct Blob {
+    uint8_t val[6] = {};
+    void deserialize(serde::Deserializer& de) { de.deserialize_bytes(val, sizeof(val)); }
+  };
+  EXPECT_EQ(serde_yaml::from_str<Blob>("Zm9v!mFy").error().text, "invalid base64 value");
+  EXPECT_EQ(serde_yaml::from_str<Blob>("Zm9vY").error().text, "invalid base64 value");
+  // more bytes than the destination holds
+  EXPECT_EQ(serde_yaml::from_str<Blob>("Zm9vYmFyYmF6").error().text, "invalid base64 value");
+}
+
+TEST(Errors, MissingField)
+{
+  auto res = serde_yaml::from_str<Pos>("x: 1\nz: 2\n");
+  ASSERT_TRUE(res.has_error());
+  EXPECT_EQ(res.error().text, "key not found in map");
+  auto res_static = serde_yaml::from_str_static<Pos>("x: 1\nz: 2\n");
+  ASSERT_TRUE(res_static.has_error());
+  EXPECT_EQ(res_static.error().text, res.error().text);
+}
+
+TEST(Errors, WrongShape)
+{
+  EXPECT_TRUE(serde_yaml::from_str<std::vector<int>>("a: 1\n").has_error());
+  using Map = std::map<std::string, int>;
+  EXPECT_TRUE(serde_yaml::from_str<Map>("- 1\n").has_error());
+  EXPECT_TRUE(serde_yaml::from_str<Pos>("[1, 2]").has_error());
+}
+
+TEST(Errors, ArrayLengthMismatch)
+{
+  using Type = std::array<int, 3>;
+  EXPECT_EQ(serde_yaml::from_str<Type>("[1, 2]").error().text, "sequence length mismatch");
+  EXPECT_EQ(serde_yaml::from_str<Type>("[1, 2, 3, 4]").error().text, "sequence length mismatch");
+  EXPECT_EQ(serde_yaml::from_str<Type>("[1, 2, 3]").value(), (Type{1, 2, 3}));
+}
+
+TEST(Errors, StopEarly)
+{
+  Counted::count = 0;
+  auto res = serde_yaml::from_str<std::vector<Counted>>("[x, 1, 2, 3]");
+  ASSERT_TRUE(res.has_error());
+  EXPECT_EQ(Counted::count, 1);
+}
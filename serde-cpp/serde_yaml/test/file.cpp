@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "serde/std.h"
+#include "serde/serde.h"
+#include "serde_yaml/serde_yaml.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// Memory mapped file input
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+// Temporary file with the given contents, removed on destruction
+struct TempFile {
+  std::string path;
+  explicit TempFile(const std::string& contents) {
+    char name[] = "/tmp/serde_yaml_test_XXXXXX";
+    int fd = ::mkstemp(name);
+    EXPECT_GE(fd, 0);
+    EXPECT_EQ(::write(fd, contents.data(), contents.size()), ssize_t(contents.size()));
+    ::close(fd);
+    path = name;
+  }
+  ~TempFile() { std::remove(path.c_str()); }
+  std::string read() const {
+    std::ifstream in(path);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+  }
+};
+} // namespace
+
+TEST(File, FromFile)
+{
+  using Type = std::map<std::string, std::vector<std::string>>;
+  // quoted scalars are unescaped in place by the parser
+  const std::string yaml = "a: ['it''s', \"tab\\there\"]\nb: [plain]\n";
+  TempFile file(yaml);
+  auto val = serde_yaml::from_file<Type>(file.path).value();
+  EXPECT_EQ(val, (Type{{"a", {"it's", "tab\there"}}, {"b", {"plain"}}}));
+  // the parse modified the private mapping only
+  EXPECT_EQ(file.read(), yaml);
+}
+
+TEST(File, FromFd)
+{
+  TempFile file("- 1\n- 2\n- 3\n");
+  int fd = ::open(file.path.c_str(), O_RDONLY);
+  ASSERT_GE(fd, 0);
+  auto val = serde_yaml::from_fd<std::vector<int>>(fd).value();
+  EXPECT_EQ(val, (std::vector<int>{1, 2, 3}));
+  // fd is still open and usable
+  EXPECT_EQ(serde_yaml::from_fd<std::vector<int>>(fd).value(), val);
+  ::close(fd);
+}
+
+TEST(File, Empty)
+{
+  // nothing to map, same as parsing an empty string
+  TempFile file("");
+  auto val = serde_yaml::from_file<std::optional<int>>(file.path);
+  auto str_val = serde_yaml::from_str<std::optional<int>>("");
+  EXPECT_EQ(val.has_error(), str_val.has_error());
+}
+
+TEST(File, Errors)
+{
+  auto missing = serde_yaml::from_file<int>("/nonexistent/serde_yaml.yaml");
+  ASSERT_TRUE(missing.has_error());
+  EXPECT_NE(missing.error().text.find("failed to open file"), std::string::npos);
+
+  TempFile file("- 1\n- two\n");
+  auto invalid = serde_yaml::from_file<std::vector<int>>(file.path);
+  ASSERT_TRUE(invalid.has_error());
+  EXPECT_EQ(invalid.error().line, 2u);
+}
+
+TEST(File, NotRegular)
+{
+  // a pipe reports a size of 0, it must not read as an empty document
+  int fds[2];
+  ASSERT_EQ(::pipe(fds), 0);
+  ASSERT_EQ(::write(fds[1], "- 1\n", 4), 4);
+  auto res = serde_yaml::from_fd<std::optional<std::vector<int>>>(fds[0]);
+  ASSERT_TRUE(res.has_error());
+  EXPECT_EQ(res.error().text, "not a regular file");
+  ::close(fds[0]);
+  ::close(fds[1]);
+
+  auto dir = serde_yaml::from_file<std::optional<int>>("/");
+  ASSERT_TRUE(dir.has_error());
+  EXPECT_EQ(dir.error().text, "not a regular file");
+}
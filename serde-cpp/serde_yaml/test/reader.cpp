@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "serde/std.h"
+#include "serde/serde.h"
+#include "serde_yaml/serde_yaml.h"
+#include "serde_yaml/reader_yaml.h"
+#include "serde_yaml/writer_yaml.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// Sequence reader
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+struct Item {
+  std::string name;
+  std::vector<int> sizes;
+  std::map<std::string, std::string> labels;
+  template<typename S>
+  void serialize(S& ser) const {
+    ser.serialize_struct_begin();
+    ser.serialize_struct_field("name", name);
+    ser.serialize_struct_field("sizes", sizes);
+    ser.serialize_struct_field("labels", labels);
+    ser.serialize_struct_end();
+  }
+  template<typename D>
+  void deserialize(D& de) {
+    de.deserialize_struct_begin();
+    de.deserialize_struct_field("name", name);
+    de.deserialize_struct_field("sizes", sizes);
+    de.deserialize_struct_field("labels", labels);
+    de.deserialize_struct_end();
+  }
+  bool operator==(const Item& o) const {
+    return std::tie(name, sizes, labels) == std::tie(o.name, o.sizes, o.labels);
+  }
+};
+
+template<typename T, typename Reader>
+std::vector<T> read_all(Reader& reader)
+{
+  std::vector<T> vals;
+  T val{};
+  while (reader.next(val).value())
+    vals.push_back(std::move(val));
+  return vals;
+}
+} // namespace
+
+TEST(Reader, SeqOfStructs)
+{
+  const std::vector<Item> items = {
+    {"first", {1, 2}, {{"zone", "a"}}},
+    {"second", {}, {}},
+    {"third", {3}, {{"zone", "b"}, {"rack", "7"}}},
+  };
+  std::istringstream in(serde_yaml::to_string(items).value());
+  serde_yaml::YamlSeqReader reader(in);
+  EXPECT_EQ(read_all<Item>(reader), items);
+}
+
+TEST(Reader, SeqOfSeqs)
+{
+  using Type = std::vector<std::vector<int>>;
+  const Type val = {{1, 2}, {}, {3}, {4, 5, 6}};
+  const std::string yaml = serde_yaml::to_string(val).value();
+  serde_yaml::YamlSeqReader reader(yaml);
+  EXPECT_EQ(read_all<std::vector<int>>(reader), val);
+}
+
+TEST(Reader, Preamble)
+{
+  serde_yaml::YamlSeqReader reader("# inventory\n%YAML 1.2\n---\n  - 1\n  - 2\n\n  - 3\n...\n");
+  EXPECT_EQ(read_all<int>(reader), (std::vector<int>{1, 2, 3}));
+}
+
+TEST(Reader, Empty)
+{
+  serde_yaml::YamlSeqReader empty("");
+  EXPECT_TRUE(read_all<int>(empty).empty());
+  serde_yaml::YamlSeqReader flow_empty("[]\n");
+  EXPECT_TRUE(read_all<int>(flow_empty).empty());
+}
+
+TEST(Reader, Errors)
+{
+  serde_yaml::YamlSeqReader not_seq("a: 1\n");
+  int val = 0;
+  auto res = not_seq.next(val);
+  ASSERT_TRUE(res.has_error());
+  EXPECT_EQ(res.error().line, 1u);
+
+  serde_yaml::YamlSeqReader bad_item("- 1\n- 2\n- three\n- 4\n");
+  EXPECT_TRUE(bad_item.next(val).value());
+  EXPECT_TRUE(bad_item.next(val).value());
+  res = bad_item.next(val);
+  ASSERT_TRUE(res.has_error());
+  EXPECT_EQ(res.error().line, 3u);
+  // the reader goes on with the next element
+  EXPECT_TRUE(bad_item.next(val).value());
+  EXPECT_EQ(val, 4);
+}
+
+TEST(Reader, MultiLineElements)
+{
+  // continuation lines never start with "- " at the item indentation in block context
+  serde_yaml::YamlSeqReader reader("- plain\n  continued\n- |\n  - literal\n- 'quoted\n  - text'\n");
+  EXPECT_EQ(read_all<std::string>(reader), (std::vector<std::string>{"plain continued", "- literal\n", "quoted - text"}));
+  serde_yaml::YamlSeqReader flow_reader("- [1,\n  2]\n- {a: 3,\n  b: 4}\n");
+  std::vector<int> seq;
+  EXPECT_TRUE(flow_reader.next(seq).value());
+  EXPECT_EQ(seq, (std::vector<int>{1, 2}));
+  std::map<std::string, int> map;
+  EXPECT_TRUE(flow_reader.next(map).value());
+  EXPECT_EQ(map, (std::map<std::string, int>{{"a", 3}, {"b", 4}}));
+  EXPECT_FALSE(flow_reader.next(map).value());
+}
+
+TEST(Reader, UnsupportedSplit)
+{
+  // a quoted scalar or flow collection with a "- " line at the item indentation is split there,
+  // the broken element is a parse error and the reader stops
+  for (const char* yaml : {"- 1\n- 'a\n- b'\n- 4\n", "- 1\n- [2,\n- 3]\n- 4\n"}) {
+    serde_yaml::YamlSeqReader reader(yaml);
+    std::string val;
+    EXPECT_TRUE(reader.next(val).value());
+    auto res = reader.next(val);
+    ASSERT_TRUE(res.has_error()) << yaml;
+    EXPECT_GE(res.error().line, 2u);
+    EXPECT_FALSE(reader.next(val).value());
+  }
+
+  // non-empty flow sequences are rejected up front
+  serde_yaml::YamlSeqReader flow("[1, 2]\n");
+  int val = 0;
+  auto res = flow.next(val);
+  ASSERT_TRUE(res.has_error());
+  EXPECT_EQ(res.error().text, "expected a block sequence");
+  EXPECT_FALSE(flow.next(val).value());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Document reader/writer
+///////////////////////////////////////////////////////////////////////////////
+
+// the writer may point into its own buffer, so it is neither copied nor moved
+static_assert(!std::is_move_constructible_v<serde_yaml::YamlDocWriter>);
+static_assert(!std::is_move_assignable_v<serde_yaml::YamlDocWriter>);
+
+TEST(Reader, DocumentsRoundtrip)
+{
+  const std::vector<Item> items = {
+    {"first", {1, 2}, {{"zone", "a"}}},
+    {"second", {}, {}},
+    {"third", {3}, {{"zone", "b"}, {"rack", "7"}}},
+  };
+  std::string out;
+  serde_yaml::YamlDocWriter writer(out);
+  for (auto& item : items)
+    writer.write(item).value();
+  EXPECT_EQ(out.rfind("---\nname: first\n", 0), 0u);
+
+  serde_yaml::YamlDocReader reader(out);
+  EXPECT_EQ(read_all<Item>(reader), items);
+
+  std::ostringstream os;
+  serde_yaml::YamlDocWriter stream_writer(os);
+  for (auto& item : items)
+    stream_writer.write(item).value();
+  EXPECT_EQ(os.str(), out);
+  std::istringstream in(os.str());
+  serde_yaml::YamlDocReader stream_reader(in);
+  EXPECT_EQ(read_all<Item>(stream_reader), items);
+}
+
+TEST(Reader, Documents)
+{
+  // directives, markers with content, empty documents and document end markers
+  const std::string yaml =
+    "%YAML 1.2\n"
+    "--- 1\n"
+    "---\n"
+    "# nothing here\n"
+    "---\n"
+    "2\n"
+    "...\n"
+    "3\n";
+  serde_yaml::YamlDocReader reader(yaml);
+  EXPECT_EQ(read_all<int>(reader), (std::vector<int>{1, 2, 3}));
+
+  serde_yaml::YamlDocReader seq_reader("---\n- 1\n---\n- 2\n- 3\n--- []\n");
+  EXPECT_EQ(read_all<std::vector<int>>(seq_reader), (std::vector<std::vector<int>>{{1}, {2, 3}, {}}));
+}
+
+TEST(Reader, DocumentsErrorLine)
+{
+  serde_yaml::YamlDocReader reader("---\nx: 1\n---\nx: 2\n---\n\nx: three\n");
+  std::map<std::string, int> val;
+  EXPECT_TRUE(reader.next(val).value());
+  EXPECT_TRUE(reader.next(val).value());
+  auto res = reader.next(val);
+  ASSERT_TRUE(res.has_error());
+  EXPECT_EQ(res.error().line, 7u);
+  EXPECT_FALSE(reader.next(val).value());
+}
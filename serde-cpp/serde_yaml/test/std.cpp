@@ -30,6 +30,14 @@ TEST(Std, String_Empty)
   EXPECT_EQ(de_val, val);
 }
 
+TEST(Std, String_EmbeddedNull)
+{
+  using Type = std::string;
+  const Type val("Hello\0World", 11);
+  auto str = serde_yaml::to_string(val).value();
+  EXPECT_NE(str.find(val), std::string::npos);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // std::string_view
 ///////////////////////////////////////////////////////////////////////////////
@@ -40,8 +48,8 @@ TEST(Std, StringView_Value)
   const Type val = "Hello World";
   auto str = serde_yaml::to_string(val).value();
   EXPECT_STREQ(str.c_str(), "Hello World\n");
-  // no deserialization for string_view
-  static_assert(!std::is_member_function_pointer_v<decltype(&serde::DeserializeT<std::basic_string_view>::deserialize<char, std::char_traits<char>>)>);
+  auto de_doc = serde_yaml::from_str_borrowed<Type>(std::move(str)).value();
+  EXPECT_EQ(*de_doc, val);
 }
 
 TEST(Std, StringView_Empty)
@@ -50,8 +58,27 @@ TEST(Std, StringView_Empty)
   const Type val = {};
   auto str = serde_yaml::to_string(val).value();
   EXPECT_STREQ(str.c_str(), "\n");
-  // no deserialization for string_view
-  static_assert(!std::is_member_function_pointer_v<decltype(&serde::DeserializeT<std::basic_string_view>::deserialize<char, std::char_traits<char>>)>);
+  auto de_doc = serde_yaml::from_str_borrowed<Type>(std::move(str)).value();
+  EXPECT_EQ(*de_doc, val);
+}
+
+TEST(Std, StringView_Substr)
+{
+  using Type = std::string_view;
+  const Type val = Type("Hello World").substr(0, 5);
+  auto str = serde_yaml::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), "Hello\n");
+}
+
+TEST(Std, StringView_Borrowed)
+{
+  using Type = std::map<std::string_view, std::vector<std::string_view>>;
+  std::string yaml = "first: [a, bb]\nsecond: [ccc]\n";
+  auto de_doc = serde_yaml::from_str_borrowed<Type>(std::string(yaml)).value();
+  EXPECT_EQ(*de_doc, (Type{{"first", {"a", "bb"}}, {"second", {"ccc"}}}));
+  // the views stay valid after moving the document around
+  auto moved_doc = std::move(de_doc);
+  EXPECT_EQ(moved_doc->at("second").at(0), "ccc");
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -174,6 +201,40 @@ TEST(Std, Vector_Empty)
   EXPECT_EQ(de_val, val);
 }
 
+TEST(Std, Vector_Double)
+{
+  using Type = std::vector<double>;
+  const Type val = {1.5, -2.25, 0.125, 0};
+  auto str = serde_yaml::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), "- 1.5\n- -2.25\n- 0.125\n- 0\n");
+  auto de_val = serde_yaml::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Vector_Nested)
+{
+  using Type = std::vector<std::vector<int>>;
+  const Type val = {{1, 2}, {3}};
+  auto str = serde_yaml::to_string(val).value();
+  EXPECT_STREQ(str.c_str(), "- - 1\n  - 2\n- - 3\n");
+  auto de_val = serde_yaml::from_str<Type>(std::move(str)).value();
+  EXPECT_EQ(de_val, val);
+}
+
+TEST(Std, Vector_FlowSeq)
+{
+  using Type = std::vector<float>;
+  auto de_val = serde_yaml::from_str<Type>("[0.5, -1, 2.75, 1e3]").value();
+  EXPECT_EQ(de_val, (Type{0.5f, -1.f, 2.75f, 1000.f}));
+}
+
+TEST(Std, Vector_NestedInMap)
+{
+  using Type = std::map<std::string, std::vector<std::array<uint8_t, 2>>>;
+  auto de_val = serde_yaml::from_str<Type>("a: [[1, 2], [3, 4]]\nb: []\n").value();
+  EXPECT_EQ(de_val, (Type{{"a", {{1, 2}, {3, 4}}}, {"b", {}}}));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // std::variant
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include "serde/std.h"
+#include "serde/serde.h"
+#include "serde_yaml/serde_yaml.h"
+#include "serde_yaml/stream_serializer_yaml.h"
+
+#include "types.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// Stream serializer, same output as the ryml::Tree based serializer
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+template<typename T>
+void expect_same_yaml(const T& val)
+{
+  auto tree_str = serde_yaml::to_string(val).value();
+  auto stream_str = serde_yaml::to_string_stream(val).value();
+  EXPECT_EQ(stream_str, tree_str);
+}
+
+// Containers in every position of a struct, not only as the last field
+struct Record {
+  std::string name;
+  std::vector<int> sizes;
+  std::map<std::string, std::vector<int>> groups;
+  std::vector<std::map<std::string, int>> rows;
+  types::Point origin;
+  int last = 0;
+  template<typename S>
+  void serialize(S& ser) const {
+    ser.serialize_struct_begin();
+    ser.serialize_struct_field("name", name);
+    ser.serialize_struct_field("sizes", sizes);
+    ser.serialize_struct_field("groups", groups);
+    ser.serialize_struct_field("rows", rows);
+    ser.serialize_struct_field("origin", origin);
+    ser.serialize_struct_field("last", last);
+    ser.serialize_struct_end();
+  }
+};
+
+struct Bytes {
+  uint8_t val[10] = {0xde, 0xad, 0xbe, 0xef, 0x00, 0x22, 0x33, 0x44, 0x56, 0x98};
+  void serialize(serde::Serializer& ser) const { ser.serialize_bytes(val, sizeof(val)); }
+};
+} // namespace
+
+TEST(Stream, Scalars)
+{
+  expect_same_yaml(3);
+  expect_same_yaml(-42);
+  expect_same_yaml(uint64_t(18446744073709551615u));
+  expect_same_yaml(3.14159f);
+  expect_same_yaml(3.14159);
+  expect_same_yaml(true);
+  expect_same_yaml('A');
+  expect_same_yaml((unsigned char)250);
+  expect_same_yaml(Bytes{});
+}
+
+TEST(Stream, Strings)
+{
+  expect_same_yaml(std::string("Hello World"));
+  expect_same_yaml(std::string());
+  expect_same_yaml(std::string("sixty-nine"));
+  expect_same_yaml(std::string("-12.5"));
+  expect_same_yaml(std::string("key: value"));
+  expect_same_yaml(std::string(" padded "));
+  expect_same_yaml(std::string("*ref"));
+  expect_same_yaml(std::string("say \"hi\""));
+  expect_same_yaml(std::string("it's"));
+  expect_same_yaml(std::string("it's \"both\""));
+  expect_same_yaml(std::optional<int>());
+}
+
+TEST(Stream, Sequences)
+{
+  expect_same_yaml(std::vector<int>{56, 333});
+  expect_same_yaml(std::vector<int>{});
+  expect_same_yaml(std::vector<std::vector<int>>{{1, 2}, {}, {3}});
+  expect_same_yaml(std::vector<double>{1.5, -2.25, 0.125, 0.0});
+  expect_same_yaml(std::tuple<char, int, std::string>{'c', 4, "four"});
+  expect_same_yaml(std::array<size_t, 0>{});
+}
+
+TEST(Stream, Maps)
+{
+  using Map = std::map<std::string, std::vector<std::array<uint8_t, 2>>>;
+  expect_same_yaml(Map{{"a", {{1, 2}, {3, 4}}}, {"b", {}}});
+  expect_same_yaml(std::map<std::string, long int>{});
+  expect_same_yaml(std::map<std::string, std::map<int, std::string>>{{"x", {{1, "one"}}}, {"y", {}}});
+  expect_same_yaml(std::pair<int, std::string>{69, "sixty-nine"});
+  expect_same_yaml(std::variant<char, int, std::string>{'c'});
+  expect_same_yaml(std::vector<std::map<std::string, int>>{{{"a", 1}, {"b", 2}}, {}});
+  // nested seq of maps of seqs, and map of seqs of maps
+  using SeqOfMaps = std::vector<std::map<std::string, std::vector<int>>>;
+  expect_same_yaml(SeqOfMaps{{{"a", {1, 2}}, {"b", {}}, {"c", {3}}}, {}, {{"d", {4}}}});
+  using MapOfSeqs = std::map<std::string, std::vector<std::map<std::string, int>>>;
+  expect_same_yaml(MapOfSeqs{{"a", {{{"x", 1}, {"y", 2}}, {}}}, {"b", {}}, {"c", {{{"z", 3}}}}});
+}
+
+TEST(Stream, Structs)
+{
+  types::Point point{ 10, 20 };
+  expect_same_yaml(point);
+
+  const Record record{"full", {1, 2}, {{"a", {1}}, {"b", {}}}, {{{"x", 1}}, {}}, {10, 20}, 3};
+  expect_same_yaml(record);
+  expect_same_yaml(Record{});
+  expect_same_yaml(std::vector<Record>{record, Record{}, record});
+  expect_same_yaml(std::map<std::string, Record>{{"first", record}, {"second", Record{}}});
+}
+
+TEST(Stream, AppendOutput)
+{
+  std::string out = "# header\n";
+  serde_yaml::to_string_stream(std::vector<int>{1, 2}, out).value();
+  EXPECT_EQ(out, "# header\n- 1\n- 2\n");
+
+  std::string reused;
+  serde_yaml::YamlStreamSerializer ser(reused);
+  for (int i = 0; i < 3; i++) {
+    reused.clear();
+    ser.reset();
+    ser.serialize(std::vector<int>{i, i});
+    EXPECT_EQ(reused, serde_yaml::to_string(std::vector<int>{i, i}).value());
+  }
+}
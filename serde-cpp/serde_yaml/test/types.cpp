@@ -26,7 +26,7 @@ void serde::deserialize(serde::Deserializer& de, types::Number& number)
   if (str == "One") number = types::Number::One;
   else if (str == "Two") number = types::Number::Two;
   else if (str == "Three") number = types::Number::Three;
-  else return; // TODO: mark error
+  else de.set_error({serde::Error::Kind::Invalid, 0, 0, "unknown types::Number"});
 }
 
 template<>